@@ -24,6 +24,8 @@ HEADERS +=  src/baseobjectview.h \
 	    src/objectsscene.h \
             src/schemaview.h \
             src/roundedrectitem.h \
+            src/simplifiedtableitem.h \
+            src/spatialindex.h \
             src/styledtextboxview.h
 
 SOURCES +=  src/baseobjectview.cpp \
@@ -37,6 +39,8 @@ SOURCES +=  src/baseobjectview.cpp \
 	    src/objectsscene.cpp \
 	    src/schemaview.cpp \
             src/roundedrectitem.cpp \
+            src/simplifiedtableitem.cpp \
+            src/spatialindex.cpp \
             src/styledtextboxview.cpp
 
 unix|windows: LIBS += -L$$OUT_PWD/../libpgmodeler/ -lpgmodeler \
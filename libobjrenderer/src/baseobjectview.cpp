@@ -19,11 +19,13 @@
 #include "baseobjectview.h"
 #include "textboxview.h"
 #include "roundedrectitem.h"
+#include "objectsscene.h"
 
 map<QString, QTextCharFormat> BaseObjectView::font_config;
 map<QString, QColor *> BaseObjectView::color_config;
 unsigned BaseObjectView::global_sel_order=1;
 bool BaseObjectView::use_placeholder=true;
+bool BaseObjectView::use_item_cache=true;
 
 BaseObjectView::BaseObjectView(BaseObject *object)
 {
@@ -394,6 +396,77 @@ bool BaseObjectView::isPlaceholderEnabled(void)
 	return(use_placeholder);
 }
 
+void BaseObjectView::invalidateSceneIndex(void)
+{
+	ObjectsScene *scene=dynamic_cast<ObjectsScene *>(this->scene());
+
+	//Only the objects placed directly on the scene are indexed (e.g. relationship labels aren't)
+	if(scene && !this->parentItem())
+		scene->invalidateObjectIndex(this);
+}
+
+QRectF BaseObjectView::getSceneRect(void)
+{
+	QRectF rect=this->sceneBoundingRect();
+
+	if(obj_shadow && obj_shadow->isVisible())
+		rect=rect.united(obj_shadow->sceneBoundingRect());
+
+	return(rect);
+}
+
+void BaseObjectView::setItemCacheEnabled(bool value)
+{
+	use_item_cache=value;
+}
+
+bool BaseObjectView::isItemCacheEnabled(void)
+{
+	return(use_item_cache);
+}
+
+void BaseObjectView::setItemCacheMode(QGraphicsItem *item, QGraphicsItem::CacheMode mode)
+{
+	if(item)
+		item->setData(CACHE_MODE_KEY, QVariant::fromValue<int>(mode));
+}
+
+void BaseObjectView::updateItemCache(void)
+{
+	ObjectsScene *scene=dynamic_cast<ObjectsScene *>(this->scene());
+	QList<QGraphicsItem *> items=this->childItems();
+	QGraphicsItem *item=nullptr;
+	QGraphicsItem::CacheMode mode;
+	bool enabled=use_item_cache && (!scene || !scene->isItemCacheSuspended());
+	double zoom=(scene ? scene->getZoomFactor() : 1);
+	QSize size;
+
+	while(!items.isEmpty())
+	{
+		item=items.front();
+		items.pop_front();
+		items.append(item->childItems());
+
+		if(!item->data(CACHE_MODE_KEY).isValid())
+			continue;
+
+		mode=(enabled ? static_cast<QGraphicsItem::CacheMode>(item->data(CACHE_MODE_KEY).toInt()) : QGraphicsItem::NoCache);
+
+		if(mode==QGraphicsItem::ItemCoordinateCache)
+		{
+			//The pixmap has the size of the item at the current zoom so the text isn't blurred when zooming in
+			size=(item->boundingRect().size() * zoom).toSize();
+
+			if(size.isEmpty())
+				item->setCacheMode(QGraphicsItem::NoCache);
+			else
+				item->setCacheMode(mode, size);
+		}
+		else
+			item->setCacheMode(mode);
+	}
+}
+
 QVariant BaseObjectView::itemChange(GraphicsItemChange change, const QVariant &value)
 {
 	if(change==ItemPositionHasChanged)
@@ -405,6 +478,8 @@ QVariant BaseObjectView::itemChange(GraphicsItemChange change, const QVariant &v
 			graph_obj->setPosition(this->scenePos());
 			this->configurePositionInfo(this->pos());
 		}
+
+		this->invalidateSceneIndex();
 	}
 	else if(change==ItemSelectedHasChanged && obj_selection)
 	{
@@ -593,6 +668,7 @@ void BaseObjectView::__configureObject(void)
 						 QString(") ") + QString("\nId: %1").arg(graph_obj->getObjectId()));
 		this->configurePositionInfo(graph_obj->getPosition());
 		this->configureProtectedIcon();
+		this->invalidateSceneIndex();
 	}
 }
 
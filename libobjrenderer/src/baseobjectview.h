@@ -42,6 +42,13 @@ class BaseObjectView: public QObject, public QGraphicsItemGroup {
 		when the table moviment ends and not during it */
 		static bool use_placeholder;
 
+		/*! \brief Indicates if the rendering of the objects' items is cached in pixmaps. When enabled the
+		items are rasterized again only when they change (see updateItemCache) or when the zoom changes */
+		static bool use_item_cache;
+
+		//! \brief Key of the item's data in which the cache mode assigned via setItemCacheMode() is stored
+		static const int CACHE_MODE_KEY=1;
+
 		/*! \brief Stores the global selection order of objects. This attributes
 		 is incremented each time an object is selected. */
 		static unsigned global_sel_order;
@@ -106,6 +113,15 @@ class BaseObjectView: public QObject, public QGraphicsItemGroup {
 
 		void configurePlaceholder(void);
 
+		/*! \brief Informs the scene that the area occupied by the object changed so its spatial index must be
+		updated (see ObjectsScene::invalidateObjectIndex). This must be called whenever the object is moved or resized */
+		void invalidateSceneIndex(void);
+
+		/*! \brief Assigns the cache mode used by the item when the cache is enabled. The objects' bodies should use
+		DeviceCoordinateCache, which Qt rasterizes again whenever the zoom changes, and the labels ItemCoordinateCache,
+		whose pixmap size is adjusted to the zoom by updateItemCache(). The mode is applied by updateItemCache() */
+		static void setItemCacheMode(QGraphicsItem *item, QGraphicsItem::CacheMode mode);
+
 		void mousePressEvent(QGraphicsSceneMouseEvent *event);
 
 		void setSelectionOrder(bool selected);
@@ -151,6 +167,15 @@ class BaseObjectView: public QObject, public QGraphicsItemGroup {
 
 		static bool isPlaceholderEnabled(void);
 
+		static void setItemCacheEnabled(bool value);
+
+		static bool isItemCacheEnabled(void);
+
+		/*! \brief Applies the cache modes to the whole item tree of the object. The items using ItemCoordinateCache have
+		their pixmaps resized according to the zoom of the scene. This method must be called whenever the object is
+		reconfigured or the zoom changes. Note: the cached pixmaps are invalidated by Qt itself when the items change */
+		void updateItemCache(void);
+
 		//! \brief Sets the  font style for the specified element id
 		static void setFontStyle(const QString &id, QTextCharFormat font_fmt);
 
@@ -174,6 +199,10 @@ class BaseObjectView: public QObject, public QGraphicsItemGroup {
 		//! \brief Toggles the wireframe display
 		virtual void togglePlaceholder(bool visible);
 
+		/*! \brief Returns the area occupied by the object in the scene (including its shadow).
+		This is the rect used to index the object on ObjectsScene */
+		virtual QRectF getSceneRect(void);
+
 	protected slots:
 		//! \brief Make the basic object operations
 		void __configureObject(void);
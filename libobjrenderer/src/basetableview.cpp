@@ -20,6 +20,10 @@
 
 bool BaseTableView::hide_ext_attribs=false;
 bool BaseTableView::hide_tags=false;
+bool BaseTableView::lod_enabled=true;
+bool BaseTableView::lazy_item_trees=false;
+double BaseTableView::box_lod_zoom=BaseTableView::DEFAULT_BOX_LOD_ZOOM;
+double BaseTableView::rect_lod_zoom=BaseTableView::DEFAULT_RECT_LOD_ZOOM;
 
 BaseTableView::BaseTableView(BaseTable *base_tab) : BaseObjectView(base_tab)
 {
@@ -53,6 +57,10 @@ BaseTableView::BaseTableView(BaseTable *base_tab) : BaseObjectView(base_tab)
 	obj_selection->setVisible(false);
 	obj_selection->setZValue(4);
 
+	simplified_body=new SimplifiedTableItem;
+	simplified_body->setVisible(false);
+	simplified_body->setZValue(1);
+
 	this->addToGroup(obj_selection);
 	this->addToGroup(obj_shadow);
 	this->addToGroup(columns);
@@ -62,12 +70,26 @@ BaseTableView::BaseTableView(BaseTable *base_tab) : BaseObjectView(base_tab)
 	this->addToGroup(tag_body);
 	this->addToGroup(ext_attribs);
 	this->addToGroup(ext_attribs_body);
+	this->addToGroup(simplified_body);
+
+	/* The bodies are cached in device coordinates since they are drawn with gradients which are
+	expensive to paint and are repainted several times while panning and moving the objects */
+	setItemCacheMode(body, QGraphicsItem::DeviceCoordinateCache);
+	setItemCacheMode(ext_attribs_body, QGraphicsItem::DeviceCoordinateCache);
+	setItemCacheMode(obj_shadow, QGraphicsItem::DeviceCoordinateCache);
 
 	this->setAcceptHoverEvents(true);
 	sel_child_obj=nullptr;
 	connected_rels=0;
+	lod_level=LOD_FULL;
+	tree_hidden=false;
+	item_tree_created=!lazy_item_trees;
 
 	configurePlaceholder();
+
+	//Lazy tables start as placeholders, the simplified item is configured by the derived class' configureObject()
+	if(!item_tree_created)
+		hideItemTree();
 }
 
 BaseTableView::~BaseTableView(void)
@@ -79,6 +101,8 @@ BaseTableView::~BaseTableView(void)
 	this->removeFromGroup(columns);
 	this->removeFromGroup(tag_name);
 	this->removeFromGroup(tag_body);
+	this->removeFromGroup(simplified_body);
+	delete(simplified_body);
 	delete(ext_attribs_body);
 	delete(ext_attribs);
 	delete(body);
@@ -108,6 +132,222 @@ bool BaseTableView::isTagsHidden(void)
 	return(hide_tags);
 }
 
+void BaseTableView::setLevelOfDetailEnabled(bool value)
+{
+	lod_enabled=value;
+}
+
+bool BaseTableView::isLevelOfDetailEnabled(void)
+{
+	return(lod_enabled);
+}
+
+void BaseTableView::setLevelOfDetailZoom(double box_zoom, double rect_zoom)
+{
+	box_lod_zoom=qBound(0.01, box_zoom, 1.0);
+	rect_lod_zoom=qBound(0.0, rect_zoom, box_lod_zoom);
+}
+
+void BaseTableView::getLevelOfDetailZoom(double &box_zoom, double &rect_zoom)
+{
+	box_zoom=box_lod_zoom;
+	rect_zoom=rect_lod_zoom;
+}
+
+unsigned BaseTableView::getLevelOfDetail(double zoom)
+{
+	if(!lod_enabled || zoom >= box_lod_zoom)
+		return(LOD_FULL);
+	else if(zoom >= rect_lod_zoom)
+		return(LOD_BOX);
+	else
+		return(LOD_RECT);
+}
+
+void BaseTableView::setLevelOfDetail(unsigned lod)
+{
+	if(lod > LOD_RECT)
+		lod=LOD_RECT;
+
+	if(lod!=lod_level)
+	{
+		lod_level=lod;
+		updateItemTree();
+	}
+}
+
+unsigned BaseTableView::getCurrentLevelOfDetail(void)
+{
+	return(lod_level);
+}
+
+void BaseTableView::setLazyItemTrees(bool value)
+{
+	lazy_item_trees=value;
+}
+
+bool BaseTableView::isLazyItemTrees(void)
+{
+	return(lazy_item_trees);
+}
+
+void BaseTableView::setItemTreeCreated(bool value)
+{
+	if(item_tree_created!=value)
+	{
+		item_tree_created=value;
+		updateItemTree();
+	}
+}
+
+bool BaseTableView::isItemTreeCreated(void)
+{
+	return(item_tree_created);
+}
+
+void BaseTableView::hideItemTree(void)
+{
+	QList<QGraphicsItem *> subitems;
+
+	//Hiding the item tree storing the visible items so they can be shown again later
+	for(auto item : this->childItems())
+	{
+		if(item!=simplified_body && item!=obj_selection && item->isVisible())
+		{
+			item->setVisible(false);
+			lod_hidden_items.push_back(item);
+		}
+	}
+
+	/* Destroying the columns and extended attributes items since they are the most expensive part of the
+	tree. The connection points are kept so the relationships remain linked to the columns */
+	for(auto group : { columns, ext_attribs })
+	{
+		subitems=group->childItems();
+
+		for(auto item : subitems)
+		{
+			group->removeFromGroup(item);
+			delete(item);
+		}
+	}
+
+	sel_child_obj=nullptr;
+	tree_hidden=true;
+	simplified_body->setVisible(true);
+}
+
+void BaseTableView::updateItemTree(void)
+{
+	if(isSimplified() && !tree_hidden)
+	{
+		hideItemTree();
+		configureSimplifiedBody();
+	}
+	else if(!isSimplified() && tree_hidden)
+	{
+		tree_hidden=false;
+		simplified_body->setVisible(false);
+
+		for(auto item : lod_hidden_items)
+			item->setVisible(true);
+
+		lod_hidden_items.clear();
+
+		//Creating the columns and extended attributes items again
+		this->configureObject();
+	}
+	else if(tree_hidden)
+		simplified_body->setTitleVisible(lod_level!=LOD_RECT);
+}
+
+bool BaseTableView::isSimplified(void)
+{
+	return(lod_level!=LOD_FULL || !item_tree_created);
+}
+
+bool BaseTableView::configureSimplifiedObject(void)
+{
+	if(!isSimplified())
+		return(false);
+
+	/* The dimensions are estimated only for tables that were never fully configured (lazy placeholders).
+	Since those tables were never positioned, the position and selection are configured as well */
+	if(this->bounding_rect.isEmpty())
+	{
+		estimateDimensions();
+		BaseObjectView::__configureObject();
+		BaseObjectView::configureObjectSelection();
+		configureSimplifiedBody();
+		requestRelationshipsUpdate();
+	}
+	else
+		configureSimplifiedBody();
+
+	return(true);
+}
+
+void BaseTableView::setEstimatedDimensions(const QString &title_text, const QStringList &col_texts, const QStringList &ext_texts)
+{
+	QFontMetricsF title_fm(BaseObjectView::getFontStyle(ParsersAttributes::TABLE_NAME).font()),
+			row_fm(BaseObjectView::getFontStyle(ParsersAttributes::COLUMN).font());
+	double width=title_fm.width(title_text) + (4 * HORIZ_SPACING),
+			row_height=row_fm.height(), height=0;
+
+	//Each row is formed by the descriptor (roughly a square with the row's height) and its texts
+	for(auto &text : col_texts + ext_texts)
+		width=qMax(width, row_height + row_fm.width(text) + (7 * HORIZ_SPACING));
+
+	height=title_fm.height() + (4 * VERT_SPACING) +
+				 (col_texts.size() * row_height) + (2 * VERT_SPACING);
+
+	if(!ext_texts.isEmpty() && !hide_ext_attribs)
+		height+=(ext_texts.size() * row_height) + (2 * VERT_SPACING);
+
+	this->bounding_rect=QRectF(0, 0, width, height);
+}
+
+void BaseTableView::configureSimplifiedBody(void)
+{
+	BaseTable *tab=dynamic_cast<BaseTable *>(this->getSourceObject());
+	Tag *tag=tab->getTag();
+	QString title_attrib, body_attrib, name_attrib;
+	QTextCharFormat fmt;
+	QPen pen;
+
+	if(tab->getObjectType()==OBJ_VIEW && !tag)
+	{
+		title_attrib=ParsersAttributes::VIEW_TITLE;
+		body_attrib=ParsersAttributes::VIEW_BODY;
+		name_attrib=ParsersAttributes::VIEW_NAME;
+	}
+	else
+	{
+		title_attrib=ParsersAttributes::TABLE_TITLE;
+		body_attrib=ParsersAttributes::TABLE_BODY;
+		name_attrib=ParsersAttributes::TABLE_NAME;
+	}
+
+	fmt=BaseObjectView::getFontStyle(name_attrib);
+	pen=BaseObjectView::getBorderStyle(title_attrib);
+	simplified_body->setRect(this->bounding_rect, title->boundingRect().height());
+
+	if(!tag)
+	{
+		simplified_body->setStyle(BaseObjectView::getFillStyle(title_attrib), BaseObjectView::getFillStyle(body_attrib), pen);
+		simplified_body->setTitle(tab->getName(), fmt.font(), fmt.foreground().color(), 1/box_lod_zoom);
+	}
+	else
+	{
+		pen.setColor(tag->getElementColor(title_attrib, Tag::BORDER_COLOR));
+		simplified_body->setStyle(tag->getFillStyle(title_attrib), tag->getFillStyle(body_attrib), pen);
+		simplified_body->setTitle(tab->getName(), fmt.font(), tag->getElementColor(name_attrib, Tag::FILL_COLOR1), 1/box_lod_zoom);
+	}
+
+	simplified_body->setTitleVisible(lod_level!=LOD_RECT);
+	this->setToolTip(tab->getName(true) + QString(" (") + tab->getTypeName() + QString(")"));
+}
+
 QVariant BaseTableView::itemChange(GraphicsItemChange change, const QVariant &value)
 {
 	if(change==ItemSelectedHasChanged)
@@ -153,8 +393,8 @@ void BaseTableView::hoverLeaveEvent(QGraphicsSceneHoverEvent *)
 void BaseTableView::hoverMoveEvent(QGraphicsSceneHoverEvent *event)
 {
 	/* Case the table itself is not selected shows the child selector
-		at mouse position */
-	if(!this->isSelected())
+		at mouse position (there are no child items at reduced levels of detail) */
+	if(!this->isSelected() && !tree_hidden)
 	{
 		QList<QGraphicsItem *> items;
 		double cols_height, item_idx, ext_height=0;
@@ -30,6 +30,7 @@
 #include "tabletitleview.h"
 #include "tableobjectview.h"
 #include "roundedrectitem.h"
+#include "simplifiedtableitem.h"
 
 class BaseTableView: public BaseObjectView {
 	private:
@@ -39,6 +40,28 @@ class BaseTableView: public BaseObjectView {
 		by the rearrange method on ModelWidget */
 		int connected_rels;
 
+		//! \brief Current level of detail in which the table is displayed (LOD_??? constants)
+		unsigned lod_level;
+
+		/*! \brief Indicates if the full item tree (title, columns, extended attributes) must exist. Tables outside
+		the exposed area of the viewport are kept as lightweight placeholders (see setItemTreeCreated) */
+		bool item_tree_created,
+
+		//! \brief Indicates that the item tree is currently hidden and the table is drawn by the simplified item
+		tree_hidden;
+
+		//! \brief Items hidden when the table was simplified. They are shown again when the item tree is restored
+		QList<QGraphicsItem *> lod_hidden_items;
+
+		//! \brief Indicates if the tables are simplified at low zoom. This applies to all table/view instances
+		static bool lod_enabled,
+
+		//! \brief Indicates if the new tables are created as placeholders having their item trees created only when exposed
+		lazy_item_trees;
+
+		//! \brief Zoom thresholds below which the tables are drawn as a box with title and as a plain rectangle, respectively
+		static double box_lod_zoom, rect_lod_zoom;
+
 	protected:
 		//! \brief Item groups that stores columns and extended attributes, respectively
 		QGraphicsItemGroup *columns,
@@ -67,6 +90,34 @@ class BaseTableView: public BaseObjectView {
 		//! \brief Stores the original table's tool tip
 		QString table_tooltip;
 
+		//! \brief Single item that represents the whole table at reduced levels of detail
+		SimplifiedTableItem *simplified_body;
+
+		//! \brief Hides the item tree (except the selection) showing the simplified item in its place
+		void hideItemTree(void);
+
+		/*! \brief Creates or destroys the item tree when the current level of detail or the item tree
+		state require a different representation of the table */
+		void updateItemTree(void);
+
+		/*! \brief Returns if the table must be drawn by the simplified item, which happens at reduced levels of
+		detail and when the table has no item tree */
+		bool isSimplified(void);
+
+		//! \brief Configures the simplified item according to the current table's dimensions, name and colors
+		void configureSimplifiedBody(void);
+
+		/*! \brief Configures the table when it must be drawn by the simplified item returning true. Returns false
+		when the full item tree must be configured. The derived classes must call it at the start of configureObject() */
+		bool configureSimplifiedObject(void);
+
+		/*! \brief Estimates the table's dimensions without creating its items. The derived classes
+		must gather the texts of their rows and call setEstimatedDimensions() */
+		virtual void estimateDimensions(void)=0;
+
+		//! \brief Defines the bounding rect based upon the font metrics of the title and the rows texts
+		void setEstimatedDimensions(const QString &title_text, const QStringList &col_texts, const QStringList &ext_texts);
+
 		QVariant itemChange(GraphicsItemChange change, const QVariant &value);
 
 		//! \brief Updates the current connected relationship count
@@ -79,6 +130,14 @@ class BaseTableView: public BaseObjectView {
 		static const unsigned LEFT_CONN_POINT=0,
 		RIGHT_CONN_POINT=1;
 
+		//! \brief Levels of detail: full item tree, box with the table's name and plain rectangle
+		static const unsigned LOD_FULL=0,
+		LOD_BOX=1,
+		LOD_RECT=2;
+
+		static constexpr double DEFAULT_BOX_LOD_ZOOM=0.35,
+		DEFAULT_RECT_LOD_ZOOM=0.15;
+
 		BaseTableView(BaseTable *base_tab);
 		virtual ~BaseTableView(void);
 
@@ -98,6 +157,38 @@ class BaseTableView: public BaseObjectView {
 		//! \brief Returns the current visibility state of tags
 		static bool isTagsHidden(void);
 
+		//! \brief Enables the simplification of tables at low zoom. This applies to all table/view instances
+		static void setLevelOfDetailEnabled(bool value);
+
+		//! \brief Returns if the tables are simplified at low zoom
+		static bool isLevelOfDetailEnabled(void);
+
+		/*! \brief Defines the zoom thresholds below which the tables are drawn as a box with title (box_zoom)
+		and as a plain rectangle (rect_zoom). The rect_zoom is adjusted when greater than box_zoom */
+		static void setLevelOfDetailZoom(double box_zoom, double rect_zoom);
+		static void getLevelOfDetailZoom(double &box_zoom, double &rect_zoom);
+
+		//! \brief Returns the level of detail (LOD_??? constants) in which the tables must be displayed for the zoom factor
+		static unsigned getLevelOfDetail(double zoom);
+
+		/*! \brief Changes the level of detail of the table. When reduced, the items of columns and extended attributes
+		are destroyed and the table is drawn by a single cached item. They are created again only when the full detail
+		is restored. Modifications on the object while reduced update only the simplified item */
+		void setLevelOfDetail(unsigned lod);
+
+		//! \brief Returns the level of detail in which the table is currently displayed
+		unsigned getCurrentLevelOfDetail(void);
+
+		/*! \brief Enables the creation of new tables as placeholders with estimated dimensions. Their item trees are
+		created only when exposed in the scene (see ObjectsScene::setExposedRect). This applies to all new instances */
+		static void setLazyItemTrees(bool value);
+		static bool isLazyItemTrees(void);
+
+		/*! \brief Creates (true) or destroys (false) the item tree of the table. A table without item tree
+		keeps its last known dimensions and is drawn by the simplified item */
+		void setItemTreeCreated(bool value);
+		bool isItemTreeCreated(void);
+
 		//! \brief Returns the current count of connected relationships
 		int getConnectRelsCount(void);
 
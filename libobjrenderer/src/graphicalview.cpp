@@ -48,6 +48,11 @@ void GraphicalView::configureObject(void)
 	TableObject *tab_obj=nullptr;
 	Tag *tag=view->getTag();
 
+	/* At reduced levels of detail or when the table has no item tree only the simplified
+	item is updated. The full item tree is configured when it must be displayed again */
+	if(configureSimplifiedObject())
+		return;
+
 	//Configures the view's title
 	title->configureObject(view);
 
@@ -261,6 +266,40 @@ void GraphicalView::configureObject(void)
 	this->setToolTip(this->table_tooltip);
 	configureTag();
 	configureSQLDisabledInfo();
+	updateItemCache();
 	requestRelationshipsUpdate();
 }
 
+void GraphicalView::estimateDimensions(void)
+{
+	View *view=dynamic_cast<View *>(this->getSourceObject());
+	QStringList col_texts, ext_texts;
+	unsigned sql_type=Reference::SQL_REFER_SELECT;
+	unsigned count=view->getReferenceCount(sql_type);
+	Reference ref;
+
+	if(count==0)
+	{
+		sql_type=Reference::SQL_VIEW_DEFINITION;
+		count=view->getReferenceCount(sql_type);
+	}
+
+	for(unsigned i=0; i < count; i++)
+	{
+		ref=view->getReference(i, sql_type);
+
+		if(ref.getTable())
+			col_texts.push_back(ref.getTable()->getName() + QString(".") +
+													(ref.getColumn() ? ref.getColumn()->getName() : QString("*")));
+		else
+			col_texts.push_back(ref.getExpression().simplified().mid(0, 28));
+	}
+
+	for(auto type : { OBJ_RULE, OBJ_TRIGGER })
+	{
+		for(auto obj : *view->getObjectList(type))
+			ext_texts.push_back(obj->getName());
+	}
+
+	setEstimatedDimensions(view->getSchema()->getName() + QString(".") + view->getName(), col_texts, ext_texts);
+}
@@ -32,6 +32,9 @@ class GraphicalView: public BaseTableView {
 	private:
 		Q_OBJECT
 
+	protected:
+		void estimateDimensions(void);
+
 	public:
 		GraphicalView(View *view);
 
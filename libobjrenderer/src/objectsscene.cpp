@@ -29,11 +29,16 @@ QSizeF ObjectsScene::custom_paper_size=QSizeF(0,0);
 QBrush ObjectsScene::grid;
 bool ObjectsScene::corner_move=true;
 bool ObjectsScene::invert_panning_rangesel=false;
+bool ObjectsScene::show_frame_time=false;
 
 ObjectsScene::ObjectsScene(void)
 {
 	moving_objs=move_scene=false;
 	enable_range_sel=true;
+	zoom_factor=1;
+	frame_time=0;
+	item_cache_suspended=false;
+	lod_level=BaseTableView::LOD_FULL;
 	this->setBackgroundBrush(grid);
 
 	sel_ini_pnt.setX(NAN);
@@ -58,6 +63,17 @@ ObjectsScene::ObjectsScene(void)
 
 	scene_move_timer.setInterval(SCENE_MOVE_TIMEOUT);
 	corner_hover_timer.setInterval(SCENE_MOVE_TIMEOUT * 10);
+
+	connect(&item_trees_timer, SIGNAL(timeout()), this, SLOT(createExposedItemTrees()));
+	connect(&rels_update_timer, SIGNAL(timeout()), this, SLOT(updateDirtyRelationships()));
+	connect(&teardown_timer, SIGNAL(timeout()), this, SLOT(teardownHiddenTables()));
+
+	item_trees_timer.setSingleShot(true);
+	item_trees_timer.setInterval(0);
+	teardown_timer.setInterval(TEARDOWN_INTERVAL);
+	rels_update_timer.setSingleShot(true);
+	rels_update_timer.setInterval(RELS_UPDATE_INTERVAL);
+	lazy_clock.start();
 }
 
 ObjectsScene::~ObjectsScene(void)
@@ -68,6 +84,11 @@ ObjectsScene::~ObjectsScene(void)
 							 OBJ_VIEW, OBJ_TABLE, OBJ_SCHEMA };
 	unsigned i, count=sizeof(obj_types)/sizeof(ObjectType);
 
+	item_trees_timer.stop();
+	teardown_timer.stop();
+	rels_update_timer.stop();
+	dirty_rels.clear();
+
 	this->removeItem(selection_rect);
 	this->removeItem(rel_line);
 
@@ -100,6 +121,9 @@ ObjectsScene::~ObjectsScene(void)
 		}
 	}
 
+	index_pending.clear();
+	objs_index.clear();
+
 	//The graphical representation of db objects must be destroyed in a sorted way
 	std::sort(removed_objs.begin(), removed_objs.end());
 	while(!removed_objs.empty())
@@ -124,6 +148,16 @@ bool ObjectsScene::isCornerMoveEnabled(void)
 	return(ObjectsScene::corner_move);
 }
 
+void ObjectsScene::setShowFrameTime(bool value)
+{
+	ObjectsScene::show_frame_time=value;
+}
+
+bool ObjectsScene::isShowFrameTime(void)
+{
+	return(ObjectsScene::show_frame_time);
+}
+
 QPointF ObjectsScene::alignPointToGrid(const QPointF &pnt)
 {
 	QPointF p(roundf(pnt.x()/grid_size) * grid_size,
@@ -146,40 +180,169 @@ QRectF ObjectsScene::itemsBoundingRect(bool seek_only_db_objs)
 		return(QGraphicsScene::itemsBoundingRect());
 	else
 	{
-		QRectF rect=QGraphicsScene::itemsBoundingRect();
-		QList<QGraphicsItem *> items=this->items();
-		double x=rect.width(), y=rect.height();
-		BaseObjectView *obj_view=nullptr;
-		QPointF pnt;
-		BaseGraphicObject *graph_obj=nullptr;
+		updateObjectsIndex();
 
-		for(auto &item : items)
+		//The index is empty when there are no visible database objects
+		if(objs_index.count()==0)
+			return(QGraphicsScene::itemsBoundingRect());
+
+		return(objs_index.boundingRect());
+	}
+}
+
+void ObjectsScene::invalidateObjectIndex(BaseObjectView *object)
+{
+	if(object && object->scene()==this && !object->parentItem())
+		index_pending.insert(object);
+}
+
+void ObjectsScene::updateObjectsIndex(void)
+{
+	for(auto object : index_pending)
+	{
+		//Hidden objects (e.g. schemas with no children) can't be reached by any query
+		if(object->scene()!=this || !object->isVisible())
+			objs_index.remove(object);
+		else
+			objs_index.insert(object, object->getSceneRect());
+	}
+
+	index_pending.clear();
+}
+
+QList<BaseObjectView *> ObjectsScene::getObjectsAt(const QRectF &rect)
+{
+	QList<BaseObjectView *> objects;
+	BaseObjectView *object=nullptr;
+
+	updateObjectsIndex();
+
+	for(auto item : objs_index.intersects(rect))
+	{
+		object=dynamic_cast<BaseObjectView *>(item);
+
+		if(object && object->isVisible())
+			objects.push_back(object);
+	}
+
+	return(objects);
+}
+
+void ObjectsScene::renderOverview(QPainter *painter, const QRectF &target, const QRectF &source)
+{
+	if(!painter || source.isEmpty() || target.isEmpty())
+		return;
+
+	QList<BaseObjectView *> objects=getObjectsAt(source);
+	QList<BaseObjectView *> schemas, rels, others;
+	BaseTableView *tab_view=nullptr;
+	RelationshipView *rel_view=nullptr;
+	BaseTable *table=nullptr;
+	Schema *schema=nullptr;
+	Tag *tag=nullptr;
+	QString title_attrib;
+	QColor color;
+	QPen pen;
+
+	//Separating the objects in order to draw the schemas below the relationships and these ones below the other objects
+	for(auto object : objects)
+	{
+		if(dynamic_cast<SchemaView *>(object))
+			schemas.push_back(object);
+		else if(dynamic_cast<RelationshipView *>(object))
+			rels.push_back(object);
+		else
+			others.push_back(object);
+	}
+
+	painter->save();
+	painter->fillRect(target, Qt::white);
+	painter->setClipRect(target);
+	painter->translate(target.topLeft());
+	painter->scale(target.width()/source.width(), target.height()/source.height());
+	painter->translate(-source.topLeft());
+
+	for(auto object : schemas)
+	{
+		schema=dynamic_cast<Schema *>(object->getSourceObject());
+		color=schema->getFillColor();
+		color.setAlpha(80);
+		painter->setBrush(color);
+
+		pen=QPen(QColor(color.red()/3, color.green()/3, color.blue()/3, 80), 1);
+		pen.setCosmetic(true);
+		painter->setPen(pen);
+		painter->drawRect(object->sceneBoundingRect());
+	}
+
+	painter->setBrush(Qt::NoBrush);
+	for(auto object : rels)
+	{
+		rel_view=dynamic_cast<RelationshipView *>(object);
+
+		for(auto lin : rel_view->lines)
 		{
-			obj_view=dynamic_cast<BaseObjectView *>(item);
+			if(!lin->isVisible())
+				continue;
+
+			pen=lin->pen();
+			pen.setWidth(1);
+			pen.setCosmetic(true);
+			painter->setPen(pen);
+			painter->drawLine(lin->mapToScene(lin->line().p1()), lin->mapToScene(lin->line().p2()));
+		}
+	}
 
-			if(obj_view && obj_view->isVisible())
-			{
-				graph_obj=dynamic_cast<BaseGraphicObject *>(obj_view->getSourceObject());
+	for(auto object : others)
+	{
+		tab_view=dynamic_cast<BaseTableView *>(object);
 
-				if(graph_obj)
-				{
-					if(graph_obj->getObjectType()!=OBJ_RELATIONSHIP &&
-							graph_obj->getObjectType()!=BASE_RELATIONSHIP)
-						pnt=graph_obj->getPosition();
-					else
-						pnt=dynamic_cast<RelationshipView *>(obj_view)->__boundingRect().topLeft();
+		if(tab_view)
+		{
+			table=dynamic_cast<BaseTable *>(tab_view->getSourceObject());
+			tag=table->getTag();
 
-					if(pnt.x() < x)
-						x=pnt.x();
+			if(table->getObjectType()==OBJ_VIEW && !tag)
+				title_attrib=ParsersAttributes::VIEW_TITLE;
+			else
+				title_attrib=ParsersAttributes::TABLE_TITLE;
 
-					if(pnt.y() < y)
-						y=pnt.y();
-				}
+			pen=BaseObjectView::getBorderStyle(title_attrib);
+
+			if(!tag)
+				painter->setBrush(BaseObjectView::getFillStyle(title_attrib));
+			else
+			{
+				painter->setBrush(tag->getFillStyle(title_attrib));
+				pen.setColor(tag->getElementColor(title_attrib, Tag::BORDER_COLOR));
 			}
 		}
+		else
+		{
+			painter->setBrush(BaseObjectView::getFillStyle(BaseObject::getSchemaName(OBJ_TEXTBOX)));
+			pen=BaseObjectView::getBorderStyle(BaseObject::getSchemaName(OBJ_TEXTBOX));
+		}
 
-		return(QRectF(QPointF(x, y), rect.bottomRight()));
+		pen.setWidth(1);
+		pen.setCosmetic(true);
+		painter->setPen(pen);
+		painter->drawRect(object->sceneBoundingRect());
 	}
+
+	//Highlighting the selected objects
+	pen=BaseObjectView::getBorderStyle(ParsersAttributes::OBJ_SELECTION);
+	pen.setWidth(1);
+	pen.setCosmetic(true);
+	painter->setPen(pen);
+	painter->setBrush(BaseObjectView::getFillStyle(ParsersAttributes::OBJ_SELECTION));
+
+	for(auto object : schemas + others)
+	{
+		if(object->isSelected())
+			painter->drawRect(object->sceneBoundingRect());
+	}
+
+	painter->restore();
 }
 
 void ObjectsScene::setGridSize(unsigned size)
@@ -413,7 +576,199 @@ void ObjectsScene::addItem(QGraphicsItem *item)
 		}
 
 		QGraphicsScene::addItem(item);
+
+		//The objects are configured prior their insertion so the cache must be adjusted to the scene's zoom
+		if(obj)
+		{
+			obj->updateItemCache();
+			invalidateObjectIndex(obj);
+		}
+
+		if(tab)
+		{
+			tab->setLevelOfDetail(lod_level);
+
+			if(!tab->isItemTreeCreated())
+				item_trees_timer.start();
+		}
+	}
+}
+
+void ObjectsScene::setZoomFactor(double zoom)
+{
+	unsigned lod=BaseTableView::getLevelOfDetail(zoom);
+	BaseTableView *tab=nullptr;
+	bool zoom_changed=(zoom!=zoom_factor);
+
+	zoom_factor=zoom;
+
+	//The labels' pixmaps are resized to the new zoom (the bodies are rasterized again by Qt itself)
+	if(zoom_changed)
+		updateItemCache();
+
+	//The tables are changed only when the zoom crosses a level of detail threshold
+	if(lod==lod_level)
+		return;
+
+	lod_level=lod;
+
+	for(auto item : this->items())
+	{
+		if(item->parentItem())
+			continue;
+
+		tab=dynamic_cast<BaseTableView *>(item);
+
+		if(tab)
+		{
+			tab->setLevelOfDetail(lod);
+
+			/* At reduced levels of detail the item trees are not needed at all so the lazy
+			tables are turned back into placeholders freeing the memory used by their items */
+			if(lod!=BaseTableView::LOD_FULL && BaseTableView::isLazyItemTrees())
+				tab->setItemTreeCreated(false);
+		}
+	}
+
+	if(lod!=BaseTableView::LOD_FULL && BaseTableView::isLazyItemTrees())
+	{
+		created_tree_tabs.clear();
+		teardown_timer.stop();
+	}
+	else if(BaseTableView::isLazyItemTrees())
+		item_trees_timer.start();
+}
+
+void ObjectsScene::setItemCacheSuspended(bool value)
+{
+	if(item_cache_suspended!=value)
+	{
+		item_cache_suspended=value;
+		updateItemCache();
+	}
+}
+
+bool ObjectsScene::isItemCacheSuspended(void)
+{
+	return(item_cache_suspended);
+}
+
+void ObjectsScene::updateItemCache(void)
+{
+	BaseObjectView *obj=nullptr;
+
+	for(auto item : this->items())
+	{
+		if(item->parentItem())
+			continue;
+
+		obj=dynamic_cast<BaseObjectView *>(item);
+
+		if(obj)
+			obj->updateItemCache();
+	}
+}
+
+void ObjectsScene::setExposedRect(const QRectF &rect)
+{
+	exposed_rect=rect;
+
+	//Several changes in the exposed area (e.g. while scrolling) are handled at once when the event loop is idle
+	if(BaseTableView::isLazyItemTrees())
+		item_trees_timer.start();
+}
+
+void ObjectsScene::createAllItemTrees(void)
+{
+	BaseTableView *tab=nullptr;
+
+	for(auto item : this->items())
+	{
+		if(item->parentItem())
+			continue;
+
+		tab=dynamic_cast<BaseTableView *>(item);
+
+		if(tab && !tab->isItemTreeCreated())
+		{
+			tab->setItemTreeCreated(true);
+
+			if(BaseTableView::isLazyItemTrees())
+				created_tree_tabs[tab]=lazy_clock.elapsed();
+		}
 	}
+
+	if(!created_tree_tabs.isEmpty())
+		teardown_timer.start();
+}
+
+void ObjectsScene::createExposedItemTrees(void)
+{
+	BaseTableView *tab=nullptr;
+	qint64 now=lazy_clock.elapsed();
+
+	//There is no need to create the item trees while the tables are being drawn in a simplified form
+	if(!BaseTableView::isLazyItemTrees() ||
+		 exposed_rect.isEmpty() || lod_level!=BaseTableView::LOD_FULL)
+		return;
+
+	for(auto object : getObjectsAt(exposed_rect.adjusted(-EXPOSED_RECT_MARGIN, -EXPOSED_RECT_MARGIN,
+																												EXPOSED_RECT_MARGIN, EXPOSED_RECT_MARGIN)))
+	{
+		tab=dynamic_cast<BaseTableView *>(object);
+
+		if(tab)
+		{
+			tab->setItemTreeCreated(true);
+			created_tree_tabs[tab]=now;
+		}
+	}
+
+	if(!created_tree_tabs.isEmpty())
+		teardown_timer.start();
+}
+
+void ObjectsScene::teardownHiddenTables(void)
+{
+	qint64 now=lazy_clock.elapsed();
+	QRectF rect=exposed_rect.adjusted(-EXPOSED_RECT_MARGIN, -EXPOSED_RECT_MARGIN,
+																		EXPOSED_RECT_MARGIN, EXPOSED_RECT_MARGIN);
+	auto itr=created_tree_tabs.begin();
+
+	if(!BaseTableView::isLazyItemTrees())
+	{
+		created_tree_tabs.clear();
+		teardown_timer.stop();
+		return;
+	}
+
+	while(itr!=created_tree_tabs.end())
+	{
+		BaseTableView *tab=itr.key();
+
+		//Tables still exposed have their timestamp renewed
+		if(tab->sceneBoundingRect().intersects(rect))
+		{
+			itr.value()=now;
+			itr++;
+		}
+		//Selected tables are kept since the user may be interacting with them (e.g. moving them out of the viewport)
+		else if(!tab->isSelected() && (now - itr.value()) >= TEARDOWN_TIMEOUT)
+		{
+			tab->setItemTreeCreated(false);
+			itr=created_tree_tabs.erase(itr);
+		}
+		else
+			itr++;
+	}
+
+	if(created_tree_tabs.isEmpty())
+		teardown_timer.stop();
+}
+
+double ObjectsScene::getZoomFactor(void)
+{
+	return(zoom_factor);
 }
 
 void ObjectsScene::removeItem(QGraphicsItem *item)
@@ -424,7 +779,10 @@ void ObjectsScene::removeItem(QGraphicsItem *item)
 		RelationshipView *rel=dynamic_cast<RelationshipView *>(item);
 
 		if(rel)
+		{
 			rel->disconnectTables();
+			dirty_rels.remove(rel);
+		}
 
 		item->setVisible(false);
 		item->setActive(false);
@@ -432,6 +790,9 @@ void ObjectsScene::removeItem(QGraphicsItem *item)
 
 		if(object)
 		{
+			index_pending.remove(object);
+			objs_index.remove(object);
+			created_tree_tabs.remove(dynamic_cast<BaseTableView *>(object));
 			disconnect(object, nullptr, this, nullptr);
 			disconnect(object, nullptr, dynamic_cast<BaseGraphicObject*>(object->getSourceObject()), nullptr);
 			disconnect(dynamic_cast<BaseGraphicObject*>(object->getSourceObject()), nullptr, object, nullptr);
@@ -440,6 +801,47 @@ void ObjectsScene::removeItem(QGraphicsItem *item)
 	}
 }
 
+void ObjectsScene::drawBackground(QPainter *painter, const QRectF &rect)
+{
+	if(show_frame_time && painter->device()->devType()==QInternal::Widget)
+		frame_timer.start();
+	else
+		frame_timer.invalidate();
+
+	QGraphicsScene::drawBackground(painter, rect);
+}
+
+void ObjectsScene::drawForeground(QPainter *painter, const QRectF &rect)
+{
+	QGraphicsScene::drawForeground(painter, rect);
+
+	//The time is displayed only on viewports, never on exported images or printed pages
+	if(show_frame_time && frame_timer.isValid())
+	{
+		double elapsed=frame_timer.nsecsElapsed() / 1000000.0;
+		QString text;
+		QRectF txt_rect;
+
+		//Smoothing the measurement so the displayed value doesn't flicker between frames
+		frame_time=(frame_time==0 ? elapsed : (frame_time * 0.8) + (elapsed * 0.2));
+		text=QString("%1 ms").arg(frame_time, 0, 'f', 2);
+
+		//Drawing in the viewport's coordinates so the text stays at the same place regardless the zoom and scrolling
+		painter->save();
+		painter->resetTransform();
+		painter->setFont(QFont(painter->font().family(), 9));
+		txt_rect=painter->fontMetrics().boundingRect(text);
+		txt_rect.moveTo(5, 5);
+		txt_rect.adjust(-3, -2, 3, 2);
+		painter->setPen(Qt::NoPen);
+		painter->setBrush(QColor(0, 0, 0, 160));
+		painter->drawRect(txt_rect);
+		painter->setPen(Qt::white);
+		painter->drawText(txt_rect, Qt::AlignCenter, text);
+		painter->restore();
+	}
+}
+
 void ObjectsScene::mouseDoubleClickEvent(QGraphicsSceneMouseEvent *event)
 {
 	QGraphicsScene::mouseDoubleClickEvent(event);
@@ -776,9 +1178,6 @@ void ObjectsScene::mouseReleaseEvent(QGraphicsSceneMouseEvent *event)
 					if(p.y() < 0) p.setY(0);
 					items[i]->setPos(p);
 				}
-
-				rect.setTopLeft(items[i]->pos());
-				rect.setSize(items[i]->boundingRect().size());
 			}
 			else
 			{
@@ -804,11 +1203,38 @@ void ObjectsScene::mouseReleaseEvent(QGraphicsSceneMouseEvent *event)
 
 					//Assing the new points to relationship and reconfigure its line
 					rel->getSourceObject()->setPoints(points);
-					rel->configureLine();
+					scheduleRelationshipUpdate(rel);
 				}
+			}
+		}
 
-				rect=rel->__boundingRect();
+		if(BaseObjectView::isPlaceholderEnabled())
+		{
+			/* Updating relationships related to moved tables. Converting the list of table to a set
+	   in order to remove the duplicated elements */
+			for(auto &obj : tables.toSet())
+			{
+				tab_view=dynamic_cast<BaseTableView *>(obj);
+				if(tab_view)
+					tab_view->requestRelationshipsUpdate();
 			}
+		}
+
+		/* Configuring all the relationships affected by the movement at once. This must be done prior
+		to the calculation of the scene extremities so the relationships' bounding rects are up to date */
+		updateDirtyRelationships();
+
+		for(i=0; i < count; i++)
+		{
+			rel=dynamic_cast<RelationshipView *>(items[i]);
+
+			if(!rel)
+			{
+				rect.setTopLeft(items[i]->pos());
+				rect.setSize(items[i]->boundingRect().size());
+			}
+			else
+				rect=rel->__boundingRect();
 
 			//Made the comparisson between the scene extremity and the object's bounding rect
 			if(rect.left() < x1) x1=rect.left();
@@ -830,18 +1256,6 @@ void ObjectsScene::mouseReleaseEvent(QGraphicsSceneMouseEvent *event)
 			this->setSceneRect(rect);
 		}
 
-		if(BaseObjectView::isPlaceholderEnabled())
-		{
-			/* Updating relationships related to moved tables. Converting the list of table to a set
-	   in order to remove the duplicated elements */
-			for(auto &obj : tables.toSet())
-			{
-				tab_view=dynamic_cast<BaseTableView *>(obj);
-				if(tab_view)
-					tab_view->requestRelationshipsUpdate();
-			}
-		}
-
 		emit s_objectsMoved(true);
 		moving_objs=false;
 		sel_ini_pnt.setX(NAN);
@@ -851,9 +1265,19 @@ void ObjectsScene::mouseReleaseEvent(QGraphicsSceneMouseEvent *event)
 	{
 		QPolygonF pol;
 		QPainterPath sel_area;
+		QRectF sel_rect=selection_rect->polygon().boundingRect();
 
-		sel_area.addRect(selection_rect->polygon().boundingRect());
-		this->setSelectionArea(sel_area, Qt::IntersectsItemShape);
+		/* Only the objects indexed in the selection area are tested against it instead of all the items in the scene.
+		The items' shapes are still checked so the selection works the same way as QGraphicsScene::setSelectionArea */
+		sel_area.addRect(sel_rect);
+		this->clearSelection();
+
+		for(auto object : getObjectsAt(sel_rect))
+		{
+			if((object->flags() & QGraphicsItem::ItemIsSelectable) &&
+				 object->collidesWithPath(object->mapFromScene(sel_area), Qt::IntersectsItemShape))
+				object->setSelected(true);
+		}
 
 		selection_rect->setVisible(false);
 		selection_rect->setPolygon(pol);
@@ -999,3 +1423,27 @@ bool ObjectsScene::isMovingObjects(void)
 {
 	return(moving_objs);
 }
+
+void ObjectsScene::scheduleRelationshipUpdate(RelationshipView *rel)
+{
+	if(!rel)
+		return;
+
+	dirty_rels.insert(rel);
+
+	if(!rels_update_timer.isActive())
+		rels_update_timer.start();
+}
+
+void ObjectsScene::updateDirtyRelationships(void)
+{
+	QSet<RelationshipView *> rels;
+
+	rels_update_timer.stop();
+
+	//Swapping the set since configuring a line can request other updates
+	rels.swap(dirty_rels);
+
+	for(auto rel : rels)
+		rel->configureLine();
+}
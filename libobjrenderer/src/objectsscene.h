@@ -32,6 +32,7 @@
 #include "tableview.h"
 #include "schemaview.h"
 #include "styledtextboxview.h"
+#include "spatialindex.h"
 
 class ObjectsScene: public QGraphicsScene {
 	private:
@@ -42,6 +43,9 @@ class ObjectsScene: public QGraphicsScene {
 		//! \brief Indicates if the corner move is enabled for the scene
 		static bool corner_move,
 
+		//! \brief Indicates if the time spent to render each frame must be displayed at the viewport's top-left corner
+		show_frame_time,
+
 		/*! \brief Indicates that panning mode and range selection model are activate in inverse mode.
 		By default panning model is activated with a single left-click and range selection with SHIFT + left-click */
 		invert_panning_rangesel;
@@ -51,7 +55,10 @@ class ObjectsScene: public QGraphicsScene {
 
 		static const int SCENE_MOVE_STEP=20,
 		SCENE_MOVE_TIMEOUT=50,
-		SCENE_MOVE_THRESHOLD=30;
+		SCENE_MOVE_THRESHOLD=30,
+
+		//! \brief Interval (in ms) between the layout passes of the relationships while objects are moved (about one per frame)
+		RELS_UPDATE_INTERVAL=16;
 
 		//! \brief Timer responsible to move the scene
 		QTimer scene_move_timer,
@@ -96,6 +103,68 @@ class ObjectsScene: public QGraphicsScene {
 		//! \brief Line used as a guide when inserting new relationship
 		QGraphicsLineItem *rel_line;
 
+		//! \brief Zoom factor currently applied to the viewport
+		double zoom_factor;
+
+		//! \brief Level of detail applied to the tables and views (see BaseTableView::LOD_??? constants)
+		unsigned lod_level;
+
+		/*! \brief Time (in ms) that a table with item tree can stay outside the exposed area before having its item tree
+		destroyed, and the interval in which the scene looks for such tables */
+		static const int TEARDOWN_TIMEOUT=30000,
+		TEARDOWN_INTERVAL=10000,
+
+		//! \brief Margin added around the exposed area so the tables near the viewport's edges have their item trees created in advance
+		EXPOSED_RECT_MARGIN=200;
+
+		//! \brief Area of the scene currently visible on the viewport
+		QRectF exposed_rect;
+
+		//! \brief Timer used to coalesce the several changes on the exposed area (scrolling, zooming) into a single item trees creation
+		QTimer item_trees_timer,
+
+		//! \brief Timer used to periodically destroy the item trees of the tables that are not exposed anymore
+		teardown_timer;
+
+		//! \brief Clock used to register the last time each table with item tree was exposed
+		QElapsedTimer lazy_clock;
+
+		//! \brief Stores the tables with item tree and the last time (see lazy_clock) they were within the exposed area
+		QHash<BaseTableView *, qint64> created_tree_tabs;
+
+		/*! \brief Relationships whose lines must be configured in the next layout pass. Being a set, a relationship
+		between two moved tables is configured once even if both tables request its update */
+		QSet<RelationshipView *> dirty_rels;
+
+		//! \brief Timer that triggers the layout pass of the dirty relationships while the objects are being moved
+		QTimer rels_update_timer;
+
+		//! \brief Indicates that the items' cache is temporarily disabled (see setItemCacheSuspended)
+		bool item_cache_suspended;
+
+		//! \brief Measures the time spent in the current frame. Started when the background is drawn
+		QElapsedTimer frame_timer;
+
+		//! \brief Average time (in ms) spent to render the last frames
+		double frame_time;
+
+		/*! \brief Spatial index of the database objects placed directly on the scene (tables, views, relationships,
+		textboxes and schemas). It's used to answer the area queries without iterating over all the items */
+		SpatialIndex objs_index;
+
+		/*! \brief Objects that were moved or resized and whose rects must be updated on the index. The updates are
+		deferred until the next query so an object moved several times between two queries is reindexed once */
+		QSet<BaseObjectView *> index_pending;
+
+		//! \brief Applies the cache modes to all the objects in the scene (see BaseObjectView::updateItemCache)
+		void updateItemCache(void);
+
+		//! \brief Updates the rects of the objects marked via invalidateObjectIndex() on the spatial index
+		void updateObjectsIndex(void);
+
+		//! \brief Returns the database objects (see objs_index) whose areas intersect the specified rect
+		QList<BaseObjectView *> getObjectsAt(const QRectF &rect);
+
 		//! \brief Aligns the specified point in relation to the grid
 		static QPointF alignPointToGrid(const QPointF &pnt);
 
@@ -114,6 +183,12 @@ class ObjectsScene: public QGraphicsScene {
 		void mouseReleaseEvent(QGraphicsSceneMouseEvent *event);
 		void mouseDoubleClickEvent(QGraphicsSceneMouseEvent *event);
 
+		//! \brief Starts the measurement of the frame's rendering time
+		void drawBackground(QPainter *painter, const QRectF &rect);
+
+		//! \brief Finishes the measurement of the frame's rendering time and draws it over the viewport
+		void drawForeground(QPainter *painter, const QRectF &rect);
+
 		//! \brief Draws a line from the point 'p_start' to the cursor position and simulates the relationship creation
 		void showRelationshipLine(bool value, const QPointF &p_start=QPointF(NAN,NAN));
 
@@ -125,6 +200,11 @@ class ObjectsScene: public QGraphicsScene {
 		static void setInvertPanningRangeSelection(bool invert);
 		static bool isCornerMoveEnabled(void);
 
+		/*! \brief Toggles the display of the frame rendering time over the viewports. The viewports must be fully
+		updated at each frame so the measurement can be compared between frames (see ModelWidget::updateRenderHints) */
+		static void setShowFrameTime(bool value);
+		static bool isShowFrameTime(void);
+
 		static void setGridSize(unsigned size);
 		static void setGridOptions(bool show_grd, bool align_objs_grd, bool show_page_dlm);
 		static void getGridOptions(bool &show_grd, bool &align_objs_grd, bool &show_pag_dlm);
@@ -142,9 +222,36 @@ class ObjectsScene: public QGraphicsScene {
 		/*! \brief Returns the items bounding rect. By default the method returns the same as QGraphicsScene::itemsBoundingRect.
 		If the parameter seek_only_db_objs is true the returned rect will have the origin point calculated based upon the
 		visible objects that inherits BaseObjectView and are database model objects (tables, views, textboxes, schemas and relationships).
-		Note: using this method with seek_only_db_objs=true can be time expensive depending on the size of the model so use it wisely. */
+		The origin point is retrieved from the spatial index of the database objects so there's no need to visit every item */
 		QRectF itemsBoundingRect(bool seek_only_db_objs=false);
 
+		/*! \brief Marks the object to have its rect updated on the spatial index. This is called by the objects
+		themselves whenever they are moved or resized (see BaseObjectView::invalidateSceneIndex) */
+		void invalidateObjectIndex(BaseObjectView *object);
+
+		/*! \brief Draws a simplified version of the area 'source' of the scene onto the area 'target' of the painter. Only
+		the shapes of the database objects are drawn (no texts, shadows or cached pixmaps) which makes this method
+		suitable to render the whole scene in small sizes (e.g. the model overview) */
+		void renderOverview(QPainter *painter, const QRectF &target, const QRectF &source);
+
+		/*! \brief Informs the zoom factor applied to the viewport. When the zoom crosses one of the level of detail
+		thresholds (see BaseTableView::setLevelOfDetailZoom) all the tables and views are simplified or restored */
+		void setZoomFactor(double zoom);
+		double getZoomFactor(void);
+
+		/*! \brief Informs the area of the scene visible on the viewport. When the lazy item trees are enabled
+		(see BaseTableView::setLazyItemTrees) the tables within that area have their item trees created */
+		void setExposedRect(const QRectF &rect);
+
+		/*! \brief Creates the item trees of all tables in the scene. This must be called prior to any operation
+		that renders the whole scene like exporting and printing */
+		void createAllItemTrees(void);
+
+		/*! \brief Disables (true) or enables (false) the items' cache for the whole scene. The cache must be suspended prior
+		to rendering the scene on other devices than the viewport (exporting and printing) so the objects are drawn in vector form */
+		void setItemCacheSuspended(bool value);
+		bool isItemCacheSuspended(void);
+
 		//! \brief Returns a vector containing all the page rects.
 		vector<QRectF> getPagesForPrinting(const QSizeF &paper_size, const QSizeF &margin, unsigned &h_page_cnt, unsigned &v_page_cnt);
 
@@ -153,6 +260,10 @@ class ObjectsScene: public QGraphicsScene {
 		bool isRelationshipLineVisible(void);
 		bool isMovingObjects(void);
 
+		/*! \brief Marks the relationship's line to be configured in the next layout pass. The passes occur at most once per
+		RELS_UPDATE_INTERVAL while objects are being moved and once more when the movement ends */
+		void scheduleRelationshipUpdate(RelationshipView *rel);
+
 	public slots:
 		void alignObjectsToGrid(void);
 		void update(void);
@@ -171,6 +282,15 @@ class ObjectsScene: public QGraphicsScene {
 		//! \brief Enable the panning mode for the viewport
 		void enablePannigMode(bool value);
 
+		//! \brief Creates the item trees of the tables within the exposed area and destroys the ones not exposed for a long time
+		void createExposedItemTrees(void);
+
+		//! \brief Destroys the item trees of the tables that stayed outside the exposed area longer than TEARDOWN_TIMEOUT
+		void teardownHiddenTables(void);
+
+		//! \brief Configures the lines of all the relationships marked via scheduleRelationshipUpdate()
+		void updateDirtyRelationships(void);
+
 		//! \brief Handles and redirects the signal emitted by the modified object
 		void emitObjectModification(BaseGraphicObject *object);
 
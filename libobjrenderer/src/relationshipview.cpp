@@ -17,6 +17,7 @@
 */
 
 #include "relationshipview.h"
+#include "objectsscene.h"
 
 bool RelationshipView::hide_name_label=false;
 unsigned RelationshipView::line_conn_mode=RelationshipView::CONNECT_FK_TO_PK;
@@ -428,9 +429,9 @@ void RelationshipView::connectTables(void)
 			tables[i]->disconnect(this);
 
 			if(BaseObjectView::isPlaceholderEnabled())
-				connect(tables[i], SIGNAL(s_relUpdateRequest(void)), this, SLOT(configureLine(void)));
+				connect(tables[i], SIGNAL(s_relUpdateRequest(void)), this, SLOT(requestLineUpdate(void)));
 			else
-				connect(tables[i], SIGNAL(s_objectMoved(void)), this, SLOT(configureLine(void)));
+				connect(tables[i], SIGNAL(s_objectMoved(void)), this, SLOT(requestLineUpdate(void)));
 
 			connect(tables[i], SIGNAL(s_objectDimensionChanged(void)), this, SLOT(configureLine(void)));
 		}
@@ -454,6 +455,16 @@ void RelationshipView::configureObject(void)
 	connect(rel_base, SIGNAL(s_objectModified()), this, SLOT(configureLine(void)));
 }
 
+void RelationshipView::requestLineUpdate(void)
+{
+	ObjectsScene *scene=dynamic_cast<ObjectsScene *>(this->scene());
+
+	if(scene && scene->isMovingObjects())
+		scene->scheduleRelationshipUpdate(this);
+	else
+		this->configureLine();
+}
+
 void RelationshipView::configurePositionInfo(void)
 {
 	if(this->isSelected())
@@ -853,6 +864,7 @@ void RelationshipView::configureLine(void)
 		this->configureDescriptor();
 		this->configureLabels();
 		this->configureProtectedIcon();
+		this->invalidateSceneIndex();
 
 		configuring_line=false;
 
@@ -1329,5 +1341,29 @@ QRectF RelationshipView::__boundingRect(void)
 		}
 	}
 
-	return(QRectF(x1, y1, x2, y2));
+	return(QRectF(QPointF(x1, y1), QPointF(x2, y2)));
+}
+
+QRectF RelationshipView::getSceneRect(void)
+{
+	QRectF rect=this->mapRectToScene(this->__boundingRect());
+	vector<QGraphicsLineItem *> all_lines=lines;
+
+	all_lines.insert(all_lines.end(), pk_lines.begin(), pk_lines.end());
+	all_lines.insert(all_lines.end(), fk_lines.begin(), fk_lines.end());
+
+	//The lines can go beyond the descriptor/points area since they are connected to the tables
+	for(auto &lin : all_lines)
+	{
+		if(lin->isVisible())
+			rect=rect.united(lin->sceneBoundingRect());
+	}
+
+	for(auto &attrib : attributes)
+	{
+		if(attrib->isVisible())
+			rect=rect.united(attrib->sceneBoundingRect());
+	}
+
+	return(rect);
 }
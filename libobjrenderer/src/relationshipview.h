@@ -137,6 +137,11 @@ class RelationshipView: public BaseObjectView {
 		//! \brief Makes the comple relationship configuration
 		void configureObject(void);
 
+		/*! \brief Requests the reconfiguration of the line when one of the tables is moved. While the objects are being
+		moved in the scene the line is configured in a deferred layout pass (see ObjectsScene::scheduleRelationshipUpdate)
+		so it is calculated only once per frame even when both tables are moved */
+		void requestLineUpdate(void);
+
 	public:
 		static const unsigned CONNECT_CENTER_PNTS=0,
 		CONNECT_FK_TO_PK=1;
@@ -147,6 +152,9 @@ class RelationshipView: public BaseObjectView {
 		//! \brief Calculates the relationship bounding rect considering all the children objects dimension
 		QRectF __boundingRect(void);
 
+		//! \brief Returns the area occupied by the relationship in the scene, including the lines and attributes
+		QRectF getSceneRect(void);
+
 		//! \brief Returns the relationship that generates the graphical representation
 		BaseRelationship *getSourceObject(void);
 
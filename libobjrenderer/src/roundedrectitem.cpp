@@ -28,6 +28,7 @@ void RoundedRectItem::setBorderRadius(double radius)
 {
 	this->radius=radius;
 	createPolygon();
+	this->update();
 }
 
 double RoundedRectItem::getBorderRadius(void)
@@ -42,6 +43,7 @@ void RoundedRectItem::setRoundedCorners(unsigned corners)
 
 	this->corners=corners;
 	createPolygon();
+	this->update();
 }
 
 unsigned RoundedRectItem::getRoundedCorners(void)
@@ -37,6 +37,9 @@ SchemaView::SchemaView(Schema *schema) : BaseObjectView(schema)
 	this->addToGroup(sch_name);
 	this->setZValue(-5);
 
+	//The box isn't cached because it can cover a huge area of the scene and its translucent fill is cheap to paint
+	setItemCacheMode(sch_name, QGraphicsItem::ItemCoordinateCache);
+
 	this->configureObject();
 	all_selected=false;
 
@@ -242,7 +245,10 @@ void SchemaView::configureObject(void)
 		this->configureProtectedIcon();
 		this->configurePositionInfo(this->pos());
 		this->configureSQLDisabledInfo();
+		this->updateItemCache();
 	}
 	else
 		this->setVisible(false);
+
+	this->invalidateSceneIndex();
 }
@@ -0,0 +1,107 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2016 - Raphael Araújo e Silva <raphael@pgmodeler.com.br>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "simplifiedtableitem.h"
+
+SimplifiedTableItem::SimplifiedTableItem(QGraphicsItem *parent) : QGraphicsItem(parent)
+{
+	title_height=0;
+	title_visible=true;
+
+	/* The item is painted from a pixmap rendered in item coordinates so the zoom changes
+	while the item is visible only scale the cached pixmap instead of repainting the texts */
+	this->setCacheMode(QGraphicsItem::ItemCoordinateCache);
+}
+
+void SimplifiedTableItem::setRect(const QRectF &rect, double title_height)
+{
+	if(this->rect==rect && this->title_height==title_height)
+		return;
+
+	this->prepareGeometryChange();
+	this->rect=rect;
+	this->title_height=qMin(title_height, rect.height());
+}
+
+void SimplifiedTableItem::setTitle(const QString &title, const QFont &font, const QColor &color, double font_factor)
+{
+	QFontMetricsF fm(font);
+	double text_width=fm.width(title);
+
+	this->title=title;
+	title_font=font;
+	title_color=color;
+
+	//The font is enlarged but the text must fit the box width
+	if(text_width > 0 && text_width * font_factor > rect.width())
+		font_factor=qMax(1.0, rect.width() / text_width);
+
+	title_font.setPointSizeF(title_font.pointSizeF() * font_factor);
+	this->update();
+}
+
+void SimplifiedTableItem::setStyle(const QBrush &title_brush, const QBrush &body_brush, const QPen &border_pen)
+{
+	this->title_brush=title_brush;
+	this->body_brush=body_brush;
+	this->border_pen=border_pen;
+	this->update();
+}
+
+void SimplifiedTableItem::setTitleVisible(bool value)
+{
+	if(title_visible!=value)
+	{
+		title_visible=value;
+		this->update();
+	}
+}
+
+QRectF SimplifiedTableItem::boundingRect(void) const
+{
+	double pw=border_pen.widthF()/2;
+	return(rect.adjusted(-pw, -pw, pw, pw));
+}
+
+void SimplifiedTableItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget *)
+{
+	QFontMetricsF fm(title_font);
+	QRectF title_rect;
+
+	painter->setPen(border_pen);
+
+	if(!title_visible)
+	{
+		painter->setBrush(title_brush);
+		painter->drawRect(rect);
+		return;
+	}
+
+	//The title portion grows to hold the enlarged font
+	title_rect=QRectF(rect.topLeft(), QSizeF(rect.width(), qMin(qMax(title_height, fm.height()), rect.height())));
+
+	painter->setBrush(body_brush);
+	painter->drawRect(rect);
+
+	painter->setBrush(title_brush);
+	painter->drawRect(title_rect);
+
+	painter->setFont(title_font);
+	painter->setPen(title_color);
+	painter->drawText(title_rect, Qt::AlignCenter, fm.elidedText(title, Qt::ElideRight, rect.width()));
+}
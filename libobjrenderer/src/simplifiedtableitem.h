@@ -0,0 +1,78 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2016 - Raphael Araújo e Silva <raphael@pgmodeler.com.br>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libobjrenderer
+\class SimplifiedTableItem
+\brief Represents a table (or view) as a single cached primitive: a box with the object's name on its title or
+a plain filled rectangle. It's used by BaseTableView in place of its full item tree when the zoom is low enough
+to make the columns unreadable (see BaseTableView::setLevelOfDetail)
+*/
+
+#ifndef SIMPLIFIED_TABLE_ITEM_H
+#define SIMPLIFIED_TABLE_ITEM_H
+
+#include <QGraphicsItem>
+#include <QPainter>
+
+class SimplifiedTableItem: public QGraphicsItem {
+	private:
+		//! \brief Rectangle of the whole item
+		QRectF rect;
+
+		//! \brief Height of the title portion of the box
+		double title_height;
+
+		//! \brief Text drawn on the title
+		QString title;
+
+		//! \brief Font used to draw the title (enlarged to be readable at low zoom)
+		QFont title_font;
+
+		//! \brief Color of the title text
+		QColor title_color;
+
+		//! \brief Brushes used to fill the title and the body respectively
+		QBrush title_brush, body_brush;
+
+		//! \brief Pen used to draw the borders
+		QPen border_pen;
+
+		//! \brief Indicates if the title portion is drawn, otherwise the item is drawn as a plain rectangle
+		bool title_visible;
+
+	public:
+		SimplifiedTableItem(QGraphicsItem *parent=nullptr);
+
+		//! \brief Defines the dimensions of the item and the height of its title portion
+		void setRect(const QRectF &rect, double title_height);
+
+		//! \brief Configures the title text. The font is scaled by the font_factor and reduced when the text exceeds the box width
+		void setTitle(const QString &title, const QFont &font, const QColor &color, double font_factor);
+
+		//! \brief Configures the brushes and the border used to draw the item
+		void setStyle(const QBrush &title_brush, const QBrush &body_brush, const QPen &border_pen);
+
+		//! \brief Toggles the title portion drawing
+		void setTitleVisible(bool value);
+
+		QRectF boundingRect(void) const;
+		void paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget *);
+};
+
+#endif
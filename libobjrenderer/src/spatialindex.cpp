@@ -0,0 +1,419 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2016 - Raphael Araújo e Silva <raphael@pgmodeler.com.br>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "spatialindex.h"
+
+SpatialIndex::Node::Node(Node *parent, bool leaf)
+{
+	this->parent=parent;
+	this->leaf=leaf;
+	item=nullptr;
+}
+
+SpatialIndex::SpatialIndex(void)
+{
+	root=new Node;
+}
+
+SpatialIndex::~SpatialIndex(void)
+{
+	destroyNode(root, nullptr);
+}
+
+double SpatialIndex::area(const QRectF &rect)
+{
+	return(rect.width() * rect.height());
+}
+
+double SpatialIndex::enlargement(const QRectF &rect, const QRectF &new_rect)
+{
+	return(area(unite(rect, new_rect)) - area(rect));
+}
+
+QRectF SpatialIndex::unite(const QRectF &rect1, const QRectF &rect2)
+{
+	return(QRectF(QPointF(qMin(rect1.left(), rect2.left()), qMin(rect1.top(), rect2.top())),
+								QPointF(qMax(rect1.right(), rect2.right()), qMax(rect1.bottom(), rect2.bottom()))));
+}
+
+bool SpatialIndex::rectsIntersect(const QRectF &rect1, const QRectF &rect2)
+{
+	return(rect1.left() <= rect2.right() && rect2.left() <= rect1.right() &&
+				 rect1.top() <= rect2.bottom() && rect2.top() <= rect1.bottom());
+}
+
+void SpatialIndex::updateRect(Node *node)
+{
+	if(node->children.isEmpty())
+		node->rect=QRectF();
+	else
+	{
+		node->rect=node->children.front()->rect;
+
+		for(auto child : node->children)
+			node->rect=unite(node->rect, child->rect);
+	}
+}
+
+SpatialIndex::Node *SpatialIndex::chooseLeaf(const QRectF &rect)
+{
+	Node *node=root, *best=nullptr;
+	double enlarg=0, best_enlarg=0, best_area=0;
+
+	while(!node->leaf)
+	{
+		best=nullptr;
+
+		//Descends to the child that needs the least enlargement to contain the rect (ties resolved by the smallest area)
+		for(auto child : node->children)
+		{
+			enlarg=enlargement(child->rect, rect);
+
+			if(!best || enlarg < best_enlarg ||
+				 (enlarg==best_enlarg && area(child->rect) < best_area))
+			{
+				best=child;
+				best_enlarg=enlarg;
+				best_area=area(child->rect);
+			}
+		}
+
+		node=best;
+	}
+
+	return(node);
+}
+
+void SpatialIndex::insertEntry(Node *entry)
+{
+	Node *leaf=chooseLeaf(entry->rect);
+
+	entry->parent=leaf;
+	leaf->children.push_back(entry);
+	adjustTree(leaf);
+}
+
+SpatialIndex::Node *SpatialIndex::splitNode(Node *node)
+{
+	QVector<Node *> children=node->children;
+	Node *sibling=new Node(nullptr, node->leaf), *child=nullptr;
+	int seed1=0, seed2=1, next=0, i, i1, count=children.size();
+	double waste=0, max_waste=-1, diff=0, max_diff=-1, enlarg1=0, enlarg2=0;
+	QRectF rect1, rect2;
+
+	//Picking as seeds the pair of children that would waste the most area if put in the same node
+	for(i=0; i < count - 1; i++)
+	{
+		for(i1=i + 1; i1 < count; i1++)
+		{
+			waste=area(unite(children[i]->rect, children[i1]->rect)) -
+						area(children[i]->rect) - area(children[i1]->rect);
+
+			if(waste > max_waste)
+			{
+				max_waste=waste;
+				seed1=i;
+				seed2=i1;
+			}
+		}
+	}
+
+	node->children.clear();
+	node->children.push_back(children[seed1]);
+	sibling->children.push_back(children[seed2]);
+	rect1=children[seed1]->rect;
+	rect2=children[seed2]->rect;
+	children.remove(seed2);
+	children.remove(seed1);
+
+	while(!children.isEmpty())
+	{
+		//If one of the groups needs all the remaining children to reach the minimum they're assigned to it
+		if(node->children.size() + children.size() <= MIN_CHILDREN)
+		{
+			for(auto child : children)
+				rect1=unite(rect1, child->rect);
+
+			node->children+=children;
+			break;
+		}
+		else if(sibling->children.size() + children.size() <= MIN_CHILDREN)
+		{
+			for(auto child : children)
+				rect2=unite(rect2, child->rect);
+
+			sibling->children+=children;
+			break;
+		}
+
+		//Picking the child with the greatest preference for one of the groups
+		max_diff=-1;
+		for(i=0; i < children.size(); i++)
+		{
+			diff=qAbs(enlargement(rect1, children[i]->rect) - enlargement(rect2, children[i]->rect));
+
+			if(diff > max_diff)
+			{
+				max_diff=diff;
+				next=i;
+			}
+		}
+
+		child=children[next];
+		children.remove(next);
+		enlarg1=enlargement(rect1, child->rect);
+		enlarg2=enlargement(rect2, child->rect);
+
+		if(enlarg1 < enlarg2 ||
+			 (enlarg1==enlarg2 && (area(rect1) < area(rect2) ||
+														 (area(rect1)==area(rect2) && node->children.size() <= sibling->children.size()))))
+		{
+			node->children.push_back(child);
+			rect1=unite(rect1, child->rect);
+		}
+		else
+		{
+			sibling->children.push_back(child);
+			rect2=unite(rect2, child->rect);
+		}
+	}
+
+	for(auto child : node->children)
+		child->parent=node;
+
+	for(auto child : sibling->children)
+		child->parent=sibling;
+
+	node->rect=rect1;
+	sibling->rect=rect2;
+
+	return(sibling);
+}
+
+void SpatialIndex::adjustTree(Node *node)
+{
+	Node *sibling=nullptr;
+
+	while(node)
+	{
+		if(node->children.size() > MAX_CHILDREN)
+		{
+			sibling=splitNode(node);
+
+			//Splitting the root makes the tree grow in height
+			if(node==root)
+			{
+				root=new Node(nullptr, false);
+				root->children.push_back(node);
+				root->children.push_back(sibling);
+				node->parent=sibling->parent=root;
+			}
+			else
+			{
+				sibling->parent=node->parent;
+				node->parent->children.push_back(sibling);
+			}
+		}
+		else
+			updateRect(node);
+
+		node=node->parent;
+	}
+}
+
+void SpatialIndex::condenseTree(Node *node, QVector<Node *> &orphans)
+{
+	Node *parent=nullptr;
+
+	while(node!=root)
+	{
+		parent=node->parent;
+
+		//Underflowed nodes are removed and their entries inserted again later
+		if(node->children.size() < MIN_CHILDREN)
+		{
+			parent->children.removeOne(node);
+			destroyNode(node, &orphans);
+		}
+		else
+			updateRect(node);
+
+		node=parent;
+	}
+
+	updateRect(root);
+}
+
+void SpatialIndex::destroyNode(Node *node, QVector<Node *> *entries)
+{
+	for(auto child : node->children)
+	{
+		if(!child->item)
+			destroyNode(child, entries);
+		else if(entries)
+		{
+			child->parent=nullptr;
+			entries->push_back(child);
+		}
+		else
+			delete(child);
+	}
+
+	delete(node);
+}
+
+void SpatialIndex::insert(QGraphicsItem *item, const QRectF &rect)
+{
+	Node *entry=nullptr;
+
+	if(!item)
+		return;
+
+	if(entries.contains(item))
+	{
+		if(entries[item]->rect==rect.normalized())
+			return;
+
+		remove(item);
+	}
+
+	entry=new Node(nullptr, false);
+	entry->item=item;
+	entry->rect=rect.normalized();
+	entries[item]=entry;
+	insertEntry(entry);
+}
+
+void SpatialIndex::remove(QGraphicsItem *item)
+{
+	Node *entry=entries.take(item), *leaf=nullptr, *old_root=nullptr;
+	QVector<Node *> orphans;
+
+	if(!entry)
+		return;
+
+	leaf=entry->parent;
+	leaf->children.removeOne(entry);
+	delete(entry);
+
+	condenseTree(leaf, orphans);
+
+	//All the root's children were removed so it becomes an empty leaf
+	if(!root->leaf && root->children.isEmpty())
+		root->leaf=true;
+
+	for(auto orphan : orphans)
+		insertEntry(orphan);
+
+	//A root with a single child is replaced by that child reducing the tree height
+	while(!root->leaf && root->children.size()==1)
+	{
+		old_root=root;
+		root=root->children.front();
+		root->parent=nullptr;
+		old_root->children.clear();
+		delete(old_root);
+	}
+}
+
+bool SpatialIndex::contains(QGraphicsItem *item) const
+{
+	return(entries.contains(item));
+}
+
+QRectF SpatialIndex::getRect(QGraphicsItem *item) const
+{
+	Node *entry=entries.value(item);
+	return(entry ? entry->rect : QRectF());
+}
+
+QList<QGraphicsItem *> SpatialIndex::intersects(const QRectF &rect) const
+{
+	QList<QGraphicsItem *> items;
+	QVector<Node *> nodes;
+	QRectF query=rect.normalized();
+	Node *node=nullptr;
+
+	nodes.push_back(root);
+
+	while(!nodes.isEmpty())
+	{
+		node=nodes.back();
+		nodes.pop_back();
+
+		for(auto child : node->children)
+		{
+			if(!rectsIntersect(child->rect, query))
+				continue;
+
+			if(child->item)
+				items.push_back(child->item);
+			else
+				nodes.push_back(child);
+		}
+	}
+
+	return(items);
+}
+
+QList<QGraphicsItem *> SpatialIndex::contained(const QRectF &rect) const
+{
+	QList<QGraphicsItem *> items;
+	QVector<Node *> nodes;
+	QRectF query=rect.normalized();
+	Node *node=nullptr;
+
+	nodes.push_back(root);
+
+	while(!nodes.isEmpty())
+	{
+		node=nodes.back();
+		nodes.pop_back();
+
+		for(auto child : node->children)
+		{
+			if(!rectsIntersect(child->rect, query))
+				continue;
+
+			if(!child->item)
+				nodes.push_back(child);
+			else if(query.left() <= child->rect.left() && child->rect.right() <= query.right() &&
+							query.top() <= child->rect.top() && child->rect.bottom() <= query.bottom())
+				items.push_back(child->item);
+		}
+	}
+
+	return(items);
+}
+
+QRectF SpatialIndex::boundingRect(void) const
+{
+	return(root->children.isEmpty() ? QRectF() : root->rect);
+}
+
+int SpatialIndex::count(void) const
+{
+	return(entries.size());
+}
+
+void SpatialIndex::clear(void)
+{
+	destroyNode(root, nullptr);
+	entries.clear();
+	root=new Node;
+}
@@ -0,0 +1,135 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2016 - Raphael Araújo e Silva <raphael@pgmodeler.com.br>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libobjrenderer
+\class SpatialIndex
+\brief Implements an R-tree that indexes items by rectangles (usually their areas in the scene). It's used by ObjectsScene
+to answer the queries about the database objects (range selection, overview rendering, objects' bounding rect) visiting only
+the portions of the tree that intersect the queried area instead of iterating over all the items in the scene.
+The index doesn't own the items nor dereferences them, it only stores the pointers.
+*/
+
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include <QGraphicsItem>
+#include <QHash>
+#include <QVector>
+
+class SpatialIndex {
+	private:
+		/*! \brief Node of the tree. The entries that hold the items are also nodes with no children in order to
+		simplify the splitting and condensing algorithms which handle leaves and internal nodes in the same way */
+		struct Node {
+			//! \brief Parent node (nullptr for the root)
+			Node *parent;
+
+			//! \brief Rect that contains all the children's rects (for item entries this is the item's rect)
+			QRectF rect;
+
+			//! \brief Child nodes (empty for item entries)
+			QVector<Node *> children;
+
+			//! \brief Indexed item (only for item entries)
+			QGraphicsItem *item;
+
+			//! \brief Indicates that the children of the node are item entries
+			bool leaf;
+
+			Node(Node *parent=nullptr, bool leaf=true);
+		};
+
+		//! \brief Root node of the tree
+		Node *root;
+
+		//! \brief Stores the item entries so they can be located without traversing the tree
+		QHash<QGraphicsItem *, Node *> entries;
+
+		//! \brief Returns the area of the rect
+		static double area(const QRectF &rect);
+
+		//! \brief Returns how much the area of the rect grows in order to contain the new rect
+		static double enlargement(const QRectF &rect, const QRectF &new_rect);
+
+		/*! \brief Returns the rect that contains both rects. Unlike QRectF::united(), rects with no width
+		or height (e.g. vertical lines) are considered */
+		static QRectF unite(const QRectF &rect1, const QRectF &rect2);
+
+		//! \brief Returns if the rects intersect. Unlike QRectF::intersects(), touching edges and rects with no width or height are considered
+		static bool rectsIntersect(const QRectF &rect1, const QRectF &rect2);
+
+		//! \brief Recalculates the rect of the node based upon its children
+		static void updateRect(Node *node);
+
+		//! \brief Returns the leaf in which a new entry with the specified rect must be inserted (least enlargement criteria)
+		Node *chooseLeaf(const QRectF &rect);
+
+		//! \brief Inserts the entry in the tree
+		void insertEntry(Node *entry);
+
+		//! \brief Splits the node in two using the quadratic algorithm returning the newly created sibling
+		Node *splitNode(Node *node);
+
+		//! \brief Walks from the node to the root splitting the overflowed nodes and adjusting the rects
+		void adjustTree(Node *node);
+
+		/*! \brief Walks from the node to the root removing the underflowed nodes whose entries are
+		stored on the parameter in order to be inserted again. The rects are adjusted as well */
+		void condenseTree(Node *node, QVector<Node *> &orphans);
+
+		//! \brief Destroys the node and its descendants storing the item entries found on the parameter (when provided)
+		static void destroyNode(Node *node, QVector<Node *> *entries);
+
+	public:
+		//! \brief Maximum and minimum amount of children per node
+		static const int MAX_CHILDREN=16,
+		MIN_CHILDREN=6;
+
+		SpatialIndex(void);
+		~SpatialIndex(void);
+
+		//! \brief Indexes the item with the specified rect. If the item is already indexed its rect is updated
+		void insert(QGraphicsItem *item, const QRectF &rect);
+
+		//! \brief Removes the item from the index
+		void remove(QGraphicsItem *item);
+
+		//! \brief Returns if the item is indexed
+		bool contains(QGraphicsItem *item) const;
+
+		//! \brief Returns the rect in which the item is indexed (an invalid rect is returned if the item is not indexed)
+		QRectF getRect(QGraphicsItem *item) const;
+
+		//! \brief Returns the items whose rects intersect the specified one
+		QList<QGraphicsItem *> intersects(const QRectF &rect) const;
+
+		//! \brief Returns the items whose rects are fully inside the specified one
+		QList<QGraphicsItem *> contained(const QRectF &rect) const;
+
+		//! \brief Returns the rect that contains all the indexed items (an invalid rect is returned if the index is empty)
+		QRectF boundingRect(void) const;
+
+		//! \brief Returns the amount of indexed items
+		int count(void) const;
+
+		//! \brief Removes all the items from the index
+		void clear(void);
+};
+
+#endif
@@ -11,6 +11,7 @@ StyledTextboxView::StyledTextboxView(Textbox *txtbox, bool override_style) : Tex
 	fold=new QGraphicsPolygonItem;
 	this->addToGroup(fold);
 	fold->setPolygon(pol);
+	setItemCacheMode(fold, QGraphicsItem::ItemCoordinateCache);
 
 	this->configureObject();
 }
@@ -51,4 +52,5 @@ void StyledTextboxView::configureObject(void)
 
 	this->configureObjectShadow();
 	this->configureObjectSelection();
+	this->updateItemCache();
 }
@@ -37,6 +37,7 @@ TableObjectView::TableObjectView(TableObject *object) : BaseObjectView(object)
 	{
 		lables[i]=new QGraphicsSimpleTextItem;
 		this->addToGroup(lables[i]);
+		setItemCacheMode(lables[i], QGraphicsItem::DeviceCoordinateCache);
 	}
 }
 
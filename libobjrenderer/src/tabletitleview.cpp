@@ -34,6 +34,10 @@ TableTitleView::TableTitleView(void) : BaseObjectView(nullptr)
 	this->addToGroup(box);
 	this->addToGroup(schema_name);
 	this->addToGroup(obj_name);
+
+	setItemCacheMode(box, QGraphicsItem::DeviceCoordinateCache);
+	setItemCacheMode(schema_name, QGraphicsItem::DeviceCoordinateCache);
+	setItemCacheMode(obj_name, QGraphicsItem::DeviceCoordinateCache);
 }
 
 TableTitleView::~TableTitleView(void)
@@ -40,6 +40,11 @@ void TableView::configureObject(void)
 	QString atribs[]={ ParsersAttributes::TABLE_BODY, ParsersAttributes::TABLE_EXT_BODY };
 	Tag *tag=table->getTag();
 
+	/* At reduced levels of detail or when the table has no item tree only the simplified
+	item is updated. The full item tree is configured when it must be displayed again */
+	if(configureSimplifiedObject())
+		return;
+
 	//Configures the table title
 	title->configureObject(table);
 	px=0;
@@ -237,6 +242,7 @@ void TableView::configureObject(void)
 
 	configureTag();
 	configureSQLDisabledInfo();
+	updateItemCache();
 
 	if((old_width!=0 && this->bounding_rect.width()!=old_width) ||
 			(old_height!=0 && this->bounding_rect.height()!=old_height))
@@ -245,6 +251,28 @@ void TableView::configureObject(void)
 		requestRelationshipsUpdate();
 }
 
+void TableView::estimateDimensions(void)
+{
+	Table *table=dynamic_cast<Table *>(this->getSourceObject());
+	QStringList col_texts, ext_texts;
+	Column *col=nullptr;
+
+	for(auto obj : *table->getObjectList(OBJ_COLUMN))
+	{
+		col=dynamic_cast<Column *>(obj);
+		col_texts.push_back(col->getName() + TableObjectView::TYPE_SEPARATOR + (*col->getType()) +
+												TableObjectView::getConstraintString(col));
+	}
+
+	for(auto type : { OBJ_RULE, OBJ_TRIGGER, OBJ_INDEX })
+	{
+		for(auto obj : *table->getObjectList(type))
+			ext_texts.push_back(obj->getName());
+	}
+
+	setEstimatedDimensions(table->getSchema()->getName() + QString(".") + table->getName(), col_texts, ext_texts);
+}
+
 QPointF TableView::getConnectionPoints(TableObject *tab_obj, unsigned pnt_type)
 {
 	if(!tab_obj)
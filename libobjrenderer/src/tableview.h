@@ -36,6 +36,9 @@ class TableView: public BaseTableView {
 
 		map<TableObject *, vector<QPointF>> conn_points;
 
+	protected:
+		void estimateDimensions(void);
+
 	public:
 		TableView(Table *table);
 		QPointF getConnectionPoints(TableObject *tab_obj, unsigned pnt_type);
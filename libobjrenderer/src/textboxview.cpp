@@ -41,6 +41,12 @@ TextboxView::TextboxView(Textbox *txtbox, bool override_style) : BaseObjectView(
 	this->override_style=override_style;
 	this->addToGroup(text);
 	this->addToGroup(box);
+
+	/* Textboxes and relationship labels are cached in item coordinates. The pixmaps have their
+	sizes adjusted to the zoom (see updateItemCache) so the texts remain sharp */
+	setItemCacheMode(box, QGraphicsItem::ItemCoordinateCache);
+	setItemCacheMode(text, QGraphicsItem::ItemCoordinateCache);
+	setItemCacheMode(obj_shadow, QGraphicsItem::ItemCoordinateCache);
 	this->configureObject();
 }
 
@@ -146,6 +152,7 @@ void TextboxView::configureObject(void)
 	this->__configureObject();
 	this->configureObjectShadow();
 	this->configureObjectSelection();
+	this->updateItemCache();
 }
 
 void TextboxView::configureObjectShadow(void)
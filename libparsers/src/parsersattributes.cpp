@@ -182,6 +182,7 @@ namespace ParsersAttributes {
 	FAST_UPDATE=QString("fast-update"),
 	FILE_ASSOCIATED=QString("file-associated"),
 	FILL_COLOR=QString("fill-color"),
+	FILTER_COLUMNS=QString("filter-columns"),
 	FILTER_OIDS=QString("filter-oids"),
 	FILTER_TABLE_TYPES=QString("filter-tab-types"),
 	FILTER=QString("filter"),
@@ -250,6 +251,7 @@ namespace ParsersAttributes {
 	LAST_SYS_OID=QString("last-sys-oid"),
 	LAST_VALUE=QString("last-value"),
 	LAST_ZOOM=QString("last-zoom"),
+	LAZY_ITEM_TREES=QString("lazy-item-trees"),
 	LEAKPROOF=QString("leakproof"),
 	LEFT_TYPE=QString("left-type"),
 	LEFT=QString("left"),
@@ -263,6 +265,8 @@ namespace ParsersAttributes {
 	LOCALE=QString("locale"),
 	LOCKER_ARC=QString("locker-arc"),
 	LOCKER_BODY=QString("locker-body"),
+	LOD_BOX_ZOOM=QString("lod-box-zoom"),
+	LOD_RECT_ZOOM=QString("lod-rect-zoom"),
 	LOGIN=QString("login"),
 	LOOKAHEAD_CHAR=QString("lookahead-char"),
 	MATERIALIZED=QString("materialized"),
@@ -405,6 +409,7 @@ namespace ParsersAttributes {
 	SHOW_ATTRIBUTES_GRID=QString("show-attributes-grid"),
 	SHOW_SOURCE_PANE=QString("show-source-pane"),
 	SHOW_MAIN_MENU=QString("show-main-menu"),
+	SHOW_FRAME_TIME=QString("show-frame-time"),
 	SIGNATURE=QString("signature"),
 	SIMPLE_EXP=QString("simple-exp"),
 	SIMPLIFIED_OBJ_CREATION=QString("simplified-obj-creation"),
@@ -433,6 +438,7 @@ namespace ParsersAttributes {
 	STORAGE_PARAMS=QString("stg-params"),
 	STORAGE=QString("storage"),
 	STRATEGY_NUM=QString("stg-number"),
+	STREAM_MODEL_LOADING=QString("stream-model-loading"),
 	STYLE=QString("style"),
 	STYLES=QString("styles"),
 	SUBTYPE_DIFF_FUNC=QString("subtypediff"),
@@ -480,6 +486,8 @@ namespace ParsersAttributes {
 	UQ_CONSTR=QString("uq-constr"),
 	UQ_PATTERN=QString("uq-pattern"),
 	USAGE_PRIV=QString("usage"),
+	USE_ITEM_CACHE=QString("use-item-cache"),
+	USE_LEVEL_OF_DETAIL=QString("use-level-of-detail"),
 	USE_PLACEHOLDERS=QString("use-placeholders"),
 	USE_SORTING=QString("use-sorting"),
 	USE_UNIQUE_NAMES=QString("use-unique-names"),
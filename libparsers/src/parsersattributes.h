@@ -197,6 +197,7 @@ namespace ParsersAttributes {
 	FAST_UPDATE,
 	FILE_ASSOCIATED,
 	FILL_COLOR,
+	FILTER_COLUMNS,
 	FILTER_OIDS,
 	FILTER_TABLE_TYPES,
 	FILTER,
@@ -265,6 +266,7 @@ namespace ParsersAttributes {
 	LAST_SYS_OID,
 	LAST_VALUE,
 	LAST_ZOOM,
+	LAZY_ITEM_TREES,
 	LEAKPROOF,
 	LEFT_TYPE,
 	LEFT,
@@ -278,6 +280,8 @@ namespace ParsersAttributes {
 	LOCALE,
 	LOCKER_ARC,
 	LOCKER_BODY,
+	LOD_BOX_ZOOM,
+	LOD_RECT_ZOOM,
 	LOGIN,
 	LOOKAHEAD_CHAR,
 	MATERIALIZED,
@@ -420,6 +424,7 @@ namespace ParsersAttributes {
 	SHOW_ATTRIBUTES_GRID,
 	SHOW_SOURCE_PANE,
 	SHOW_MAIN_MENU,
+	SHOW_FRAME_TIME,
 	SIGNATURE,
 	SIMPLE_EXP,
 	SIMPLIFIED_OBJ_CREATION,
@@ -448,6 +453,7 @@ namespace ParsersAttributes {
 	STORAGE_PARAMS,
 	STORAGE,
 	STRATEGY_NUM,
+	STREAM_MODEL_LOADING,
 	STYLE,
 	STYLES,
 	SUBTYPE_DIFF_FUNC,
@@ -495,6 +501,8 @@ namespace ParsersAttributes {
 	UQ_CONSTR,
 	UQ_PATTERN,
 	USAGE_PRIV,
+	USE_ITEM_CACHE,
+	USE_LEVEL_OF_DETAIL,
 	USE_PLACEHOLDERS,
 	USE_SORTING,
 	USE_UNIQUE_NAMES,
@@ -61,11 +61,16 @@ const QString SchemaParser::TOKEN_LT_EQ_OP=QString("<=");
 
 const QRegExp SchemaParser::ATTR_REGEXP=QRegExp("^([a-z])([a-z]*|(\\d)*|(\\-)*|(_)*)+", Qt::CaseInsensitive);
 
+bool SchemaParser::use_cached_schemas=true;
+map<QString, SchemaParser::CompiledSchema> SchemaParser::cached_schemas;
+QMutex SchemaParser::cache_mutex;
+
 SchemaParser::SchemaParser(void)
 {
 	line=column=comment_count=0;
 	ignore_unk_atribs=ignore_empty_atribs=false;
 	pgsql_version=PgSQLVersions::DEFAULT_VERSION;
+	attr_regexp=ATTR_REGEXP;
 }
 
 void SchemaParser::setPgSQLVersion(const QString &pgsql_ver)
@@ -128,16 +133,14 @@ void SchemaParser::restartParser(void)
 	line=column=comment_count=0;
 }
 
-void SchemaParser::loadBuffer(const QString &buf)
+void SchemaParser::compileBuffer(const QString &buf, QStringList &lines, int &comm_count)
 {
 	QString buf_aux=buf, lin;
 	QTextStream ts(&buf_aux);
 	int pos=0;
 
-	//Prepares the parser to do new reading
-	restartParser();
-
-	filename="[memory buffer]";
+	lines.clear();
+	comm_count=0;
 
 	//While the input file doesn't reach the end
 	while(!ts.atEnd())
@@ -150,7 +153,7 @@ void SchemaParser::loadBuffer(const QString &buf)
 		if(lin.isEmpty()) lin+=CHR_LINE_END;
 
 		//If the entire line is commented out increases the comment lines counter
-		if(lin[0]==CHR_COMMENT) comment_count++;
+		if(lin[0]==CHR_COMMENT) comm_count++;
 
 		//Looking for the position of other comment characters for deletion
 		pos=lin.indexOf(CHR_COMMENT);
@@ -166,15 +169,41 @@ void SchemaParser::loadBuffer(const QString &buf)
 				lin+=CHR_LINE_END;
 
 			//Add the treated line in the buffer
-			buffer.push_back(lin);
+			lines.push_back(lin);
 		}
 	}
 }
 
+void SchemaParser::loadBuffer(const QString &buf)
+{
+	//Prepares the parser to do new reading
+	restartParser();
+
+	filename="[memory buffer]";
+	compileBuffer(buf, buffer, comment_count);
+}
+
 void SchemaParser::loadFile(const QString &filename)
 {
 	if(!filename.isEmpty())
 	{
+		if(use_cached_schemas)
+		{
+			QMutexLocker locker(&cache_mutex);
+			auto itr=cached_schemas.find(filename);
+
+			/* If the file was already precompiled reuses its buffer (the QStringList is implicitly shared
+			so no copy of the lines is made here) */
+			if(itr!=cached_schemas.end())
+			{
+				restartParser();
+				buffer=itr->second.buffer;
+				comment_count=itr->second.comment_count;
+				SchemaParser::filename=filename;
+				return;
+			}
+		}
+
 		QFile input;
 		QString buf;
 
@@ -192,9 +221,36 @@ void SchemaParser::loadFile(const QString &filename)
 		//Loads the parser buffer
 		loadBuffer(buf);
 		SchemaParser::filename=filename;
+
+		if(use_cached_schemas)
+		{
+			QMutexLocker locker(&cache_mutex);
+			cached_schemas[filename]={ buffer, comment_count };
+		}
 	}
 }
 
+void SchemaParser::enableCachedSchemas(bool value)
+{
+	QMutexLocker locker(&cache_mutex);
+
+	use_cached_schemas=value;
+
+	if(!use_cached_schemas)
+		cached_schemas.clear();
+}
+
+bool SchemaParser::isCachedSchemasEnabled(void)
+{
+	return(use_cached_schemas);
+}
+
+void SchemaParser::clearCachedSchemas(void)
+{
+	QMutexLocker locker(&cache_mutex);
+	cached_schemas.clear();
+}
+
 QString SchemaParser::getAttribute(void)
 {
 	QString atrib, current_line;
@@ -245,7 +301,7 @@ QString SchemaParser::getAttribute(void)
 						.arg(filename).arg((line + comment_count + 1)).arg((column+1)),
 						ERR_INV_SYNTAX,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 	}
-	else if(!ATTR_REGEXP.exactMatch(atrib))
+	else if(!attr_regexp.exactMatch(atrib))
 	{
 		throw Exception(QString(Exception::getErrorMessage(ERR_INV_ATTRIBUTE))
 						.arg(atrib).arg(filename).arg((line + comment_count + 1)).arg((column+1)),
@@ -619,7 +675,7 @@ void SchemaParser::defineAttribute(void)
 		attrib=(use_val_as_name ? attributes[new_attrib] : new_attrib);
 
 		//Checking if the attribute has a valid name
-		if(!ATTR_REGEXP.exactMatch(attrib))
+		if(!attr_regexp.exactMatch(attrib))
 		{
 			throw Exception(QString(Exception::getErrorMessage(ERR_INV_ATTRIBUTE))
 							.arg(attrib).arg(filename).arg((line + comment_count + 1)).arg((column+1)),
@@ -665,7 +721,7 @@ void SchemaParser::unsetAttribute(void)
 										.arg(attrib).arg(filename).arg((line + comment_count +1)).arg((column+1)),
 										ERR_UNK_ATTRIBUTE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 					}
-					else if(!ATTR_REGEXP.exactMatch(attrib))
+					else if(!attr_regexp.exactMatch(attrib))
 					{
 						throw Exception(QString(Exception::getErrorMessage(ERR_INV_ATTRIBUTE))
 										.arg(attrib).arg(filename).arg((line + comment_count + 1)).arg((column+1)),
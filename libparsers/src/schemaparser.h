@@ -31,6 +31,7 @@
 #include <vector>
 #include <QDir>
 #include <QTextStream>
+#include <QMutex>
 #include "xmlparser.h"
 #include "attribsmap.h"
 #include "pgsqlversions.h"
@@ -93,6 +94,10 @@ class SchemaParser {
 		//! \brief RegExp used to validate attribute names
 		static const QRegExp ATTR_REGEXP;
 
+		/*! \brief Per instance copy of ATTR_REGEXP. QRegExp stores the matching state internally so
+		sharing the static instance among parsers running in different threads is not safe */
+		QRegExp attr_regexp;
+
 		//! \brief Get an attribute name from the buffer on the current position
 		QString getAttribute(void);
 
@@ -185,6 +190,29 @@ class SchemaParser {
 		//! \brief PostgreSQL version currently used by the parser
 		QString pgsql_version;
 
+		/*! \brief Stores a schema file in its precompiled form: the lines of the file already split,
+		without comments and terminated by line breaks, as well the amount of comment lines removed.
+		This is exactly the state left by loadBuffer() so the interpreter can run over it directly */
+		struct CompiledSchema {
+			QStringList buffer;
+			int comment_count;
+		};
+
+		//! \brief Indicates if the schema files must be precompiled and cached in memory after being read the first time
+		static bool use_cached_schemas;
+
+		/*! \brief Process-wide cache of precompiled schema files (only when use_cached_schemas=true).
+		The key is the absolute path to the schema file. The PostgreSQL version is not part of the key since
+		the version-specific parts of the schema files are resolved at expansion time via the {pgsql-ver} attribute */
+		static map<QString, CompiledSchema> cached_schemas;
+
+		//! \brief Serializes the access to the cached schemas since they are shared by all parser instances
+		static QMutex cache_mutex;
+
+		/*! \brief Splits the provided buffer into lines removing the comments. The resulting lines are
+		stored in 'lines' and the amount of full commented lines in 'comm_count' */
+		static void compileBuffer(const QString &buf, QStringList &lines, int &comm_count);
+
 	public:
 		//! \brief Constants used to get a specific object definition
 		static const unsigned SQL_DEFINITION=0,
@@ -234,6 +262,16 @@ class SchemaParser {
 		//! \brief Extracts the attributes names from the currently loaded buffer
 		QStringList extractAttributes(void);
 
+		/*! \brief Enable/disable the use of cached schema files. When enabled, the schema files are read and precompiled only
+		once and the subsequent loadFile() calls for the same file reuse the precompiled buffer instead of reading the disk again */
+		static void enableCachedSchemas(bool value);
+
+		//! \brief Returns the current status of cached schema files
+		static bool isCachedSchemasEnabled(void);
+
+		//! \brief Removes all the precompiled schema files from the cache forcing them to be read again from disk
+		static void clearCachedSchemas(void);
+
 		/*! \brief Converts any chars (operators) < > " to the respective XML entities. This method is only
 	called when generating XML code and only tag attributes are treated.*/
 		static QString convertCharsToXMLEntities(QString buf);
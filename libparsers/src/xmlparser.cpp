@@ -30,6 +30,10 @@ XMLParser::XMLParser(void)
 	root_elem=nullptr;
 	curr_elem=nullptr;
 	xml_doc=nullptr;
+	xml_reader=nullptr;
+	stream_elem=nullptr;
+	stream_size=0;
+	stream_validation=false;
 	xmlInitParser();
 }
 
@@ -147,11 +151,35 @@ void XMLParser::setDTDFile(const QString &dtd_file, const QString &dtd_name)
 			 fmt_dtd_file + QString("\">\n");
 }
 
+void XMLParser::raiseParserError(void)
+{
+	QString msg, file;
+	xmlError *xml_error=xmlGetLastError();
+	int line=0, column=0;
+
+	if(xml_error)
+	{
+		//Formats the error
+		msg=xml_error->message;
+		file=xml_error->file;
+		line=xml_error->line;
+		column=xml_error->int2;
+		if(!file.isEmpty()) file=QString("(%1)").arg(file);
+		msg.replace("\n"," ");
+	}
+
+	//Restarts the parser
+	restartParser();
+
+	//Raise an exception with the error massege from the parser xml
+	throw Exception(QString(Exception::getErrorMessage(ERR_LIBXMLERR))
+					.arg(line).arg(column).arg(msg).arg(file),
+					ERR_LIBXMLERR,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+}
+
 void XMLParser::readBuffer(void)
 {
 	QByteArray buffer;
-	QString msg, file;
-	xmlError *xml_error=nullptr;
 	int parser_opt;
 
 	if(!xml_buffer.isEmpty())
@@ -177,30 +205,177 @@ void XMLParser::readBuffer(void)
 		//Create an xml document from the buffer
 		xml_doc=xmlReadMemory(buffer.data(), buffer.size(),	nullptr, nullptr, parser_opt);
 
-		//In case the document criation fails, gets the last xml parser error
-		xml_error=xmlGetLastError();
+		//In case the document criation fails raises the last xml parser error
+		if(xmlGetLastError())
+			raiseParserError();
+
+		//Gets the referênce to the root element on the document
+		root_elem=curr_elem=xmlDocGetRootElement(xml_doc);
+	}
+}
+
+int XMLParser::readStreamData(void *parser, char *buffer, int len)
+{
+	XMLParser *xmlparser=reinterpret_cast<XMLParser *>(parser);
+	int count=0;
+
+	//Delivers the declarations and the beginning of the file before reading the rest of it
+	if(!xmlparser->stream_head.isEmpty())
+	{
+		count=(len < xmlparser->stream_head.size() ? len : xmlparser->stream_head.size());
+		memcpy(buffer, xmlparser->stream_head.constData(), count);
+		xmlparser->stream_head.remove(0, count);
+		return(count);
+	}
+
+	return(xmlparser->stream_file.read(buffer, len));
+}
+
+void XMLParser::openXMLStream(const QString &filename, bool validate)
+{
+	try
+	{
+		QByteArray head, line;
+		QString head_str;
+		int pos1=-1, pos2=-1, parser_opt=( XML_PARSE_NOBLANKS | XML_PARSE_NONET | XML_PARSE_NOENT ), ret=0;
+
+		if(filename.isEmpty())
+			return;
+
+		//Closes any previous document but keeps the configured dtd
+		head_str=dtd_decl;
+		restartParser();
+		dtd_decl=head_str;
 
-		//If some error is set
-		if(xml_error)
+		stream_file.setFileName(filename);
+		stream_file.open(QFile::ReadOnly);
+
+		//Case the file opening was not sucessful
+		if(!stream_file.isOpen())
 		{
-			//Formats the error
-			msg=xml_error->message;
-			file=xml_error->file;
-			if(!file.isEmpty()) file=QString("(%1)").arg(file);
-			msg.replace("\n"," ");
-
-			//Restarts the parser
-			if(xml_doc) restartParser();
-
-			//Raise an exception with the error massege from the parser xml
-			throw Exception(QString(Exception::getErrorMessage(ERR_LIBXMLERR))
-							.arg(xml_error->line).arg(xml_error->int2).arg(msg).arg(file),
-							ERR_LIBXMLERR,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+			throw Exception(QString(Exception::getErrorMessage(ERR_FILE_DIR_NOT_ACCESSED)).arg(filename),
+							ERR_FILE_DIR_NOT_ACCESSED,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 		}
 
-		//Gets the referênce to the root element on the document
-		root_elem=curr_elem=xmlDocGetRootElement(xml_doc);
+		/* Reads the file until the opening of the root element in order to remove the original
+		xml and dtd declarations the same way is done by loadXMLBuffer() and removeDTD() */
+		while(!stream_file.atEnd() && head.size() < STREAM_HEAD_SIZE &&
+					QString(line).indexOf(QRegExp(QString("<[A-Za-z_]"))) < 0)
+		{
+			line=stream_file.readLine();
+			head+=line;
+		}
+
+		head_str=QString::fromUtf8(head);
+		pos1=head_str.indexOf(QLatin1String("<?xml"));
+		pos2=head_str.indexOf(QLatin1String("?>"));
+
+		if(pos1 >= 0 && pos2 >= 0)
+		{
+			xml_decl=head_str.mid(pos1, (pos2-pos1)+3);
+			head_str.replace(pos1, (pos2-pos1)+3, QString());
+		}
+		else
+			xml_decl=QString("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+
+		xml_buffer=head_str;
+		removeDTD();
+
+		stream_validation=(validate && !dtd_decl.isEmpty());
+
+		if(stream_validation)
+			parser_opt=(parser_opt | XML_PARSE_DTDLOAD | XML_PARSE_DTDVALID);
+
+		stream_head=(xml_decl + (stream_validation ? dtd_decl : QString()) + xml_buffer).toUtf8();
+		stream_size=stream_head.size() + (stream_file.size() - stream_file.pos());
+		xml_buffer.clear();
+
+		xml_reader=xmlReaderForIO(&XMLParser::readStreamData, nullptr, this, nullptr, nullptr, parser_opt);
+
+		if(!xml_reader)
+			raiseParserError();
+
+		//Advances the reader until the root element
+		do
+		{
+			ret=xmlTextReaderRead(xml_reader);
+		}
+		while(ret==1 && xmlTextReaderNodeType(xml_reader)!=XML_READER_TYPE_ELEMENT);
+
+		if(ret!=1 || (stream_validation && xmlTextReaderIsValid(xml_reader)!=1))
+			raiseParserError();
+
+		/* The document is owned by the reader and only the nodes that are currently
+		being read are kept on it, so the root element has only its attributes available */
+		root_elem=curr_elem=xmlTextReaderCurrentNode(xml_reader);
+		xml_doc=root_elem->doc;
+		xml_doc_filename=filename;
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorType(), __PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+bool XMLParser::readNextStreamElement(void)
+{
+	int ret=1;
+
+	if(!xml_reader)
+		throw Exception(ERR_OPR_NOT_ALOC_ELEM_TREE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	//The root element is empty or was already completely read
+	if(!root_elem || (!stream_elem && xmlTextReaderIsEmptyElement(xml_reader)==1))
+		return(false);
+
+	do
+	{
+		/* Skips the subtree of the previous element (releasing its nodes)
+		or steps into the contents of the root element */
+		if(stream_elem)
+		{
+			ret=xmlTextReaderNext(xml_reader);
+			stream_elem=nullptr;
+		}
+		else
+			ret=xmlTextReaderRead(xml_reader);
+
+		if(ret < 0 || (stream_validation && xmlTextReaderIsValid(xml_reader)!=1))
+			raiseParserError();
+
+		//Reached the end of the root element
+		if(ret==0 || xmlTextReaderDepth(xml_reader) < 1)
+			return(false);
 	}
+	while(xmlTextReaderNodeType(xml_reader)!=XML_READER_TYPE_ELEMENT || xmlTextReaderDepth(xml_reader)!=1);
+
+	//Loads the complete subtree of the element
+	stream_elem=xmlTextReaderExpand(xml_reader);
+
+	if(!stream_elem || (stream_validation && xmlTextReaderIsValid(xml_reader)!=1))
+		raiseParserError();
+
+	while(!elems_stack.empty())
+		elems_stack.pop();
+
+	curr_elem=stream_elem;
+	return(true);
+}
+
+int XMLParser::getStreamProgress(void)
+{
+	long consumed=0;
+
+	if(!xml_reader || stream_size <= 0)
+		return(0);
+
+	consumed=xmlTextReaderByteConsumed(xml_reader);
+	return(consumed >= stream_size ? 100 : static_cast<int>((consumed/static_cast<float>(stream_size)) * 100));
+}
+
+bool XMLParser::isStreamOpened(void)
+{
+	return(xml_reader!=nullptr);
 }
 
 void XMLParser::savePosition(void)
@@ -251,11 +426,26 @@ void XMLParser::restartParser(void)
 {
 	root_elem=curr_elem=nullptr;
 
-	if(xml_doc)
+	//In stream mode the document is owned by the reader
+	if(xml_reader)
+	{
+		xmlFreeTextReader(xml_reader);
+		xml_reader=nullptr;
+		xml_doc=nullptr;
+	}
+	else if(xml_doc)
 	{
 		xmlFreeDoc(xml_doc);
 		xml_doc=nullptr;
 	}
+
+	if(stream_file.isOpen())
+		stream_file.close();
+
+	stream_elem=nullptr;
+	stream_head.clear();
+	stream_size=0;
+	stream_validation=false;
 	dtd_decl=xml_buffer=xml_decl=QString();
 
 	while(!elems_stack.empty())
@@ -408,7 +598,8 @@ int XMLParser::getCurrentBufferLine(void)
 
 int XMLParser::getBufferLineCount(void)
 {
-	if(xml_doc)
+	//The complete document is not available when reading a stream
+	if(xml_doc && !xml_reader)
 		/* To get the very last line of the document is necessary to call
 		the last element of the last because xml_doc->last->line stores the
 		last line of the root element */
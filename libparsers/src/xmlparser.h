@@ -28,6 +28,7 @@
 
 #include <libxml/parser.h>
 #include <libxml/tree.h>
+#include <libxml/xmlreader.h>
 #include "schemaparser.h"
 #include "exception.h"
 #include <stack>
@@ -62,6 +63,34 @@ class XMLParser {
 										 a default declaration. */
 		xml_decl;
 
+		//! \brief Reader used to parse a file as a stream of elements (see openXMLStream())
+		xmlTextReader *xml_reader;
+
+		//! \brief Stores the last element expanded by the stream reader
+		xmlNode *stream_elem;
+
+		//! \brief File being read by the stream reader
+		QFile stream_file;
+
+		/*! \brief Stores the data that must be delivered to the stream reader before the file contents:
+		the xml and dtd declarations and the beginning of the file without the original declarations */
+		QByteArray stream_head;
+
+		//! \brief Total amount of bytes that will be delivered to the stream reader
+		qint64 stream_size;
+
+		//! \brief Indicates if the stream reader is validating the document against the DTD
+		bool stream_validation;
+
+		//! \brief Size of the file chunk inspected in order to replace the xml/dtd declarations when reading a stream
+		static const int STREAM_HEAD_SIZE=4096;
+
+		//! \brief Delivers the data to the stream reader. This method is used as a libxml2 input callback
+		static int readStreamData(void *parser, char *buffer, int len);
+
+		//! \brief Raises an exception containing the last error raised by libxml2
+		void raiseParserError(void);
+
 		/*! \brief Remove the original DTD from the document. This is done to evit that
 		 the user insert some external dtd in the model file that is not valid for pgModeler */
 		void removeDTD(void);
@@ -94,6 +123,22 @@ class XMLParser {
 		//! \brief Loads the XML buffer from a string
 		void loadXMLBuffer(const QString &xml_buf);
 
+		/*! \brief Opens the file to be read as a stream. Differently from loadXMLFile() neither the file contents nor the complete
+		element tree are kept in memory: the navigation is restricted to the root element (which has only its attributes available)
+		and to the subtree of the element returned by readNextStreamElement(). The subtrees already read are released by the parser.
+		When the validation is enabled the document is validated against the DTD configured via setDTDFile() as it is being read */
+		void openXMLStream(const QString &filename, bool validate);
+
+		/*! \brief Reads the next child element of the root when the parser is in stream mode. The whole subtree of the
+		element is loaded and becomes the current element. Returns false when there are no more elements to be read */
+		bool readNextStreamElement(void);
+
+		//! \brief Returns the percentage of the stream already read by the parser
+		int getStreamProgress(void);
+
+		//! \brief Returns if the parser is reading a file as a stream
+		bool isStreamOpened(void);
+
 		//! \brief Informs the DTD file used to make element validations
 		void setDTDFile(const QString &dtd_file, const QString &dtd_name);
 
@@ -15,11 +15,15 @@ windows: DESTDIR = $$PWD
 
 HEADERS += src/resultset.h \
 	   src/connection.h \
-	   src/catalog.h
+	   src/catalog.h \
+	   src/queryexecutor.h \
+	   src/connectionpool.h
 
 SOURCES += src/resultset.cpp \
 	   src/connection.cpp \
-	   src/catalog.cpp
+	   src/catalog.cpp \
+	   src/queryexecutor.cpp \
+	   src/connectionpool.cpp
 
 unix|windows: LIBS += $$PGSQL_LIB\
                     -L$$OUT_PWD/../libpgmodeler/ -lpgmodeler \
@@ -28,6 +28,11 @@ const QString Catalog::GET_EXT_OBJS_SQL=QString("SELECT objid AS oid FROM pg_dep
 
 bool Catalog::use_cached_queries=false;
 attribs_map Catalog::catalog_queries;
+map<QString, Catalog::CatalogQuery> Catalog::expanded_queries;
+QMutex Catalog::catalog_queries_mtx;
+
+const QStringList Catalog::PARAM_ATTRIBS={ ParsersAttributes::SCHEMA, ParsersAttributes::TABLE,
+																					 ParsersAttributes::FILTER_OIDS, ParsersAttributes::EXT_OBJ_OIDS };
 
 map<ObjectType, QString> Catalog::oid_fields=
 { {OBJ_DATABASE, "oid"}, {OBJ_ROLE, "oid"}, {OBJ_SCHEMA,"oid"},
@@ -50,12 +55,13 @@ map<ObjectType, QString> Catalog::ext_oid_fields={
 
 Catalog::Catalog(void)
 {
-	last_sys_oid=0;
+	last_sys_oid=query_count=0;
 	setFilter(EXCL_EXTENSION_OBJS | EXCL_SYSTEM_OBJS);
 }
 
 Catalog::Catalog(const Catalog &catalog)
 {
+	query_count=0;
 	(*this)=catalog;
 }
 
@@ -67,6 +73,7 @@ void Catalog::setConnection(Connection &conn)
 		QStringList ext_obj;
 
 		connection.close();
+		prepared_stmts.clear();
 		connection.setConnectionParams(conn.getConnectionParams());
 		connection.connect();
 
@@ -80,15 +87,16 @@ void Catalog::setConnection(Connection &conn)
 			last_sys_oid=attribs[ParsersAttributes::LAST_SYS_OID].toUInt();
 		}
 
-		//Retrieving the list of objects created by extensions
-		this->connection.executeDMLCommand(GET_EXT_OBJS_SQL, res);
-		if(res.accessTuple(ResultSet::FIRST_TUPLE))
+		/* Retrieving the list of objects created by extensions. The oids are fetched in binary format
+		and read by index avoiding the text conversion of each value on the server */
+		this->connection.executeDMLCommand(GET_EXT_OBJS_SQL, res, true);
+		query_count++;
+		if(!res.isEmpty())
 		{
-			do
-			{
-				ext_obj.push_back(res.getColumnValue(QString("oid")));
-			}
-			while(res.accessTuple(ResultSet::NEXT_TUPLE));
+			int oid_col=res.getColumnIndex(QString("oid"));
+
+			for(int tup=0; tup < res.getTupleCount(); tup++)
+				ext_obj.push_back(QString::number(res.getOid(tup, oid_col)));
 
 			ext_obj_oids=ext_obj.join(',');
 		}
@@ -102,6 +110,7 @@ void Catalog::setConnection(Connection &conn)
 void Catalog::closeConnection(void)
 {
 	connection.close();
+	prepared_stmts.clear();
 }
 
 void Catalog::setFilter(unsigned filter)
@@ -138,6 +147,8 @@ bool Catalog::isExtensionObject(unsigned oid)
 
 void Catalog::loadCatalogQuery(const QString &qry_id)
 {
+	QMutexLocker locker(&catalog_queries_mtx);
+
 	if((!use_cached_queries) ||
 			(use_cached_queries && catalog_queries.count(qry_id)==0))
 	{
@@ -159,7 +170,20 @@ void Catalog::loadCatalogQuery(const QString &qry_id)
 
 QString Catalog::getCatalogQuery(const QString &qry_type, ObjectType obj_type, bool single_result, attribs_map attribs)
 {
-	QString sql, custom_filter;
+	attribs_map param_values;
+	QString query_key;
+	CatalogQuery query=getExpandedQuery(qry_type, obj_type, single_result, attribs, param_values, query_key);
+
+	return(getLiteralQuery(query, param_values));
+}
+
+Catalog::CatalogQuery Catalog::getExpandedQuery(const QString &qry_type, ObjectType obj_type, bool single_result, attribs_map attribs,
+																								attribs_map &param_values, QString &query_key)
+{
+	CatalogQuery query;
+	QString custom_filter, marker, ext_oids;
+	QRegExp in_list_regexp, not_in_list_regexp;
+	int param_idx=0;
 
 	schparser.setPgSQLVersion(connection.getPgSQLVersion(true));
 	attribs[qry_type]=ParsersAttributes::_TRUE_;
@@ -182,35 +206,130 @@ QString Catalog::getCatalogQuery(const QString &qry_type, ObjectType obj_type, b
 		attribs.erase(ParsersAttributes::CUSTOM_FILTER);
 	}
 
+	param_values.clear();
+
 	if(exclude_ext_objs && obj_type!=OBJ_DATABASE &&	obj_type!=OBJ_ROLE && obj_type!=OBJ_TABLESPACE && obj_type!=OBJ_EXTENSION)
 	{
+		/* The extension objects' oids are replaced by a marker as the parameterizable attributes
+		so the expanded query (and its cache key) doesn't depend on the database being queried */
+		if(!ext_obj_oids.isEmpty())
+		{
+			param_values[ParsersAttributes::EXT_OBJ_OIDS]=ext_obj_oids;
+			ext_oids=QString("__pgmodeler_param_%1__").arg(PARAM_ATTRIBS.indexOf(ParsersAttributes::EXT_OBJ_OIDS));
+		}
+
 		if(ext_oid_fields.count(obj_type)==0)
-			attribs[ParsersAttributes::NOT_EXT_OBJECT]=getNotExtObjectQuery(oid_fields[obj_type]);
+			attribs[ParsersAttributes::NOT_EXT_OBJECT]=getNotExtObjectQuery(oid_fields[obj_type], ext_oids);
 		else
-			attribs[ParsersAttributes::NOT_EXT_OBJECT]=getNotExtObjectQuery(ext_oid_fields[obj_type]);
+			attribs[ParsersAttributes::NOT_EXT_OBJECT]=getNotExtObjectQuery(ext_oid_fields[obj_type], ext_oids);
+	}
+
+	attribs[ParsersAttributes::PGSQL_VERSION]=schparser.getPgSQLVersion();
+
+	/* Replacing the values of the parameterizable attributes by markers so the expanded query
+	is the same for any value they assume. Empty attributes are kept since they change the query structure */
+	for(auto &attr : PARAM_ATTRIBS)
+	{
+		if(!attribs[attr].isEmpty())
+		{
+			param_values[attr]=attribs[attr];
+			attribs[attr]=QString("__pgmodeler_param_%1__").arg(PARAM_ATTRIBS.indexOf(attr));
+		}
+	}
+
+	/* Queries with custom filters and multiple tables columns filters are not cached since their filters
+	are rarely repeated and would only increase the cache */
+	query_key.clear();
+	if(use_cached_queries && custom_filter.isEmpty() && attribs.count(ParsersAttributes::FILTER_COLUMNS)==0)
+	{
+		query_key=QString("%1:%2:%3").arg(qry_type).arg(BaseObject::getSchemaName(obj_type)).arg(single_result);
+
+		for(auto &attr : attribs)
+			query_key+=QString("\n%1=%2").arg(attr.first).arg(attr.second);
+
+		QMutexLocker locker(&catalog_queries_mtx);
+		if(expanded_queries.count(query_key))
+			return(expanded_queries[query_key]);
 	}
 
 	loadCatalogQuery(BaseObject::getSchemaName(obj_type));
 	schparser.ignoreUnkownAttributes(true);
 	schparser.ignoreEmptyAttributes(true);
-
-	attribs[ParsersAttributes::PGSQL_VERSION]=schparser.getPgSQLVersion();
-	sql=schparser.getCodeDefinition(attribs).simplified();
+	query.sql=schparser.getCodeDefinition(attribs).simplified();
 
 	//Appeding the custom filter to the whole catalog query
 	if(!custom_filter.isEmpty())
 	{
-		if(!sql.contains(QString("WHERE"), Qt::CaseInsensitive))
-			sql+=QString(" WHERE ");
+		if(!query.sql.contains(QString("WHERE"), Qt::CaseInsensitive))
+			query.sql+=QString(" WHERE ");
 		else
-			sql+=QString(" AND (%1)").arg(custom_filter);
+			query.sql+=QString(" AND (%1)").arg(custom_filter);
 	}
 
 	//Append a LIMIT clause when the single_result is set
 	if(single_result)
 	{
-		if(sql.endsWith(';'))	sql.remove(sql.size()-1, 1);
-		sql+=QString(" LIMIT 1");
+		if(query.sql.endsWith(';'))	query.sql.remove(query.sql.size()-1, 1);
+		query.sql+=QString(" LIMIT 1");
+	}
+
+	/* Replacing the markers by placeholders. String values (e.g. '{schema}') become a single placeholder
+	and oid lists (e.g. IN ({filter-oids}) or NOT IN ({ext-obj-oids})) are passed as arrays. If a marker is used
+	in any other way the query is not prepared and is executed with the values written in it */
+	query.prepared_sql=query.sql;
+	for(auto &attr : PARAM_ATTRIBS)
+	{
+		if(param_values.count(attr)==0)
+			continue;
+
+		marker=QString("__pgmodeler_param_%1__").arg(PARAM_ATTRIBS.indexOf(attr));
+		in_list_regexp=QRegExp(QString("IN\\s*\\(\\s*%1\\s*\\)").arg(marker), Qt::CaseInsensitive);
+		not_in_list_regexp=QRegExp(QString("NOT\\s+IN\\s*\\(\\s*%1\\s*\\)").arg(marker), Qt::CaseInsensitive);
+
+		if(query.prepared_sql.contains(QString("'%1'").arg(marker)) || query.prepared_sql.contains(in_list_regexp))
+		{
+			param_idx++;
+			query.param_attribs.push_back(attr);
+			query.prepared_sql.replace(QString("'%1'").arg(marker), QString("$%1").arg(param_idx));
+			query.prepared_sql.replace(not_in_list_regexp, QString("<> ALL($%1)").arg(param_idx));
+			query.prepared_sql.replace(in_list_regexp, QString("= ANY($%1)").arg(param_idx));
+		}
+
+		if(query.prepared_sql.contains(marker))
+		{
+			query.prepared_sql.clear();
+			query.param_attribs.clear();
+			break;
+		}
+	}
+
+	if(!query_key.isEmpty())
+	{
+		QMutexLocker locker(&catalog_queries_mtx);
+
+		//Keeping the cache bounded since the filters combinations may vary a lot in long running sessions
+		if(expanded_queries.size() >= MAX_EXPANDED_QUERIES)
+			expanded_queries.clear();
+
+		expanded_queries[query_key]=query;
+	}
+
+	return(query);
+}
+
+QString Catalog::getLiteralQuery(const CatalogQuery &query, const attribs_map &param_values)
+{
+	QString sql=query.sql, value;
+
+	for(auto &param : param_values)
+	{
+		value=param.second;
+
+		//String values are written between quotes in the catalog queries so the quotes in the value must be escaped
+		if(param.first!=ParsersAttributes::FILTER_OIDS && param.first!=ParsersAttributes::EXT_OBJ_OIDS)
+			value.replace(QChar('\''), QString("''"));
+
+		sql.replace(QString("__pgmodeler_param_%1__").arg(PARAM_ATTRIBS.indexOf(param.first)), value);
 	}
 
 	return(sql);
@@ -220,7 +339,39 @@ void Catalog::executeCatalogQuery(const QString &qry_type, ObjectType obj_type,
 {
 	try
 	{
-		connection.executeDMLCommand(getCatalogQuery(qry_type, obj_type, single_result, attribs), result);
+		attribs_map param_values;
+		QStringList params;
+		QString query_key;
+		CatalogQuery query=getExpandedQuery(qry_type, obj_type, single_result, attribs, param_values, query_key);
+
+		//Queries that aren't cached or can't be prepared are executed with the values written in them
+		if(query_key.isEmpty() || query.prepared_sql.isEmpty())
+			connection.executeDMLCommand(getLiteralQuery(query, param_values), result);
+		else
+		{
+			//Preparing the query in the first time it is used in the current connection
+			if(prepared_stmts.count(query_key)==0)
+			{
+				QString stmt_name=QString("pgmodeler_catalog_%1").arg(prepared_stmts.size());
+
+				connection.prepareCommand(stmt_name, query.prepared_sql);
+				prepared_stmts[query_key]=stmt_name;
+				query_count++;
+			}
+
+			//Oids lists are passed as arrays
+			for(auto &attr : query.param_attribs)
+			{
+				if(attr==ParsersAttributes::FILTER_OIDS || attr==ParsersAttributes::EXT_OBJ_OIDS)
+					params.push_back(QString("{%1}").arg(param_values[attr]));
+				else
+					params.push_back(param_values[attr]);
+			}
+
+			connection.executePreparedCommand(prepared_stmts[query_key], params, result);
+		}
+
+		query_count++;
 	}
 	catch(Exception &e)
 	{
@@ -248,6 +399,64 @@ unsigned Catalog::getObjectCount(ObjectType obj_type, const QString &sch_name, c
 	}
 }
 
+QString Catalog::exportSnapshot(void)
+{
+	ResultSet res;
+
+	try
+	{
+		connection.executeDDLCommand(QString("START TRANSACTION ISOLATION LEVEL REPEATABLE READ"));
+		connection.executeDMLCommand(QString("SELECT pg_export_snapshot() AS snapshot"), res);
+		query_count+=2;
+
+		if(res.accessTuple(ResultSet::FIRST_TUPLE))
+			return(res.getColumnValue(QString("snapshot")));
+	}
+	catch(Exception &)
+	{
+		//The server doesn't support snapshot exporting, the transaction is aborted
+	}
+
+	try
+	{
+		connection.executeDDLCommand(QString("ROLLBACK"));
+		query_count++;
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+
+	return(QString());
+}
+
+void Catalog::importSnapshot(const QString &snapshot_id)
+{
+	try
+	{
+		connection.executeDDLCommand(QString("START TRANSACTION ISOLATION LEVEL REPEATABLE READ"));
+		connection.executeDDLCommand(QString("SET TRANSACTION SNAPSHOT '%1'").arg(snapshot_id));
+		query_count+=2;
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void Catalog::finishSnapshot(void)
+{
+	try
+	{
+		connection.executeDDLCommand(QString("COMMIT"));
+		query_count++;
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
 unsigned Catalog::getFilter(void)
 {
 	return(filter);
@@ -306,13 +515,13 @@ attribs_map Catalog::getObjectsNames(ObjectType obj_type, const QString &sch_nam
 		extra_attribs[ParsersAttributes::TABLE]=tab_name;
 		executeCatalogQuery(QUERY_LIST, obj_type, res, false, extra_attribs);
 
-		if(res.accessTuple(ResultSet::FIRST_TUPLE))
+		if(!res.isEmpty())
 		{
-			do
-			{
-				objects[res.getColumnValue(ParsersAttributes::OID)]=res.getColumnValue(ParsersAttributes::NAME);
-			}
-			while(res.accessTuple(ResultSet::NEXT_TUPLE));
+			int oid_col=res.getColumnIndex(ParsersAttributes::OID),
+					name_col=res.getColumnIndex(ParsersAttributes::NAME);
+
+			for(int tup=0; tup < res.getTupleCount(); tup++)
+				objects[res.getColumnValue(tup, oid_col)]=res.getColumnValue(tup, name_col);
 		}
 
 		return(objects);
@@ -362,18 +571,24 @@ vector<attribs_map> Catalog::getObjectsNames(vector<ObjectType> obj_types, const
 			sql += QString(" ORDER BY oid, object_type");
 
 		connection.executeDMLCommand(sql, res);
+		query_count++;
 
-		if(res.accessTuple(ResultSet::FIRST_TUPLE))
+		if(!res.isEmpty())
 		{
-			do
+			int oid_col=res.getColumnIndex(ParsersAttributes::OID),
+					name_col=res.getColumnIndex(ParsersAttributes::NAME),
+					type_col=res.getColumnIndex(QString("object_type"));
+
+			objects.reserve(res.getTupleCount());
+
+			for(int tup=0; tup < res.getTupleCount(); tup++)
 			{
-				attribs[ParsersAttributes::OID]=res.getColumnValue(ParsersAttributes::OID);
-				attribs[ParsersAttributes::NAME]=res.getColumnValue(ParsersAttributes::NAME);
-				attribs[ParsersAttributes::OBJECT_TYPE]=res.getColumnValue(QString("object_type"));
+				attribs[ParsersAttributes::OID]=res.getColumnValue(tup, oid_col);
+				attribs[ParsersAttributes::NAME]=res.getColumnValue(tup, name_col);
+				attribs[ParsersAttributes::OBJECT_TYPE]=res.getColumnValue(tup, type_col);
 				objects.push_back(attribs);
 				attribs.clear();
 			}
-			while(res.accessTuple(ResultSet::NEXT_TUPLE));
 		}
 
 		return(objects);
@@ -462,14 +677,14 @@ QString Catalog::getCommentQuery(const QString &oid_field, bool is_shared_obj)
 	}
 }
 
-QString Catalog::getNotExtObjectQuery(const QString &oid_field)
+QString Catalog::getNotExtObjectQuery(const QString &oid_field, const QString &ext_oids)
 {
 	QString query_id=QString("notextobject");
 
 	try
 	{
 		attribs_map attribs={{ParsersAttributes::OID, oid_field},
-							 {ParsersAttributes::EXT_OBJ_OIDS, ext_obj_oids}};
+							 {ParsersAttributes::EXT_OBJ_OIDS, ext_oids}};
 
 
 		loadCatalogQuery(query_id);
@@ -646,6 +861,48 @@ QStringList Catalog::parseRuleCommands(const QString &cmds)
 	return(cmds.mid(start,(end - start) + 1).split(';', QString::SkipEmptyParts));
 }
 
+vector<attribs_map> Catalog::getColumnsAttributes(const map<unsigned, vector<unsigned>> &col_oids, attribs_map extra_attribs)
+{
+	try
+	{
+		QStringList tab_oids, col_filters;
+
+		if(col_oids.empty())
+			return(vector<attribs_map>());
+
+		/* Tables that have all their columns retrieved are filtered by a single IN clause while
+		the ones that have only some columns selected receive their own filter expression */
+		for(auto &itr : col_oids)
+		{
+			if(itr.second.empty())
+				tab_oids.push_back(QString::number(itr.first));
+			else
+				col_filters.push_back(QString("(cl.attrelid=%1 AND cl.attnum IN (%2))").arg(itr.first).arg(createOidFilter(itr.second)));
+		}
+
+		if(!tab_oids.isEmpty())
+			col_filters.push_back(QString("cl.attrelid IN (%1)").arg(tab_oids.join(',')));
+
+		extra_attribs[ParsersAttributes::FILTER_COLUMNS]=col_filters.join(QString(" OR "));
+		return(getMultipleAttributes(OBJ_COLUMN, extra_attribs));
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e,
+						QApplication::translate("Catalog","Object type: %1","", -1).arg(BaseObject::getSchemaName(OBJ_COLUMN)));
+	}
+}
+
+unsigned Catalog::getQueryCount(void)
+{
+	return(query_count);
+}
+
+void Catalog::resetQueryCount(void)
+{
+	query_count=0;
+}
+
 void Catalog::enableCachedQueries(bool value)
 {
 	use_cached_queries=value;
@@ -661,6 +918,7 @@ void Catalog::operator = (const Catalog &catalog)
 	try
 	{
 		this->ext_obj_oids=catalog.ext_obj_oids;
+		this->prepared_stmts.clear();
 		this->connection.setConnectionParams(catalog.connection.getConnectionParams());
 		this->last_sys_oid=catalog.last_sys_oid;
 		this->filter=catalog.filter;
@@ -31,6 +31,7 @@ This class is the basis for the reverse engineering feature.
 #include "tableobject.h"
 #include <QTextStream>
 #include <QApplication>
+#include <QMutex>
 
 class Catalog {
 	private:
@@ -68,13 +69,48 @@ class Catalog {
 		//! \brief Store the cached catalog queries (only when use_cached_queries=true)
 		static attribs_map catalog_queries;
 
+		//! \brief Stores an expanded catalog query and the information needed to execute it as a prepared statement
+		struct CatalogQuery {
+			/*! \brief The expanded query in which the values of the parameterizable attributes (see PARAM_ATTRIBS)
+			are replaced by markers */
+			QString sql,
+
+			//! \brief The query with the markers replaced by placeholders ($1, $2, ...). Empty when the query can't be prepared
+			prepared_sql;
+
+			//! \brief The attributes which values must be passed as parameters to the prepared query, in placeholders order
+			QStringList param_attribs;
+		};
+
+		/*! \brief Attributes which values are passed as parameters of the prepared catalog queries instead of
+		being written in the query itself. This way the same expanded query serves any schema, table, oids filter
+		or database (the extension objects' oids differ from a database to another) */
+		static const QStringList PARAM_ATTRIBS;
+
+		/*! \brief Store the expanded catalog queries (only when use_cached_queries=true). The key is composed by the query type,
+		object type and all the attributes that affect the expansion (server version, filters, etc) */
+		static map<QString, CatalogQuery> expanded_queries;
+
+		//! \brief Maximum amount of expanded queries in cache. When reached the cache is cleared before storing a new query
+		static const unsigned MAX_EXPANDED_QUERIES=500;
+
+		//! \brief Serializes the access to the cached catalog queries since catalogs can be used by several threads
+		static QMutex catalog_queries_mtx;
+
+		/*! \brief Stores the names of the statements prepared in the catalog's connection. The key is the same
+		used in expanded_queries. The map is cleared whenever the connection is closed since the statements are lost */
+		map<QString, QString> prepared_stmts;
+
 		//! \brief Connection used to query the pg_catalog
 		Connection connection;
 
 		//! \brief Stores the last system object identifier. This is used to filter system objects
 		unsigned last_sys_oid,
 
-		filter;
+		filter,
+
+		//! \brief Stores the amount of queries sent to the server since the last call to resetQueryCount()
+		query_count;
 
 		//! \brief Indicates if the catalog must filter system objects
 		bool exclude_sys_objs,
@@ -101,6 +137,15 @@ class Catalog {
 		//! \brief Returns the catalog query according to the type of the object type provided
 		QString getCatalogQuery(const QString &qry_type, ObjectType obj_type, bool single_result=false, attribs_map attribs=attribs_map());
 
+		/*! \brief Returns the expanded catalog query for the object type reusing the cached one when available. The values
+		of the parameterizable attributes are stored in param_values and the cache key in query_key (empty when the query
+		can't be cached, e.g., it has a custom filter) */
+		CatalogQuery getExpandedQuery(const QString &qry_type, ObjectType obj_type, bool single_result, attribs_map attribs,
+																	attribs_map &param_values, QString &query_key);
+
+		//! \brief Returns the expanded query with the markers replaced by the attributes values
+		QString getLiteralQuery(const CatalogQuery &query, const attribs_map &param_values);
+
 		/*! \brief Recreates the attribute map in such way that attribute names that have
 		underscores have this char replaced by dashes. Another special operation made is to replace
 		the values of fiels which suffix is _bool to '1' when 't' and to empty when 'f', this is because
@@ -111,8 +156,8 @@ class Catalog {
 		attribs_map getAttributes(const QString &obj_name, ObjectType obj_type, attribs_map extra_attribs=attribs_map());
 
 		/*! \brief Returns the query to retrieve the information if the object (specified by its oid field) is part or not of
-		 a extension. */
-		QString getNotExtObjectQuery(const QString &oid_field);
+		 a extension. The ext_oids is the list of extension objects' oids (or the marker that replaces it) */
+		QString getNotExtObjectQuery(const QString &oid_field, const QString &ext_oids);
 
 		/*! \brief Returns the query that is used to retrieve an objects comment. The 'is_shared_object' is used
 		to query the pg_shdescription instead of pg_description */
@@ -162,6 +207,17 @@ class Catalog {
 		in order to filter only objects of the specifed schema */
 		unsigned getObjectCount(ObjectType obj_type, const QString &sch_name=QString(), const QString &tab_name=QString(), attribs_map extra_attribs=attribs_map());
 
+		/*! \brief Starts a REPEATABLE READ transaction in the catalog's connection and exports its snapshot so other catalogs can
+		read the same database state (see importSnapshot()). Returns the snapshot id or an empty string if the server can't export
+		snapshots (PostgreSQL < 9.2), in this case no transaction is kept open */
+		QString exportSnapshot(void);
+
+		//! \brief Starts a REPEATABLE READ transaction in the catalog's connection using a snapshot exported by another catalog
+		void importSnapshot(const QString &snapshot_id);
+
+		//! \brief Ends the transaction started by exportSnapshot() or importSnapshot()
+		void finishSnapshot(void);
+
 		//! \brief Returns the current filter configuration for the catalog
 		unsigned getFilter(void);
 
@@ -184,6 +240,10 @@ class Catalog {
 		and by table name (only when retriving child objects for a specific table) */
 		vector<attribs_map> getObjectsAttributes(ObjectType obj_type, const QString &schema=QString(), const QString &table=QString(), const vector<unsigned> &filter_oids={}, attribs_map extra_attribs=attribs_map());
 
+		/*! \brief Retrieve the attributes of the columns of several tables using a single query. The map keys are the oids of the
+		parent tables and the values are the ids of the columns to be retrieved. An empty id vector causes all the table's columns to be retrieved */
+		vector<attribs_map> getColumnsAttributes(const map<unsigned, vector<unsigned>> &col_oids, attribs_map extra_attribs=attribs_map());
+
 		//! \brief Returns the attributes for the object specified by its type and OID
 		attribs_map getObjectAttributes(ObjectType obj_type, unsigned oid, const QString sch_name=QString(), const QString tab_name=QString(), attribs_map extra_attribs=attribs_map());
 
@@ -199,12 +259,19 @@ class Catalog {
 		static QStringList parseRuleCommands(const QString &cmd);
 
 		/*! \brief Enable/disable the use of cached catalog queries. When enabled, the schema files read for the first are stored in memory
-		so in the next time the same catalog query must be used it'll be read right from the memory and not from the disk anymore */
+		so in the next time the same catalog query must be used it'll be read right from the memory and not from the disk anymore.
+		The expanded queries are also cached and executed as prepared statements. This option is disabled by default */
 		static void enableCachedQueries(bool value);
 
 		//! \brief Returns the current status of cached catalog queries
 		static bool isCachedQueriesEnabled(void);
 
+		//! \brief Returns the amount of queries sent to the server since the last call to resetQueryCount()
+		unsigned getQueryCount(void);
+
+		//! \brief Resets the sent queries counter
+		void resetQueryCount(void);
+
 		//! \brief Performs the copy between two catalogs
 		void operator = (const Catalog &catalog);
 };
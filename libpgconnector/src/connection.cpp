@@ -52,11 +52,13 @@ bool Connection::notice_enabled=false;
 bool Connection::print_sql=false;
 bool Connection::silence_conn_err=true;
 QStringList Connection::notices;
+QMutex Connection::notices_mtx;
 
 Connection::Connection(void)
 {
 	connection=nullptr;
 	auto_browse_db=false;	
+	conn_notice_enabled=false;
 	cmd_exec_timeout=0;
 
 	for(unsigned idx=OP_VALIDATION; idx <= OP_DIFF; idx++)
@@ -70,11 +72,7 @@ Connection::Connection(const attribs_map &params) : Connection()
 
 Connection::~Connection(void)
 {
-	if(connection)
-	{
-		PQfinish(connection);
-		connection=nullptr;
-	}
+	close();
 }
 
 void Connection::setSQLExecutionTimout(unsigned timeout)
@@ -154,9 +152,16 @@ void Connection::generateConnectionString(void)
 
 void Connection::noticeProcessor(void *, const char *message)
 {
+	QMutexLocker locker(&notices_mtx);
 	notices.push_back(QString(message));
 }
 
+void Connection::clearNotices(void)
+{
+	QMutexLocker locker(&notices_mtx);
+	notices.clear();
+}
+
 void Connection::validateConnectionStatus(void)
 {
 	if(cmd_exec_timeout > 0)
@@ -228,21 +233,43 @@ void Connection::connect(void)
 		}
 	}
 
-	//Try to connect to the database
-	connection=PQconnectdb(connection_str.toStdString().c_str());
+	conn_notice_enabled=notice_enabled;
+	conn_server_id=getConnectionId();
+	conn_db_name=getConnectionParam(PARAM_DB_NAME);
+
+	//Waits for a free session in case the server reached the maximum amount of sessions in use
+	ConnectionPool::reserveSession(conn_server_id);
+
+	//Try to reuse an idle session of the server before connecting to the database
+	connection=ConnectionPool::acquireSession(conn_server_id, connection_str, conn_notice_enabled);
 	last_cmd_execution=QDateTime::currentDateTime();
 
+	if(connection)
+	{
+		clearNotices();
+		return;
+	}
+
+	connection=PQconnectdb(connection_str.toStdString().c_str());
+
+	if(connection)
+		ConnectionPool::registerSession();
+
 	/* If the connection descriptor has not been allocated or if the connection state
 		is CONNECTION_BAD it indicates that the connection was not successful */
 	if(connection==nullptr || PQstatus(connection)==CONNECTION_BAD)
 	{
+		QString err_msg=QString(Exception::getErrorMessage(ERR_CONNECTION_NOT_STABLISHED)).arg(PQerrorMessage(connection));
+
+		//Undoing the session reservation (the failed session is not kept by the pool)
+		ConnectionPool::releaseSession(conn_server_id, connection_str, conn_db_name, conn_notice_enabled, connection);
+		connection=nullptr;
+
 		//Raise the error generated by the DBMS
-		throw Exception(QString(Exception::getErrorMessage(ERR_CONNECTION_NOT_STABLISHED))
-						.arg(PQerrorMessage(connection)), ERR_CONNECTION_NOT_STABLISHED,
-						__PRETTY_FUNCTION__, __FILE__, __LINE__);
+		throw Exception(err_msg, ERR_CONNECTION_NOT_STABLISHED, __PRETTY_FUNCTION__, __FILE__, __LINE__);
 	}
 
-	notices.clear();
+	clearNotices();
 
 	if(!notice_enabled)
 		//Completely disable notice/warnings in the connection
@@ -256,15 +283,44 @@ void Connection::close(void)
 {
 	if(connection)
 	{
-		//Finalizes the connection if the status is OK
-		if(PQstatus(connection)==CONNECTION_OK)
-			PQfinish(connection);
-
+		//The session is kept by the pool if it can be reused otherwise it is finalized
+		ConnectionPool::releaseSession(conn_server_id, connection_str, conn_db_name, conn_notice_enabled, connection);
 		connection=nullptr;
 		last_cmd_execution=QDateTime();
 	}
 }
 
+void Connection::clearIdleSessions(const QString &sql)
+{
+	QRegExp create_db_regexp=QRegExp(QString("(^|;)\\s*CREATE\\s+DATABASE\\s"), Qt::CaseInsensitive),
+			db_name_regexp=QRegExp(QString("(^|;)\\s*(DROP\\s+DATABASE(\\s+IF\\s+EXISTS)?|ALTER\\s+DATABASE)\\s+(\"([^\"]|\"\")+\"|[^\\s;]+)"),
+														 Qt::CaseInsensitive);
+	QString db_name;
+	int pos=0;
+
+	/* All the idle sessions are closed when creating a database since the template database must have no other sessions.
+	Different connection aliases can point to the same server so the sessions of all servers are closed */
+	if(sql.contains(create_db_regexp))
+	{
+		ConnectionPool::clear();
+		return;
+	}
+
+	//Closing only the idle sessions of the databases being dropped or altered (e.g. renamed)
+	while((pos=db_name_regexp.indexIn(sql, pos)) >= 0)
+	{
+		db_name=db_name_regexp.cap(4);
+		pos+=db_name_regexp.matchedLength();
+
+		if(db_name.startsWith('"'))
+			db_name=db_name.mid(1, db_name.length() - 2).replace(QString("\"\""), QString("\""));
+		else
+			db_name=db_name.toLower();
+
+		ConnectionPool::clearIdleSessions(db_name);
+	}
+}
+
 void Connection::reset(void)
 {
 	//Raise an erro in case the user try to reset a not opened connection
@@ -346,10 +402,11 @@ QString  Connection::getPgSQLVersion(bool major_only)
 
 QStringList Connection::getNotices(void)
 {
+	QMutexLocker locker(&notices_mtx);
 	return (notices);
 }
 
-void Connection::executeDMLCommand(const QString &sql, ResultSet &result)
+void Connection::executeDMLCommand(const QString &sql, ResultSet &result, bool binary_fmt)
 {
 	ResultSet *new_res=nullptr;
 	PGresult *sql_res=nullptr;
@@ -359,10 +416,15 @@ void Connection::executeDMLCommand(const QString &sql, ResultSet &result)
 		throw Exception(ERR_OPR_NOT_ALOC_CONN, __PRETTY_FUNCTION__, __FILE__, __LINE__);
 
 	validateConnectionStatus();
-	notices.clear();
+	clearNotices();
+	clearIdleSessions(sql);
 
 	//Alocates a new result to receive the resultset returned by the sql command
-	sql_res=PQexec(connection, sql.toStdString().c_str());
+	if(!binary_fmt)
+		sql_res=PQexec(connection, sql.toStdString().c_str());
+	else
+		//Binary results can only be requested through the extended query protocol
+		sql_res=PQexecParams(connection, sql.toStdString().c_str(), 0, nullptr, nullptr, nullptr, nullptr, 1);
 
 	//Prints the SQL to stdout when the flag is active
 	if(print_sql)
@@ -390,6 +452,311 @@ void Connection::executeDMLCommand(const QString &sql, ResultSet &result)
 	delete(new_res);
 }
 
+bool Connection::executeStreamedDMLCommand(const QString &sql, std::function<bool(ResultSet &, bool)> batch_handler,
+																					 unsigned batch_size, unsigned max_rows)
+{
+	PGresult *sql_res=nullptr, *batch_res=nullptr;
+	ExecStatusType status;
+	unsigned row_count=0;
+	int batch_rows=0;
+	bool stopped=false, first_batch=true;
+	QString error, sql_state;
+
+	//Raise an error in case the user try to close a not opened connection
+	if(!connection)
+		throw Exception(ERR_OPR_NOT_ALOC_CONN, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	if(batch_size==0)
+		batch_size=DEFAULT_BATCH_SIZE;
+
+	validateConnectionStatus();
+	clearNotices();
+	clearIdleSessions(sql);
+
+	if(!PQsendQuery(connection, sql.toStdString().c_str()))
+	{
+		throw Exception(QString(Exception::getErrorMessage(ERR_CMD_SQL_NOT_EXECUTED))
+						.arg(PQerrorMessage(connection)),
+						ERR_CMD_SQL_NOT_EXECUTED, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+	}
+
+	/* Requesting the rows to be returned one by one. If the single-row mode can't be
+	activated the results are processed normally being delivered in a single batch */
+	PQsetSingleRowMode(connection);
+
+	//Prints the SQL to stdout when the flag is active
+	if(print_sql)
+	{
+		QTextStream out(stdout);
+		out << QString("\n---\n") << sql << endl;
+	}
+
+	//Delivers the rows accumulated in the batch result to the handler
+	auto deliverBatch=[&](PGresult *pg_res){
+		ResultSet res(pg_res);
+		bool first=first_batch;
+
+		first_batch=false;
+
+		if(!stopped && !batch_handler(res, first))
+			stopped=true;
+	};
+
+	try
+	{
+		while((sql_res=PQgetResult(connection)))
+		{
+			status=PQresultStatus(sql_res);
+
+			//After the command being cancelled the remaining results are only discarded
+			if(stopped)
+				PQclear(sql_res);
+			else if(status==PGRES_SINGLE_TUPLE)
+			{
+				appendTuple(sql_res, batch_res, batch_rows);
+				PQclear(sql_res);
+				row_count++;
+
+				if(static_cast<unsigned>(batch_rows) >= batch_size || (max_rows > 0 && row_count >= max_rows))
+				{
+					deliverBatch(batch_res);
+					batch_res=nullptr;
+					batch_rows=0;
+				}
+
+				if(!stopped && max_rows > 0 && row_count >= max_rows)
+					stopped=true;
+
+				if(stopped)
+					cancelCommand();
+			}
+			else if(status==PGRES_FATAL_ERROR || status==PGRES_BAD_RESPONSE || status==PGRES_NONFATAL_ERROR)
+			{
+				if(error.isEmpty())
+				{
+					error=PQresultErrorMessage(sql_res);
+					sql_state=PQresultErrorField(sql_res, PG_DIAG_SQLSTATE);
+				}
+
+				PQclear(sql_res);
+			}
+			else
+			{
+				//Delivering the remaining rows of the current statement
+				if(batch_res)
+				{
+					deliverBatch(batch_res);
+					batch_res=nullptr;
+					batch_rows=0;
+				}
+
+				/* The final result of a statement in single-row mode has no tuples. It is delivered only
+				if no row was returned so the handler can know the columns or the amount of affected rows */
+				if(first_batch || PQntuples(sql_res) > 0)
+				{
+					row_count+=PQntuples(sql_res);
+					deliverBatch(sql_res);
+				}
+				else
+					PQclear(sql_res);
+
+				//The next result (if any) belongs to another statement in the command
+				first_batch=true;
+
+				if(stopped)
+					cancelCommand();
+			}
+		}
+
+		if(batch_res)
+			deliverBatch(batch_res);
+	}
+	catch(Exception &e)
+	{
+		//Cancelling the command and discarding the pending results so the connection can be used again
+		cancelCommand();
+
+		while((sql_res=PQgetResult(connection)))
+			PQclear(sql_res);
+
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+
+	//Raise an error in case the command sql execution is not sucessful (errors caused by the cancelling are ignored)
+	if(!error.isEmpty() && !stopped)
+	{
+		throw Exception(QString(Exception::getErrorMessage(ERR_CMD_SQL_NOT_EXECUTED)).arg(error),
+						ERR_CMD_SQL_NOT_EXECUTED, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, sql_state);
+	}
+
+	return(!stopped);
+}
+
+void Connection::appendTuple(PGresult *src_res, PGresult *&batch_res, int &batch_rows)
+{
+	//The batch result is created with the same columns as the received row
+	if(!batch_res)
+	{
+		batch_res=PQcopyResult(src_res, PG_COPYRES_ATTRS);
+		batch_rows=0;
+	}
+
+	for(int col=0; col < PQnfields(src_res); col++)
+	{
+		PQsetvalue(batch_res, batch_rows, col,
+							 (PQgetisnull(src_res, 0, col) ? nullptr : PQgetvalue(src_res, 0, col)),
+							 (PQgetisnull(src_res, 0, col) ? -1 : PQgetlength(src_res, 0, col)));
+	}
+
+	batch_rows++;
+}
+
+unsigned Connection::copyFromDevice(const QString &copy_sql, QIODevice &input, std::function<bool(qint64)> progress_handler, unsigned chunk_size)
+{
+	PGresult *sql_res=nullptr;
+	ExecStatusType status;
+	QByteArray chunk;
+	qint64 sent_bytes=0;
+	unsigned row_count=0;
+	bool aborted=false;
+	QString error, sql_state;
+
+	//Raise an error in case the user try to close a not opened connection
+	if(!connection)
+		throw Exception(ERR_OPR_NOT_ALOC_CONN, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	if(!input.isReadable())
+		throw Exception(ERR_OPR_NOT_ALOC_OBJECT, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	if(chunk_size==0)
+		chunk_size=DEFAULT_COPY_CHUNK_SIZE;
+
+	validateConnectionStatus();
+	clearNotices();
+	sql_res=PQexec(connection, copy_sql.toStdString().c_str());
+
+	//Prints the SQL to stdout when the flag is active
+	if(print_sql)
+	{
+		QTextStream out(stdout);
+		out << QString("\n---\n") << copy_sql << endl;
+	}
+
+	status=PQresultStatus(sql_res);
+
+	if(status!=PGRES_COPY_IN)
+	{
+		error=PQresultErrorMessage(sql_res);
+		sql_state=PQresultErrorField(sql_res, PG_DIAG_SQLSTATE);
+		PQclear(sql_res);
+
+		//Discarding any data the server may be sending in case the command is a COPY ... TO STDOUT
+		if(status==PGRES_COPY_OUT)
+		{
+			char *buffer=nullptr;
+
+			while(PQgetCopyData(connection, &buffer, 0) > 0)
+				PQfreemem(buffer);
+		}
+
+		while((sql_res=PQgetResult(connection)))
+			PQclear(sql_res);
+
+		if(!error.isEmpty())
+		{
+			throw Exception(QString(Exception::getErrorMessage(ERR_CMD_SQL_NOT_EXECUTED)).arg(error),
+							ERR_CMD_SQL_NOT_EXECUTED, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, sql_state);
+		}
+
+		throw Exception(ERR_INV_COPY_FROM_CMD, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+	}
+
+	PQclear(sql_res);
+
+	try
+	{
+		//Sending the data chunk by chunk so only a small portion of the input is kept in memory
+		while(!input.atEnd())
+		{
+			chunk=input.read(chunk_size);
+
+			if(chunk.isEmpty())
+				break;
+
+			if(PQputCopyData(connection, chunk.constData(), chunk.size()) < 0)
+			{
+				error=PQerrorMessage(connection);
+				break;
+			}
+
+			sent_bytes+=chunk.size();
+
+			if(progress_handler && !progress_handler(sent_bytes))
+			{
+				aborted=true;
+				break;
+			}
+		}
+	}
+	catch(Exception &e)
+	{
+		//An error raised by the handler aborts the copy so the connection can be used again
+		PQputCopyEnd(connection, "COPY aborted by the client");
+
+		while((sql_res=PQgetResult(connection)))
+			PQclear(sql_res);
+
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+
+	/* Finishing the data transfer. When the copy is aborted (or failed) the server
+	discards all the rows already received and the command ends with an error */
+	if(PQputCopyEnd(connection, (aborted || !error.isEmpty() ? "COPY aborted by the client" : nullptr)) < 0 && error.isEmpty())
+		error=PQerrorMessage(connection);
+
+	while((sql_res=PQgetResult(connection)))
+	{
+		status=PQresultStatus(sql_res);
+
+		if(status==PGRES_COMMAND_OK)
+			row_count=QString(PQcmdTuples(sql_res)).toUInt();
+		else if(error.isEmpty() && !aborted)
+		{
+			error=PQresultErrorMessage(sql_res);
+			sql_state=PQresultErrorField(sql_res, PG_DIAG_SQLSTATE);
+		}
+
+		PQclear(sql_res);
+	}
+
+	/* Raise an error in case the copy is not sucessful. The error message returned by the server contains the
+	context of the failure, e.g. "COPY table, line 10, column col", so the user can locate the row that caused it */
+	if(!error.isEmpty())
+	{
+		throw Exception(QString(Exception::getErrorMessage(ERR_CMD_SQL_NOT_EXECUTED)).arg(error),
+						ERR_CMD_SQL_NOT_EXECUTED, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, sql_state);
+	}
+
+	return(row_count);
+}
+
+void Connection::cancelCommand(void)
+{
+	PGcancel *cancel=nullptr;
+	char errbuf[256];
+
+	if(!connection)
+		return;
+
+	cancel=PQgetCancel(connection);
+
+	if(cancel)
+	{
+		PQcancel(cancel, errbuf, sizeof(errbuf));
+		PQfreeCancel(cancel);
+	}
+}
+
 void Connection::executeDDLCommand(const QString &sql)
 {
 	PGresult *sql_res=nullptr;
@@ -399,7 +766,8 @@ void Connection::executeDDLCommand(const QString &sql)
 		throw Exception(ERR_OPR_NOT_ALOC_CONN, __PRETTY_FUNCTION__, __FILE__, __LINE__);
 
 	validateConnectionStatus();
-	notices.clear();
+	clearNotices();
+	clearIdleSessions(sql);
 	sql_res=PQexec(connection, sql.toStdString().c_str());
 
 	//Prints the SQL to stdout when the flag is active
@@ -419,6 +787,87 @@ void Connection::executeDDLCommand(const QString &sql)
 	}
 }
 
+void Connection::prepareCommand(const QString &stmt_name, const QString &sql)
+{
+	PGresult *sql_res=nullptr;
+	QString error;
+
+	if(!connection)
+		throw Exception(ERR_OPR_NOT_ALOC_CONN, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	validateConnectionStatus();
+	clearNotices();
+	sql_res=PQprepare(connection, stmt_name.toStdString().c_str(), sql.toStdString().c_str(), 0, nullptr);
+
+	//Prints the SQL to stdout when the flag is active
+	if(print_sql)
+	{
+		QTextStream out(stdout);
+		out << QString("\n---\nPREPARE %1 AS ").arg(stmt_name) << sql << endl;
+	}
+
+	if(PQresultStatus(sql_res)!=PGRES_COMMAND_OK)
+	{
+		error=QString(PQresultErrorField(sql_res, PG_DIAG_SQLSTATE));
+		PQclear(sql_res);
+
+		throw Exception(QString(Exception::getErrorMessage(ERR_CMD_SQL_NOT_EXECUTED))
+						.arg(PQerrorMessage(connection)),
+						ERR_CMD_SQL_NOT_EXECUTED, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, error);
+	}
+
+	PQclear(sql_res);
+}
+
+void Connection::executePreparedCommand(const QString &stmt_name, const QStringList &params, ResultSet &result, bool binary_fmt)
+{
+	ResultSet *new_res=nullptr;
+	PGresult *sql_res=nullptr;
+	vector<QByteArray> values;
+	vector<const char *> values_ptr;
+
+	if(!connection)
+		throw Exception(ERR_OPR_NOT_ALOC_CONN, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	validateConnectionStatus();
+	clearNotices();
+
+	//The byte arrays must outlive the call to PQexecPrepared since the pointers passed reference their data
+	for(auto &param : params)
+		values.push_back(param.toUtf8());
+
+	for(auto &value : values)
+		values_ptr.push_back(value.constData());
+
+	sql_res=PQexecPrepared(connection, stmt_name.toStdString().c_str(), values_ptr.size(),
+												 (values_ptr.empty() ? nullptr : values_ptr.data()), nullptr, nullptr, (binary_fmt ? 1 : 0));
+
+	//Prints the SQL to stdout when the flag is active
+	if(print_sql)
+	{
+		QTextStream out(stdout);
+		out << QString("\n---\nEXECUTE %1('%2')").arg(stmt_name).arg(params.join(QString("', '"))) << endl;
+	}
+
+	//Raise an error in case the command sql execution is not sucessful
+	if(strlen(PQerrorMessage(connection))>0)
+	{
+		throw Exception(QString(Exception::getErrorMessage(ERR_CMD_SQL_NOT_EXECUTED))
+						.arg(PQerrorMessage(connection)),
+						ERR_CMD_SQL_NOT_EXECUTED, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr,
+						QString(PQresultErrorField(sql_res, PG_DIAG_SQLSTATE)));
+	}
+
+	//Generates the resultset based on the sql result descriptor
+	new_res=new ResultSet(sql_res);
+
+	//Copy the new resultset to the parameter resultset
+	result=*(new_res);
+
+	//Deallocate the new resultset
+	delete(new_res);
+}
+
 void Connection::setDefaultForOperation(unsigned op_id, bool value)
 {
 	if(op_id > OP_NONE)
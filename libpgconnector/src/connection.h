@@ -28,8 +28,12 @@
 
 #include "resultset.h"
 #include "attribsmap.h"
+#include "connectionpool.h"
 #include <QRegExp>
 #include <QDateTime>
+#include <QMutex>
+#include <QIODevice>
+#include <functional>
 
 class Connection {
 	private:
@@ -56,6 +60,13 @@ class Connection {
 		The list is filled only if notice_enabled is true */
 		static QStringList notices;
 
+		/*! \brief Serializes the access to the notices list since several connections can be used at
+		the same time by different threads (e.g. database import) */
+		static QMutex notices_mtx;
+
+		//! \brief Clears the list of notices generated by the previous command
+		static void clearNotices(void);
+
 		//! \brief Generates the connection string based on the parameter map
 		void generateConnectionString(void);
 
@@ -88,11 +99,29 @@ class Connection {
 		is used if none is explicitly specified by the user in the UI */
 		default_for_oper[4];
 
+		//! \brief Indicates if the notices were enabled when the connection was opened (used to match the sessions in the pool)
+		bool conn_notice_enabled;
+
+		/*! \brief Server identifier and database name used when the connection was opened. These values are used to
+		return the session to the pool even if the connection parameters are changed while it is opened */
+		QString conn_server_id, conn_db_name;
+
+		/*! \brief Closes the idle sessions kept by the connection pool when the command handles databases. This avoids
+		commands like DROP DATABASE to fail due to sessions opened by the pool in the affected database */
+		void clearIdleSessions(const QString &sql);
+
 		/*! \brief Validates the connection status (command exec. timeout and connection status) and
 		raise errors in case of exceeded timeout or bad connection. This method is called prior any
 		command execution */
 		void validateConnectionStatus(void);
 
+		//! \brief Requests the server to cancel the command currently running on the connection
+		void cancelCommand(void);
+
+		/*! \brief Appends the first tuple of the source result to the batch result creating the latter (with the same columns
+		of the source) if it's not allocated. This method is used to group the rows received in single-row mode */
+		static void appendTuple(PGresult *src_res, PGresult *&batch_res, int &batch_rows);
+
 	public:
 		//! \brief Constants used to reference the connections parameters
 		static const QString	PARAM_ALIAS,
@@ -123,6 +152,12 @@ class Connection {
 		SERVER_PROTOCOL,
 		SERVER_PID;
 
+		//! \brief Default amount of rows delivered per batch by executeStreamedDMLCommand()
+		static const unsigned DEFAULT_BATCH_SIZE=500;
+
+		//! \brief Default amount of bytes sent to the server per chunk by copyFromDevice()
+		static const unsigned DEFAULT_COPY_CHUNK_SIZE=65536;
+
 		//! \brief Constants used to reference the default usage in model operations (see setDefaultForOperation())
 		static const unsigned OP_VALIDATION=0,
 		OP_EXPORT=1,
@@ -168,13 +203,14 @@ class Connection {
 		//! \brief Set if the database configured on the connection is auto browseable when using the SQLTool manage database
 		void setAutoBrowseDB(bool value);
 
-		//! \brief Open the connection to the database
+		/*! \brief Open the connection to the database. An idle session with the same parameters kept by the connection
+		pool is reused when available (see ConnectionPool) */
 		void connect(void);
 
 		//! \brief Resets the database connection
 		void reset(void);
 
-		//! \brief Close the opened connection
+		//! \brief Close the opened connection returning the session to the connection pool
 		void close(void);
 
 		//! \brief Returns the value of specified parameter name
@@ -213,14 +249,43 @@ class Connection {
 		bool isAutoBrowseDB(void);
 
 		/*! \brief Executes a DML command on the server using the opened connection.
-		 Its mandatory to specify the object to receive the returned resultset. */
-		void executeDMLCommand(const QString &sql, ResultSet &result);
+		 Its mandatory to specify the object to receive the returned resultset. When binary_fmt is true the values are
+		 returned in binary format, avoiding their conversion to text in the server, and must be read through the typed
+		 accessors of ResultSet (e.g. getInt32(), getOid()). In that case the command must contain a single statement */
+		void executeDMLCommand(const QString &sql, ResultSet &result, bool binary_fmt=false);
+
+		/*! \brief Executes a DML command on the server delivering the returned rows to the batch_handler as soon as they arrive,
+		in result sets of at most batch_size tuples, instead of waiting the whole result to be stored in memory (libpq single-row mode).
+		The second argument of the handler indicates that the batch is the first one of a statement's result (the command can contain
+		several statements). Results without tuples (e.g. INSERT, UPDATE) are delivered as empty result sets.
+		The retrieval can be stopped by returning false in the handler or by specifying the maximum amount of rows to be delivered (max_rows)
+		in both cases the command is cancelled on the server. Returns true if all the rows were delivered. */
+		bool executeStreamedDMLCommand(const QString &sql, std::function<bool(ResultSet &, bool)> batch_handler,
+																	 unsigned batch_size=DEFAULT_BATCH_SIZE, unsigned max_rows=0);
+
+		/*! \brief Executes a COPY ... FROM STDIN command sending the contents of the input device (from its current position)
+		to the server in chunks of chunk_size bytes, so the whole data never needs to be stored in memory.
+		The progress_handler (optional) receives the amount of bytes sent so far after each chunk. Returning false
+		in the handler aborts the copy. Returns the amount of rows copied. Since a COPY is an atomic command
+		no row is stored in the table in case of errors or when the copy is aborted */
+		unsigned copyFromDevice(const QString &copy_sql, QIODevice &input, std::function<bool(qint64)> progress_handler=nullptr,
+														unsigned chunk_size=DEFAULT_COPY_CHUNK_SIZE);
 
 		/*! \brief Executes a DDL command on the server using the opened connection.
 		 The user don't need to specify the resultset since the commando executed is intended
 		 to be an data definition one  */
 		void executeDDLCommand(const QString &sql);
 
+		/*! \brief Creates a server-side prepared statement named stmt_name for the SQL command. The command can
+		reference parameters through the placeholders $1, $2, ... which values are passed to executePreparedCommand().
+		The statement lasts until the connection is closed */
+		void prepareCommand(const QString &stmt_name, const QString &sql);
+
+		/*! \brief Executes a statement created by prepareCommand() using the specified parameters values (in text format).
+		 Its mandatory to specify the object to receive the returned resultset. The values can be returned in binary format
+		 (see executeDMLCommand()) */
+		void executePreparedCommand(const QString &stmt_name, const QStringList &params, ResultSet &result, bool binary_fmt=false);
+
 		//! \brief Toggles the default status for the connect in the specified operation (OP_??? constants).
 		void setDefaultForOperation(unsigned op_id, bool value);
 
@@ -229,6 +294,8 @@ class Connection {
 
 		//! \brief Makes an copy between two connections
 		void operator = (const Connection &conn);
+
+		friend class QueryExecutor;
 };
 
 #endif
@@ -0,0 +1,297 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2016 - Raphael Araújo e Silva <raphael@pgmodeler.com.br>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "connectionpool.h"
+#include "exception.h"
+
+const QString ConnectionPool::METRIC_CREATED=QString("created");
+const QString ConnectionPool::METRIC_REUSED=QString("reused");
+const QString ConnectionPool::METRIC_RELEASED=QString("released");
+const QString ConnectionPool::METRIC_DISCARDED=QString("discarded");
+const QString ConnectionPool::METRIC_IN_USE=QString("in-use");
+const QString ConnectionPool::METRIC_IDLE=QString("idle");
+
+map<QString, deque<ConnectionPool::IdleSession>> ConnectionPool::idle_sessions;
+map<QString, unsigned> ConnectionPool::used_sessions;
+QMutex ConnectionPool::pool_mtx;
+bool ConnectionPool::pool_enabled=true;
+unsigned ConnectionPool::max_idle_sessions=ConnectionPool::DEFAULT_MAX_IDLE_SESSIONS;
+unsigned ConnectionPool::max_idle_time=ConnectionPool::DEFAULT_MAX_IDLE_TIME;
+unsigned ConnectionPool::max_used_sessions=ConnectionPool::DEFAULT_MAX_USED_SESSIONS;
+unsigned ConnectionPool::created_count=0;
+unsigned ConnectionPool::reused_count=0;
+unsigned ConnectionPool::released_count=0;
+unsigned ConnectionPool::discarded_count=0;
+unsigned ConnectionPool::in_use_count=0;
+
+void ConnectionPool::setEnabled(bool value)
+{
+	pool_mtx.lock();
+	pool_enabled=value;
+	pool_mtx.unlock();
+
+	if(!value)
+		clear();
+}
+
+bool ConnectionPool::isEnabled(void)
+{
+	QMutexLocker locker(&pool_mtx);
+	return(pool_enabled);
+}
+
+void ConnectionPool::setMaxIdleSessions(unsigned max_sessions)
+{
+	QMutexLocker locker(&pool_mtx);
+	max_idle_sessions=max_sessions;
+}
+
+void ConnectionPool::setMaxIdleTime(unsigned max_time)
+{
+	QMutexLocker locker(&pool_mtx);
+	max_idle_time=max_time;
+}
+
+void ConnectionPool::setMaxUsedSessions(unsigned max_sessions)
+{
+	QMutexLocker locker(&pool_mtx);
+	max_used_sessions=max_sessions;
+}
+
+bool ConnectionPool::isSessionHealthy(PGconn *conn)
+{
+	/* Reading any pending data causes the connection status to be changed to CONNECTION_BAD
+	in case the server closed the session (e.g. due to a restart or idle timeouts) */
+	return(conn && PQstatus(conn)==CONNECTION_OK && PQconsumeInput(conn)!=0 &&
+				 PQstatus(conn)==CONNECTION_OK && PQtransactionStatus(conn)==PQTRANS_IDLE);
+}
+
+bool ConnectionPool::resetSession(PGconn *conn)
+{
+	PGresult *res=PQexec(conn, "DISCARD ALL");
+	bool reset=(PQresultStatus(res)==PGRES_COMMAND_OK);
+
+	PQclear(res);
+	return(reset);
+}
+
+void ConnectionPool::discardSession(PGconn *conn)
+{
+	if(!conn)
+		return;
+
+	PQfinish(conn);
+
+	QMutexLocker locker(&pool_mtx);
+	discarded_count++;
+}
+
+void ConnectionPool::removeExpiredSessions(vector<PGconn *> &expired)
+{
+	QDateTime limit=QDateTime::currentDateTime().addSecs(-static_cast<qint64>(max_idle_time));
+
+	for(auto itr=idle_sessions.begin(); itr!=idle_sessions.end(); itr++)
+	{
+		//The oldest sessions are at the beginning of the lists
+		while(!itr->second.empty() && itr->second.front().release_time < limit)
+		{
+			expired.push_back(itr->second.front().connection);
+			itr->second.pop_front();
+		}
+	}
+}
+
+void ConnectionPool::reserveSession(const QString &server_id)
+{
+	QMutexLocker locker(&pool_mtx);
+
+	if(max_used_sessions > 0 && used_sessions[server_id] >= max_used_sessions)
+		throw Exception(Exception::getErrorMessage(ERR_MAX_SESSIONS_REACHED).arg(server_id),
+										ERR_MAX_SESSIONS_REACHED,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	used_sessions[server_id]++;
+	in_use_count++;
+}
+
+PGconn *ConnectionPool::acquireSession(const QString &server_id, const QString &conn_str, bool notice_enabled)
+{
+	PGconn *conn=nullptr;
+	vector<PGconn *> discarded;
+
+	pool_mtx.lock();
+	removeExpiredSessions(discarded);
+
+	if(pool_enabled && idle_sessions.count(server_id))
+	{
+		deque<IdleSession> &sessions=idle_sessions[server_id];
+
+		//Reusing the most recently released session that matches the parameters
+		for(auto itr=sessions.rbegin(); itr!=sessions.rend(); itr++)
+		{
+			if(itr->conn_str==conn_str && itr->notice_enabled==notice_enabled)
+			{
+				conn=itr->connection;
+				sessions.erase(std::next(itr).base());
+				break;
+			}
+		}
+	}
+
+	pool_mtx.unlock();
+
+	for(auto &session : discarded)
+		discardSession(session);
+
+	/* The health check and the reset are made without holding the lock since they need to communicate with the server.
+	The state is reset only here (not when the session is released) so sessions that are never reused don't cost a round trip */
+	if(conn && (!isSessionHealthy(conn) || !resetSession(conn)))
+	{
+		discardSession(conn);
+		return(acquireSession(server_id, conn_str, notice_enabled));
+	}
+
+	if(conn)
+	{
+		QMutexLocker locker(&pool_mtx);
+		reused_count++;
+	}
+
+	return(conn);
+}
+
+void ConnectionPool::registerSession(void)
+{
+	QMutexLocker locker(&pool_mtx);
+	created_count++;
+}
+
+void ConnectionPool::releaseSession(const QString &server_id, const QString &conn_str, const QString &db_name, bool notice_enabled, PGconn *conn)
+{
+	vector<PGconn *> discarded;
+	bool reusable=false;
+
+	pool_mtx.lock();
+	in_use_count=(in_use_count > 0 ? in_use_count - 1 : 0);
+
+	if(used_sessions[server_id] > 0)
+		used_sessions[server_id]--;
+
+	reusable=pool_enabled && max_idle_sessions > 0;
+	pool_mtx.unlock();
+
+	if(!conn)
+		return;
+
+	//Restoring the default blocking mode changed by the asynchronous command execution
+	if(reusable && isSessionHealthy(conn) && PQisnonblocking(conn))
+		reusable=(PQsetnonblocking(conn, 0)==0);
+	else
+		reusable=reusable && isSessionHealthy(conn);
+
+	if(!reusable)
+	{
+		discardSession(conn);
+		return;
+	}
+
+	pool_mtx.lock();
+	removeExpiredSessions(discarded);
+
+	deque<IdleSession> &sessions=idle_sessions[server_id];
+	sessions.push_back(IdleSession{ conn, conn_str, db_name, notice_enabled, QDateTime::currentDateTime() });
+	released_count++;
+
+	//Closing the oldest sessions when the server exceeds the limit of idle sessions
+	while(sessions.size() > max_idle_sessions)
+	{
+		discarded.push_back(sessions.front().connection);
+		sessions.pop_front();
+	}
+
+	pool_mtx.unlock();
+
+	for(auto &session : discarded)
+		discardSession(session);
+}
+
+void ConnectionPool::clear(const QString &server_id)
+{
+	vector<PGconn *> discarded;
+
+	pool_mtx.lock();
+
+	for(auto itr=idle_sessions.begin(); itr!=idle_sessions.end(); itr++)
+	{
+		if(server_id.isEmpty() || itr->first==server_id)
+		{
+			for(auto &session : itr->second)
+				discarded.push_back(session.connection);
+
+			itr->second.clear();
+		}
+	}
+
+	pool_mtx.unlock();
+
+	for(auto &session : discarded)
+		discardSession(session);
+}
+
+void ConnectionPool::clearIdleSessions(const QString &db_name)
+{
+	vector<PGconn *> discarded;
+
+	pool_mtx.lock();
+
+	for(auto itr=idle_sessions.begin(); itr!=idle_sessions.end(); itr++)
+	{
+		deque<IdleSession> &sessions=itr->second;
+
+		for(auto sess_itr=sessions.begin(); sess_itr!=sessions.end();)
+		{
+			if(sess_itr->db_name==db_name)
+			{
+				discarded.push_back(sess_itr->connection);
+				sess_itr=sessions.erase(sess_itr);
+			}
+			else
+				sess_itr++;
+		}
+	}
+
+	pool_mtx.unlock();
+
+	for(auto &session : discarded)
+		discardSession(session);
+}
+
+attribs_map ConnectionPool::getMetrics(void)
+{
+	QMutexLocker locker(&pool_mtx);
+	unsigned idle_count=0;
+
+	for(auto &itr : idle_sessions)
+		idle_count+=itr.second.size();
+
+	return(attribs_map{ { METRIC_CREATED, QString::number(created_count) },
+											{ METRIC_REUSED, QString::number(reused_count) },
+											{ METRIC_RELEASED, QString::number(released_count) },
+											{ METRIC_DISCARDED, QString::number(discarded_count) },
+											{ METRIC_IN_USE, QString::number(in_use_count) },
+											{ METRIC_IDLE, QString::number(idle_count) } });
+}
@@ -0,0 +1,159 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2016 - Raphael Araújo e Silva <raphael@pgmodeler.com.br>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libpgconnector
+\class ConnectionPool
+\brief Keeps the server sessions released by the connections so they can be reused by the next connection opened with
+the same parameters, avoiding the costs of connecting (TLS handshake, authentication, backend startup) every time a copy
+of a connection is opened. The sessions are grouped by server (see Connection::getConnectionId()) and the amount of idle
+sessions kept for each server is limited. Optionally, the amount of sessions in use can be limited too (no limit by default).
+Before being reused a session has its
+health checked and its state reset (DISCARD ALL), this way, sessions that are never reused don't cost a round trip to
+the server when released. All methods are thread safe.
+*/
+
+#ifndef CONNECTION_POOL_H
+#define CONNECTION_POOL_H
+
+#include "exception.h"
+#include "attribsmap.h"
+#include <libpq-fe.h>
+#include <QDateTime>
+#include <QMutex>
+#include <deque>
+
+class ConnectionPool {
+	private:
+		//! \brief Stores an idle session and the information needed to reuse it
+		struct IdleSession {
+			PGconn *connection;
+
+			//! \brief The connection string used to open the session
+			QString conn_str,
+
+			//! \brief The database to which the session is connected
+			db_name;
+
+			//! \brief Indicates if the notices were enabled when the session was opened (see Connection::setNoticeEnabled())
+			bool notice_enabled;
+
+			//! \brief The moment in which the session was released
+			QDateTime release_time;
+		};
+
+		//! \brief Idle sessions grouped by server. The most recently released sessions are at the end of the lists
+		static map<QString, deque<IdleSession>> idle_sessions;
+
+		//! \brief Amount of sessions in use (opened and not released yet) of each server
+		static map<QString, unsigned> used_sessions;
+
+		//! \brief Serializes the access to the pool since connections can be opened/closed by different threads
+		static QMutex pool_mtx;
+
+		//! \brief Indicates if the released sessions are kept in the pool
+		static bool pool_enabled;
+
+		//! \brief Maximum amount of idle sessions kept for each server
+		static unsigned max_idle_sessions,
+
+		//! \brief Maximum time (in seconds) that a session can stay idle in the pool
+		max_idle_time,
+
+		//! \brief Maximum amount of sessions in use for each server (zero means no limit)
+		max_used_sessions,
+
+		//! \brief Counters used to generate the pool metrics (see getMetrics())
+		created_count, reused_count, released_count, discarded_count, in_use_count;
+
+		ConnectionPool(void){}
+
+		/*! \brief Returns if the session can be reused, this is, the connection is ok, no transaction is open and
+		the server didn't close the session in the meantime */
+		static bool isSessionHealthy(PGconn *conn);
+
+		/*! \brief Resets the session state (settings, prepared statements, temporary tables, etc) so the next user gets
+		a clean session. Returns false if the reset failed */
+		static bool resetSession(PGconn *conn);
+
+		//! \brief Closes the session on the server
+		static void discardSession(PGconn *conn);
+
+		//! \brief Removes from the pool the sessions that exceeded the maximum idle time. The mutex must be locked by the caller
+		static void removeExpiredSessions(vector<PGconn *> &expired);
+
+	public:
+		//! \brief Constants used to reference the pool metrics (see getMetrics())
+		static const QString METRIC_CREATED,
+		METRIC_REUSED,
+		METRIC_RELEASED,
+		METRIC_DISCARDED,
+		METRIC_IN_USE,
+		METRIC_IDLE;
+
+		static const unsigned DEFAULT_MAX_IDLE_SESSIONS=4,
+		DEFAULT_MAX_IDLE_TIME=300,
+		DEFAULT_MAX_USED_SESSIONS=0;
+
+		//! \brief Enables/disables the reuse of sessions. Disabling the pool closes all the idle sessions
+		static void setEnabled(bool value);
+
+		//! \brief Returns if the reuse of sessions is enabled
+		static bool isEnabled(void);
+
+		//! \brief Defines the maximum amount of idle sessions kept for each server
+		static void setMaxIdleSessions(unsigned max_sessions);
+
+		//! \brief Defines the maximum time (in seconds) that a session can stay idle in the pool
+		static void setMaxIdleTime(unsigned max_time);
+
+		//! \brief Defines the maximum amount of sessions in use for each server (zero means no limit)
+		static void setMaxUsedSessions(unsigned max_sessions);
+
+		/*! \brief Reserves a session of the server. This must be called before acquiring or opening a session. When the server
+		reached the maximum amount of sessions in use an error is raised immediately since the connections are mostly opened
+		from the GUI thread which can't be blocked waiting for another session to be released. Each reservation must be
+		undone by a call to releaseSession() */
+		static void reserveSession(const QString &server_id);
+
+		/*! \brief Returns an idle session of the server opened with the same connection string and notice mode.
+		Returns nullptr if there's no session available so the caller must open a new one */
+		static PGconn *acquireSession(const QString &server_id, const QString &conn_str, bool notice_enabled);
+
+		//! \brief Registers a session opened by the caller so it's accounted in the metrics
+		static void registerSession(void);
+
+		/*! \brief Returns a session to the pool undoing the reservation made by reserveSession(). The session is closed if it can't
+		be reused, if the pool is disabled or if the server already has the maximum amount of idle sessions (in that case the oldest
+		one is closed). A null session only undoes the reservation (e.g. when the connection could not be stablished) */
+		static void releaseSession(const QString &server_id, const QString &conn_str, const QString &db_name, bool notice_enabled, PGconn *conn);
+
+		/*! \brief Closes the idle sessions of the specified server or all of them if the server is not specified.
+		This is needed prior to commands that require the absence of other sessions in any database (e.g. CREATE DATABASE
+		which copies a template database) */
+		static void clear(const QString &server_id=QString());
+
+		/*! \brief Closes the idle sessions connected to the specified database in any server. This is needed prior to commands
+		that require the absence of other sessions in the database (e.g. DROP DATABASE, ALTER DATABASE ... RENAME) */
+		static void clearIdleSessions(const QString &db_name);
+
+		//! \brief Returns the pool metrics (amount of sessions created, reused, released, discarded, in use and idle)
+		static attribs_map getMetrics(void);
+};
+
+#endif
@@ -0,0 +1,380 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2016 - Raphael Araújo e Silva <raphael@pgmodeler.com.br>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "queryexecutor.h"
+#include <QTextStream>
+
+QueryExecutor::QueryExecutor(QObject *parent) : QObject(parent)
+{
+	connection=nullptr;
+	read_notifier=write_notifier=nullptr;
+	batch_res=nullptr;
+	batch_rows=0;
+	batch_size=Connection::DEFAULT_BATCH_SIZE;
+	max_rows=row_count=0;
+	first_batch=true;
+	cancelled=false;
+	copy_device=nullptr;
+	copying=false;
+	copied_bytes=0;
+}
+
+QueryExecutor::~QueryExecutor(void)
+{
+	if(isRunning())
+	{
+		PGresult *sql_res=nullptr;
+
+		//Cancels the command and waits the server to finish it so the connection can be reused
+		cancel();
+		read_notifier->setEnabled(false);
+		destroyWriteNotifier();
+
+		//Restoring the blocking mode (this also sends the remaining data of the command) before waiting the results
+		PQsetnonblocking(connection->connection, 0);
+
+		while((sql_res=PQgetResult(connection->connection)))
+			PQclear(sql_res);
+
+		if(batch_res)
+			PQclear(batch_res);
+
+		delete(read_notifier);
+	}
+}
+
+void QueryExecutor::execute(Connection &conn, const QString &sql, unsigned batch_size, unsigned max_rows)
+{
+	if(isRunning())
+		throw Exception(ERR_CMD_ALREADY_RUNNING, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	if(!conn.connection)
+		throw Exception(ERR_OPR_NOT_ALOC_CONN, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	try
+	{
+		conn.validateConnectionStatus();
+		Connection::clearNotices();
+		conn.clearIdleSessions(sql);
+
+		//The command is sent in non-blocking mode so the sending doesn't wait the server to accept all the data
+		PQsetnonblocking(conn.connection, 1);
+
+		if(!PQsendQuery(conn.connection, sql.toStdString().c_str()))
+		{
+			PQsetnonblocking(conn.connection, 0);
+			throw Exception(QString(Exception::getErrorMessage(ERR_CMD_SQL_NOT_EXECUTED))
+							.arg(PQerrorMessage(conn.connection)),
+							ERR_CMD_SQL_NOT_EXECUTED, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+		}
+
+		PQsetSingleRowMode(conn.connection);
+
+		//Prints the SQL to stdout when the flag is active
+		if(Connection::print_sql)
+		{
+			QTextStream out(stdout);
+			out << QString("\n---\n") << sql << endl;
+		}
+
+		connection=&conn;
+		this->batch_size=(batch_size==0 ? Connection::DEFAULT_BATCH_SIZE : batch_size);
+		this->max_rows=max_rows;
+		row_count=0;
+		batch_rows=0;
+		first_batch=true;
+		cancelled=false;
+		copying=false;
+		copied_bytes=0;
+		error.clear();
+		sql_state.clear();
+
+		read_notifier=new QSocketNotifier(PQsocket(conn.connection), QSocketNotifier::Read, this);
+		connect(read_notifier, SIGNAL(activated(int)), this, SLOT(readResults()));
+
+		/* When the command could not be sent at once (e.g. a large script) the remaining data is sent
+		as soon as the socket can receive it, so the event loop is not blocked meanwhile */
+		if(PQflush(conn.connection)==1)
+		{
+			write_notifier=new QSocketNotifier(PQsocket(conn.connection), QSocketNotifier::Write, this);
+			connect(write_notifier, SIGNAL(activated(int)), this, SLOT(flushCommand()));
+		}
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void QueryExecutor::cancel(void)
+{
+	if(isRunning() && !cancelled)
+	{
+		cancelled=true;
+		connection->cancelCommand();
+	}
+}
+
+void QueryExecutor::setCopyDevice(QIODevice *device)
+{
+	if(isRunning())
+		throw Exception(ERR_CMD_ALREADY_RUNNING, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	copy_device=device;
+}
+
+bool QueryExecutor::readCopyData(void)
+{
+	char *buffer=nullptr;
+	int len=0;
+	qint64 prev_bytes=copied_bytes;
+
+	//Reading the rows of COPY data already received without blocking (async mode)
+	while((len=PQgetCopyData(connection->connection, &buffer, 1)) > 0)
+	{
+		if(!cancelled && copy_device && copy_device->write(buffer, len)!=len)
+		{
+			if(error.isEmpty())
+				error=copy_device->errorString();
+
+			cancel();
+		}
+
+		PQfreemem(buffer);
+		copied_bytes+=len;
+	}
+
+	if(copied_bytes!=prev_bytes && !cancelled)
+		emit s_copyProgressed(copied_bytes);
+
+	//Zero means that there is no more data available for now, the remaining data is read in the next notification
+	if(len==0)
+		return(false);
+
+	//An error while receiving the data (-2)
+	if(len==-2 && error.isEmpty())
+		error=PQerrorMessage(connection->connection);
+
+	//The end of COPY data (-1): the final result of the command is retrieved by PQgetResult()
+	copying=false;
+	return(true);
+}
+
+void QueryExecutor::flushCommand(void)
+{
+	int res=PQflush(connection->connection);
+
+	//All the data was sent, from now on only the results are monitored
+	if(res==0)
+		destroyWriteNotifier();
+	//The sending failed, in this case the connection is probably lost
+	else if(res < 0)
+	{
+		if(error.isEmpty())
+			error=PQerrorMessage(connection->connection);
+
+		finishExecution();
+	}
+}
+
+void QueryExecutor::destroyWriteNotifier(void)
+{
+	if(write_notifier)
+	{
+		//The notifier is destroyed later since this method can be called from a slot connected to it
+		write_notifier->setEnabled(false);
+		write_notifier->deleteLater();
+		write_notifier=nullptr;
+	}
+}
+
+bool QueryExecutor::isRunning(void)
+{
+	return(read_notifier!=nullptr);
+}
+
+void QueryExecutor::deliverBatch(PGresult *pg_res)
+{
+	ResultSet res(pg_res);
+	bool first=first_batch;
+
+	first_batch=false;
+
+	if(!cancelled)
+		emit s_batchReceived(res, first);
+}
+
+void QueryExecutor::readResults(void)
+{
+	PGconn *pg_conn=connection->connection;
+	PGresult *sql_res=nullptr;
+	ExecStatusType status;
+
+	try
+	{
+		//Reading the data available in the socket. A failure here means that the connection was lost
+		if(!PQconsumeInput(pg_conn))
+		{
+			error=PQerrorMessage(pg_conn);
+			finishExecution();
+			return;
+		}
+
+		//Writing the COPY data received to the device until the end of data is reached
+		if(copying && !readCopyData())
+			return;
+
+		//Processing only the results completely received, the others are processed on the next notification
+		while(!PQisBusy(pg_conn))
+		{
+			sql_res=PQgetResult(pg_conn);
+
+			//A null result indicates that the command has finished
+			if(!sql_res)
+			{
+				if(batch_res)
+				{
+					deliverBatch(batch_res);
+					batch_res=nullptr;
+				}
+
+				finishExecution();
+				return;
+			}
+
+			status=PQresultStatus(sql_res);
+
+			/* The COPY data must be consumed even if the command was cancelled otherwise the
+			connection keeps in COPY state (the data received after the cancelling is discarded) */
+			if(status==PGRES_COPY_OUT)
+			{
+				PQclear(sql_res);
+
+				if(!copy_device && !cancelled)
+				{
+					error=trUtf8("There is no device to store the data returned by the COPY command!");
+					cancel();
+				}
+
+				copying=true;
+
+				if(!readCopyData())
+					return;
+			}
+			else if(status==PGRES_COPY_IN)
+			{
+				//COPY FROM STDIN commands aren't supported by the executor so the data sending is aborted
+				PQclear(sql_res);
+				PQputCopyEnd(pg_conn, "COPY FROM STDIN is not supported in asynchronous execution");
+			}
+			//After the command being cancelled the remaining results are only discarded
+			else if(cancelled)
+				PQclear(sql_res);
+			else if(status==PGRES_SINGLE_TUPLE)
+			{
+				Connection::appendTuple(sql_res, batch_res, batch_rows);
+				PQclear(sql_res);
+				row_count++;
+
+				if(static_cast<unsigned>(batch_rows) >= batch_size || (max_rows > 0 && row_count >= max_rows))
+				{
+					deliverBatch(batch_res);
+					batch_res=nullptr;
+					batch_rows=0;
+				}
+
+				if(max_rows > 0 && row_count >= max_rows)
+					cancel();
+			}
+			else if(status==PGRES_FATAL_ERROR || status==PGRES_BAD_RESPONSE || status==PGRES_NONFATAL_ERROR)
+			{
+				if(error.isEmpty())
+				{
+					error=PQresultErrorMessage(sql_res);
+					sql_state=PQresultErrorField(sql_res, PG_DIAG_SQLSTATE);
+				}
+
+				PQclear(sql_res);
+			}
+			else
+			{
+				//Delivering the remaining rows of the current statement
+				if(batch_res)
+				{
+					deliverBatch(batch_res);
+					batch_res=nullptr;
+					batch_rows=0;
+				}
+
+				/* The final result of a statement in single-row mode has no tuples. It is delivered only
+				if no row was returned so the receivers can know the columns or the amount of affected rows */
+				if(first_batch || PQntuples(sql_res) > 0)
+				{
+					row_count+=PQntuples(sql_res);
+					deliverBatch(sql_res);
+				}
+				else
+					PQclear(sql_res);
+
+				//The next result (if any) belongs to another statement in the command
+				first_batch=true;
+			}
+		}
+	}
+	catch(Exception &e)
+	{
+		//Errors raised by the receivers cancel the command and are reported when the execution finishes
+		if(error.isEmpty())
+			error=e.getErrorMessage();
+
+		cancel();
+	}
+}
+
+void QueryExecutor::finishExecution(void)
+{
+	Exception exec_error;
+	bool failed=!error.isEmpty();
+	unsigned rows=row_count;
+
+	if(failed)
+	{
+		exec_error=Exception(QString(Exception::getErrorMessage(ERR_CMD_SQL_NOT_EXECUTED)).arg(error),
+												 ERR_CMD_SQL_NOT_EXECUTED, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, sql_state);
+	}
+
+	if(batch_res)
+	{
+		PQclear(batch_res);
+		batch_res=nullptr;
+	}
+
+	destroyWriteNotifier();
+	PQsetnonblocking(connection->connection, 0);
+	connection=nullptr;
+
+	//The notifier is destroyed later since this method is called from a slot connected to it
+	read_notifier->setEnabled(false);
+	read_notifier->deleteLater();
+	read_notifier=nullptr;
+
+	if(failed)
+		emit s_executionFailed(exec_error);
+	else
+		emit s_executionFinished(rows, !cancelled);
+}
@@ -0,0 +1,140 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2016 - Raphael Araújo e Silva <raphael@pgmodeler.com.br>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libpgconnector
+\class QueryExecutor
+\brief Runs SQL commands asynchronously using the non-blocking functions of libpq. The command is sent to the server and
+the results are read only when the connection's socket has data available (monitored through a socket notifier), so the
+event loop of the thread that owns the executor is never blocked while the server processes the command. The returned
+rows are delivered in batches through signals emitted in the thread that owns the executor, thus, the receivers can update
+the UI directly. The data of COPY ... TO STDOUT commands is written directly to a device (see setCopyDevice()) as it's received. Since each executor handles its own connection several commands can run at the same time.
+*/
+
+#ifndef QUERY_EXECUTOR_H
+#define QUERY_EXECUTOR_H
+
+#include "connection.h"
+#include <QObject>
+#include <QSocketNotifier>
+#include <QIODevice>
+
+class QueryExecutor: public QObject {
+	private:
+		Q_OBJECT
+
+		//! \brief Connection in which the current command is running
+		Connection *connection;
+
+		//! \brief Notifies when there are results to be read from the connection's socket
+		QSocketNotifier *read_notifier,
+
+		/*! \brief Notifies when the connection's socket can receive more data. Used only while the command
+		is not completely sent to the server (see flushCommand()) */
+		*write_notifier;
+
+		//! \brief Result in which the rows received in single-row mode are grouped before being delivered
+		PGresult *batch_res;
+
+		//! \brief Amount of rows in the current batch
+		int batch_rows;
+
+		//! \brief Maximum amount of rows per batch
+		unsigned batch_size,
+
+		//! \brief Maximum amount of rows to be delivered (zero means no limit)
+		max_rows,
+
+		//! \brief Amount of rows delivered by the current command
+		row_count;
+
+		/*! \brief Indicates that the next batch delivered is the first one of a statement's result,
+		and if the command was cancelled (by the user or by the rows limit) */
+		bool first_batch, cancelled;
+
+		//! \brief Error message and SQL state returned by the server
+		QString error, sql_state;
+
+		//! \brief Device in which the data of COPY ... TO STDOUT commands is written
+		QIODevice *copy_device;
+
+		//! \brief Indicates that the data of a COPY ... TO STDOUT command is being received
+		bool copying;
+
+		//! \brief Amount of bytes written in the copy device
+		qint64 copied_bytes;
+
+		/*! \brief Writes the COPY data available in the connection to the copy device. Returns false
+		when the data is not completely received yet, in this case, the reading must be done later */
+		bool readCopyData(void);
+
+		/*! \brief Delivers the rows of the result emitting s_batchReceived(). The result is freed after that
+		unless a receiver takes it through ResultSet::swap() */
+		void deliverBatch(PGresult *pg_res);
+
+		//! \brief Stops monitoring the connection and emits the signal related to the execution status
+		void finishExecution(void);
+
+		//! \brief Destroys the write notifier (if allocated)
+		void destroyWriteNotifier(void);
+
+	private slots:
+		/*! \brief Sends the remaining data of the command to the server without blocking. This slot is called each
+		time the socket can receive more data until the whole command is sent */
+		void flushCommand(void);
+
+		//! \brief Reads the results available in the connection processing them without blocking
+		void readResults(void);
+
+	public:
+		QueryExecutor(QObject *parent=nullptr);
+		~QueryExecutor(void);
+
+		/*! \brief Sends the command to the server and returns immediately. The results are delivered in batches of batch_size rows
+		by the signal s_batchReceived() and the end of the execution is informed by s_executionFinished() or s_executionFailed().
+		The max_rows limits the amount of rows delivered (zero means no limit), when reached the command is cancelled.
+		The connection must be stablished and can't be used by other objects until the execution finishes */
+		void execute(Connection &conn, const QString &sql, unsigned batch_size=Connection::DEFAULT_BATCH_SIZE, unsigned max_rows=0);
+
+		//! \brief Requests the server to cancel the running command. The pending results are discarded
+		void cancel(void);
+
+		/*! \brief Defines the device in which the data of COPY ... TO STDOUT commands is written. The device must be opened
+		and must exist until the command finishes. Running a COPY TO STDOUT without a device causes an error */
+		void setCopyDevice(QIODevice *device);
+
+		//! \brief Returns if there is a command running
+		bool isRunning(void);
+
+	signals:
+		/*! \brief Signal emitted when a batch of rows is received. The second parameter indicates that the batch is the first one of a
+		statement's result. Results without tuples (e.g. INSERT, UPDATE) are delivered as empty result sets */
+		void s_batchReceived(ResultSet &res, bool first_batch);
+
+		/*! \brief Signal emitted when the command finishes. The parameters are the amount of rows delivered and
+		if the all the rows were delivered (false when the command was cancelled) */
+		void s_executionFinished(unsigned rows, bool completed);
+
+		//! \brief Signal emitted when the command fails
+		void s_executionFailed(Exception e);
+
+		//! \brief Signal emitted each time data of a COPY command is written to the copy device. The parameter is the total of bytes written
+		void s_copyProgressed(qint64 bytes);
+};
+
+#endif
@@ -17,6 +17,10 @@
 */
 
 #include "resultset.h"
+#include <QtEndian>
+#include <cstring>
+#include <limits>
+#include <utility>
 
 ResultSet::ResultSet(void)
 {
@@ -58,7 +62,7 @@ ResultSet::ResultSet(PGresult *sql_result)
 		case PGRES_COPY_OUT:
 		case PGRES_COPY_IN:
 		default:
-			empty_result=(res_state!=PGRES_TUPLES_OK && res_state!=PGRES_EMPTY_QUERY);
+			empty_result=(res_state!=PGRES_TUPLES_OK && res_state!=PGRES_SINGLE_TUPLE && res_state!=PGRES_EMPTY_QUERY);
 			current_tuple=-1;
 			is_res_copied=false;
 		break;
@@ -163,6 +167,358 @@ char *ResultSet::getColumnValue(int column_idx)
 	return(PQgetvalue(sql_result, current_tuple, column_idx));
 }
 
+char *ResultSet::getColumnValue(int tuple_idx, int column_idx)
+{
+	//Raise an error in case the column index is invalid
+	if(column_idx < 0 || column_idx >= getColumnCount())
+		throw Exception(ERR_REF_TUPLE_COL_INV_INDEX, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+	else if(empty_result || tuple_idx < 0 || tuple_idx >= getTupleCount())
+		throw Exception(ERR_REF_TUPLE_INEXISTENT, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	return(PQgetvalue(sql_result, tuple_idx, column_idx));
+}
+
+bool ResultSet::isColumnValueNull(int tuple_idx, int column_idx)
+{
+	//Raise an error in case the column index is invalid
+	if(column_idx < 0 || column_idx >= getColumnCount())
+		throw Exception(ERR_REF_TUPLE_COL_INV_INDEX, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+	else if(empty_result || tuple_idx < 0 || tuple_idx >= getTupleCount())
+		throw Exception(ERR_REF_TUPLE_INEXISTENT, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	return(PQgetisnull(sql_result, tuple_idx, column_idx)==1);
+}
+
+const char *ResultSet::getRawValue(int tuple_idx, int column_idx, int &length, const QString &type_name)
+{
+	//Raise an error in case the column index is invalid
+	if(column_idx < 0 || column_idx >= getColumnCount())
+		throw Exception(ERR_REF_TUPLE_COL_INV_INDEX, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+	else if(empty_result || tuple_idx < 0 || tuple_idx >= getTupleCount())
+		throw Exception(ERR_REF_TUPLE_INEXISTENT, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+	else if(PQgetisnull(sql_result, tuple_idx, column_idx))
+		throw Exception(Exception::getErrorMessage(ERR_COL_VALUE_NOT_CONVERTED)
+										.arg(getColumnName(column_idx)).arg(tuple_idx).arg(type_name),
+										ERR_COL_VALUE_NOT_CONVERTED, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	length=PQgetlength(sql_result, tuple_idx, column_idx);
+	return(PQgetvalue(sql_result, tuple_idx, column_idx));
+}
+
+qint64 ResultSet::getIntegerValue(int tuple_idx, int column_idx)
+{
+	int length=0;
+	const char *value=getRawValue(tuple_idx, column_idx, length, QString("integer"));
+	const uchar *data=reinterpret_cast<const uchar *>(value);
+	unsigned type_id=PQftype(sql_result, column_idx);
+	bool ok=true;
+	qint64 int_val=0;
+
+	if(PQfformat(sql_result, column_idx)==0)
+		int_val=QByteArray::fromRawData(value, length).toLongLong(&ok);
+	//Binary values are sent in network byte order
+	else if(type_id==INT2OID && length==2)
+		int_val=qFromBigEndian<qint16>(data);
+	else if(type_id==INT4OID && length==4)
+		int_val=qFromBigEndian<qint32>(data);
+	else if(type_id==OIDOID && length==4)
+		int_val=qFromBigEndian<quint32>(data);
+	else if(type_id==INT8OID && length==8)
+		int_val=qFromBigEndian<qint64>(data);
+	else
+		ok=false;
+
+	if(!ok)
+		throw Exception(Exception::getErrorMessage(ERR_COL_VALUE_NOT_CONVERTED)
+										.arg(getColumnName(column_idx)).arg(tuple_idx).arg(QString("integer")),
+										ERR_COL_VALUE_NOT_CONVERTED, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	return(int_val);
+}
+
+int ResultSet::getInt32(int tuple_idx, int column_idx)
+{
+	try
+	{
+		qint64 int_val=getIntegerValue(tuple_idx, column_idx);
+
+		//Values of int8 columns that don't fit in 32 bits are not truncated
+		if(int_val < std::numeric_limits<qint32>::min() || int_val > std::numeric_limits<qint32>::max())
+			throw Exception(Exception::getErrorMessage(ERR_COL_VALUE_NOT_CONVERTED)
+											.arg(getColumnName(column_idx)).arg(tuple_idx).arg(QString("integer")),
+											ERR_COL_VALUE_NOT_CONVERTED, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+		return(static_cast<int>(int_val));
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorType(), __PRETTY_FUNCTION__, __FILE__, __LINE__, &e);
+	}
+}
+
+qint64 ResultSet::getInt64(int tuple_idx, int column_idx)
+{
+	try
+	{
+		return(getIntegerValue(tuple_idx, column_idx));
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorType(), __PRETTY_FUNCTION__, __FILE__, __LINE__, &e);
+	}
+}
+
+unsigned ResultSet::getOid(int tuple_idx, int column_idx)
+{
+	try
+	{
+		qint64 int_val=getIntegerValue(tuple_idx, column_idx);
+
+		if(int_val < 0 || int_val > std::numeric_limits<quint32>::max())
+			throw Exception(Exception::getErrorMessage(ERR_COL_VALUE_NOT_CONVERTED)
+											.arg(getColumnName(column_idx)).arg(tuple_idx).arg(QString("oid")),
+											ERR_COL_VALUE_NOT_CONVERTED, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+		return(static_cast<unsigned>(int_val));
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorType(), __PRETTY_FUNCTION__, __FILE__, __LINE__, &e);
+	}
+}
+
+bool ResultSet::getBool(int tuple_idx, int column_idx)
+{
+	int length=0;
+	const char *value=getRawValue(tuple_idx, column_idx, length, QString("boolean"));
+
+	if(length!=1 || (PQfformat(sql_result, column_idx)==0 && value[0]!='t' && value[0]!='f'))
+		throw Exception(Exception::getErrorMessage(ERR_COL_VALUE_NOT_CONVERTED)
+										.arg(getColumnName(column_idx)).arg(tuple_idx).arg(QString("boolean")),
+										ERR_COL_VALUE_NOT_CONVERTED, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	//In text format booleans are represented as t/f and in binary as 1/0
+	return(PQfformat(sql_result, column_idx)==0 ? value[0]=='t' : value[0]!=0);
+}
+
+double ResultSet::getDouble(int tuple_idx, int column_idx)
+{
+	int length=0;
+	const char *value=getRawValue(tuple_idx, column_idx, length, QString("double precision"));
+	unsigned type_id=PQftype(sql_result, column_idx);
+	bool ok=true;
+	double dbl_val=0;
+
+	if(PQfformat(sql_result, column_idx)==0)
+		dbl_val=QByteArray::fromRawData(value, length).toDouble(&ok);
+	else if((type_id==FLOAT4OID && length==4) || (type_id==FLOAT8OID && length==8))
+		dbl_val=decodeBinaryValue(value, length, type_id).toDouble(&ok);
+	else
+	{
+		try
+		{
+			//Binary integers are accepted as well
+			dbl_val=getIntegerValue(tuple_idx, column_idx);
+		}
+		catch(Exception &)
+		{
+			ok=false;
+		}
+	}
+
+	if(!ok)
+		throw Exception(Exception::getErrorMessage(ERR_COL_VALUE_NOT_CONVERTED)
+										.arg(getColumnName(column_idx)).arg(tuple_idx).arg(QString("double precision")),
+										ERR_COL_VALUE_NOT_CONVERTED, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	return(dbl_val);
+}
+
+QByteArray ResultSet::getBytea(int tuple_idx, int column_idx)
+{
+	int length=0;
+	const char *value=getRawValue(tuple_idx, column_idx, length, QString("bytea"));
+	unsigned char *unescaped=nullptr;
+	size_t unesc_len=0;
+	QByteArray bytes;
+
+	if(PQfformat(sql_result, column_idx)==1)
+		return(QByteArray(value, length));
+
+	unescaped=PQunescapeBytea(reinterpret_cast<const unsigned char *>(value), &unesc_len);
+
+	if(unescaped)
+	{
+		bytes=QByteArray(reinterpret_cast<const char *>(unescaped), static_cast<int>(unesc_len));
+		PQfreemem(unescaped);
+	}
+
+	return(bytes);
+}
+
+QStringList ResultSet::getArray(int tuple_idx, int column_idx)
+{
+	int length=0;
+	const char *value=getRawValue(tuple_idx, column_idx, length, QString("array"));
+	QStringList elems;
+
+	if(PQfformat(sql_result, column_idx)==1)
+	{
+		/* Binary arrays are formed by a header (dimensions count, null flag, element type), the size and lower bound
+		of each dimension followed by the elements, each one prefixed by its length (-1 for nulls) */
+		const uchar *data=reinterpret_cast<const uchar *>(value), *end=data + length;
+		int ndims=0, elem_len=0;
+		qint64 elem_cnt=1;
+		unsigned elem_type=0;
+		bool malformed=(length < 12);
+
+		if(!malformed)
+		{
+			ndims=qFromBigEndian<qint32>(data);
+			elem_type=qFromBigEndian<quint32>(data + 8);
+			data+=12;
+			malformed=(ndims < 0 || end - data < static_cast<qint64>(ndims) * 8);
+		}
+
+		if(!malformed && ndims==0)
+			return(elems);
+
+		//Multidimensional arrays have their elements returned in storage order
+		for(int dim=0; !malformed && dim < ndims; dim++, data+=8)
+		{
+			elem_cnt*=qFromBigEndian<qint32>(data);
+			malformed=(elem_cnt < 0 || elem_cnt > length);
+		}
+
+		//Each element length is validated against the remaining data so a malformed value doesn't cause reads beyond the buffer
+		for(qint64 i=0; !malformed && i < elem_cnt; i++)
+		{
+			malformed=(end - data < 4);
+
+			if(!malformed)
+			{
+				elem_len=qFromBigEndian<qint32>(data);
+				data+=4;
+
+				if(elem_len < 0)
+					elems.push_back(QString());
+				else if(end - data < elem_len)
+					malformed=true;
+				else
+				{
+					elems.push_back(decodeBinaryValue(reinterpret_cast<const char *>(data), elem_len, elem_type));
+					data+=elem_len;
+				}
+			}
+		}
+
+		if(malformed)
+			throw Exception(Exception::getErrorMessage(ERR_COL_VALUE_NOT_CONVERTED)
+											.arg(getColumnName(column_idx)).arg(tuple_idx).arg(QString("array")),
+											ERR_COL_VALUE_NOT_CONVERTED, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+	}
+	else
+	{
+		QByteArray elem;
+		bool quoted=false, in_quotes=false;
+
+		//Parsing the text representation, e.g., {a,"b c",NULL}, nested braces are ignored
+		for(int i=0; i < length; i++)
+		{
+			if(in_quotes)
+			{
+				if(value[i]=='\\' && i + 1 < length)
+					elem+=value[++i];
+				else if(value[i]=='"')
+					in_quotes=false;
+				else
+					elem+=value[i];
+			}
+			else if(value[i]=='"')
+				in_quotes=quoted=true;
+			else if(value[i]==',' || value[i]=='}')
+			{
+				if(value[i]==',' || quoted || !elem.isEmpty())
+				{
+					if(!quoted && elem.toUpper()=="NULL")
+						elems.push_back(QString());
+					else
+						elems.push_back(QString::fromUtf8(elem));
+				}
+
+				elem.clear();
+				quoted=false;
+			}
+			else if(value[i]!='{')
+				elem+=value[i];
+		}
+	}
+
+	return(elems);
+}
+
+QString ResultSet::decodeBinaryValue(const char *value, int length, unsigned type_id)
+{
+	const uchar *data=reinterpret_cast<const uchar *>(value);
+
+	if(type_id==BOOLOID && length==1)
+		return(value[0]!=0 ? QString("t") : QString("f"));
+	else if(type_id==INT2OID && length==2)
+		return(QString::number(qFromBigEndian<qint16>(data)));
+	else if(type_id==INT4OID && length==4)
+		return(QString::number(qFromBigEndian<qint32>(data)));
+	else if(type_id==OIDOID && length==4)
+		return(QString::number(qFromBigEndian<quint32>(data)));
+	else if(type_id==INT8OID && length==8)
+		return(QString::number(qFromBigEndian<qint64>(data)));
+	else if(type_id==FLOAT4OID && length==4)
+	{
+		quint32 bits=qFromBigEndian<quint32>(data);
+		float flt_val;
+
+		memcpy(&flt_val, &bits, sizeof(float));
+		return(QString::number(flt_val));
+	}
+	else if(type_id==FLOAT8OID && length==8)
+	{
+		quint64 bits=qFromBigEndian<quint64>(data);
+		double dbl_val;
+
+		memcpy(&dbl_val, &bits, sizeof(double));
+		return(QString::number(dbl_val, 'g', 17));
+	}
+	else if(type_id==BYTEAOID)
+		return(QString("\\x") + QString(QByteArray(value, length).toHex()));
+
+	//Textual types (text, varchar, name, char...) are sent as they are
+	return(QString::fromUtf8(value, length));
+}
+
+QStringList ResultSet::getColumnValues(int column_idx)
+{
+	QStringList values;
+	int tup_count=(empty_result ? 0 : getTupleCount());
+	bool binary_fmt=false;
+
+	//Raise an error in case the column index is invalid
+	if(column_idx < 0 || column_idx >= getColumnCount())
+		throw Exception(ERR_REF_TUPLE_COL_INV_INDEX, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	values.reserve(tup_count);
+	binary_fmt=(PQfformat(sql_result, column_idx)==1);
+
+	for(int tup=0; tup < tup_count; tup++)
+	{
+		if(binary_fmt && !PQgetisnull(sql_result, tup, column_idx))
+			values.push_back(decodeBinaryValue(PQgetvalue(sql_result, tup, column_idx),
+																				 PQgetlength(sql_result, tup, column_idx), PQftype(sql_result, column_idx)));
+		else
+			values.push_back(QString(PQgetvalue(sql_result, tup, column_idx)));
+	}
+
+	return(values);
+}
+
 int ResultSet::getColumnSize(const QString &column_name)
 {
 	int col_idx=-1;
@@ -334,3 +690,11 @@ void ResultSet::operator = (ResultSet &res)
 	this->is_res_copied=false;
 }
 
+
+void ResultSet::swap(ResultSet &res)
+{
+	std::swap(this->sql_result, res.sql_result);
+	std::swap(this->is_res_copied, res.is_res_copied);
+	std::swap(this->empty_result, res.empty_result);
+	std::swap(this->current_tuple, res.current_tuple);
+}
@@ -30,11 +30,19 @@ It the resultset contains data the user must call ResultSet::accessTuple() to ac
 #include "exception.h"
 #include "attribsmap.h"
 #include <libpq-fe.h>
+#include <QStringList>
 #include <cstdlib>
 #include <iostream>
 
-//This constant is defined on PostgreSQL source code src/catalog/pg_type.h
+//These constants are defined on PostgreSQL source code src/catalog/pg_type.h
+#define BOOLOID 16
 #define BYTEAOID 17
+#define INT8OID 20
+#define INT2OID 21
+#define INT4OID 23
+#define OIDOID 26
+#define FLOAT4OID 700
+#define FLOAT8OID 701
 
 class ResultSet {
 	private:
@@ -48,6 +56,17 @@ class ResultSet {
 
 		void destroyResultSet(void);
 
+		/*! \brief Returns the raw value of the column in the specified tuple validating the indexes and raising an error if the
+		value is null (the type name is used in the error message). The value length is returned in the parameter length */
+		const char *getRawValue(int tuple_idx, int column_idx, int &length, const QString &type_name);
+
+		/*! \brief Converts the value of a column to integer. Binary values are decoded according to the column type
+		(int2, int4, int8 or oid) and text values are parsed */
+		qint64 getIntegerValue(int tuple_idx, int column_idx);
+
+		//! \brief Decodes a single value in binary format according to its type returning its text representation
+		static QString decodeBinaryValue(const char *value, int length, unsigned type_id);
+
 	protected:
 		//! \brief Stores the current tuple index, just for navigation
 		int current_tuple;
@@ -77,6 +96,32 @@ class ResultSet {
 		char *getColumnValue(const QString &column_name);
 		char *getColumnValue(int column_idx);
 
+		/*! \brief Returns the value of a column in the specified tuple without changing the current tuple.
+		This method is intended to random access of the values, e.g., by item views that read only the visible cells */
+		char *getColumnValue(int tuple_idx, int column_idx);
+
+		//! \brief Returns if the value of a column in the specified tuple is null
+		bool isColumnValueNull(int tuple_idx, int column_idx);
+
+		/*! \brief Typed accessors that return the value of a column in the specified tuple without changing the current tuple.
+		The values are decoded directly when the result is in binary format (see Connection::executeDMLCommand()) and parsed when
+		it's in text format. An error is raised if the value is null or can't be converted to the requested type */
+		int getInt32(int tuple_idx, int column_idx);
+		qint64 getInt64(int tuple_idx, int column_idx);
+		unsigned getOid(int tuple_idx, int column_idx);
+		bool getBool(int tuple_idx, int column_idx);
+		double getDouble(int tuple_idx, int column_idx);
+
+		//! \brief Returns the contents of a bytea column (unescaped when in text format)
+		QByteArray getBytea(int tuple_idx, int column_idx);
+
+		//! \brief Returns the elements of a one-dimensional array column. Null elements are returned as null strings
+		QStringList getArray(int tuple_idx, int column_idx);
+
+		/*! \brief Returns all the values of a column in tuple order. This method and the index based accessors
+		avoid the creation of a map per tuple when only some columns are needed (see getTupleValues()) */
+		QStringList getColumnValues(int column_idx);
+
 		//! \brief Returns the data allocated size of a column (searching by name or index)
 		int getColumnSize(const QString &column_name);
 		int getColumnSize(int column_idx);
@@ -117,6 +162,10 @@ class ResultSet {
 		//! \brief Make a copy between two resultsets
 		void operator = (ResultSet &res);
 
+		/*! \brief Exchanges the result and the navigation state of two resultsets without copying the tuples.
+		This is the cheaper way to transfer a result to a resultset that outlives the original one */
+		void swap(ResultSet &res);
+
 		friend class Connection;
 };
 
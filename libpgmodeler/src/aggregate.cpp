@@ -161,6 +161,7 @@ void Aggregate::setTypesAttribute(unsigned def_type)
 void Aggregate::addDataType(PgSQLType type)
 {
 	data_types.push_back(type);
+	setSignatureChanged();
 	setCodeInvalidated(true);
 }
 
@@ -172,12 +173,14 @@ void Aggregate::removeDataType(unsigned type_idx)
 
 	//Removes the type at the specified position
 	data_types.erase(data_types.begin() + type_idx);
+	setSignatureChanged();
 	setCodeInvalidated(true);
 }
 
 void Aggregate::removeDataTypes(void)
 {
 	data_types.clear();
+	setSignatureChanged();
 	setCodeInvalidated(true);
 }
 
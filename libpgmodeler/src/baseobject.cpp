@@ -68,6 +68,7 @@ unsigned BaseObject::global_id=4000;
 
 QString BaseObject::pgsql_ver=PgSQLVersions::DEFAULT_VERSION;
 bool BaseObject::use_cached_code=true;
+thread_local bool BaseObject::reuse_reduced_code=false;
 
 BaseObject::BaseObject(void)
 {
@@ -362,6 +363,10 @@ void BaseObject::setName(const QString &name)
 	}
 
 	aux_name.remove('"');
+
+	if(this->obj_name!=aux_name)
+		setSignatureChanged();
+
 	setCodeInvalidated(this->obj_name!=aux_name);
 	this->obj_name=aux_name;
 }
@@ -489,6 +494,9 @@ void BaseObject::setSchema(BaseObject *schema)
 	else if(!acceptsSchema())
 		throw Exception(ERR_ASG_INV_SCHEMA_OBJECT,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
+	if(this->schema != schema)
+		setSignatureChanged();
+
 	setCodeInvalidated(this->schema != schema);
 	this->schema=schema;
 }
@@ -685,6 +693,20 @@ QString BaseObject::getCodeDefinition(unsigned def_type, bool reduced_form)
 	{
 		bool format=false;
 
+		/* The reduced form is requested by every object that references this one (e.g. schemas, owners, tablespaces).
+		In the code generation threads the cached code is returned so the shared objects aren't written concurrently */
+		if(reuse_reduced_code && reduced_form && def_type==SchemaParser::XML_DEFINITION)
+		{
+			code_def=getCachedCode(def_type, true);
+
+			if(!code_def.isEmpty())
+			{
+				//Discards any attribute configured by the derived classes before calling this method
+				clearAttributes();
+				return(code_def);
+			}
+		}
+
 		schparser.setPgSQLVersion(BaseObject::pgsql_ver);
 		attributes[ParsersAttributes::SQL_DISABLED]=(sql_disabled ? ParsersAttributes::_TRUE_ : QString());
 
@@ -869,7 +891,9 @@ void BaseObject::clearAttributes(void)
 
 	while(itr!=itr_end)
 	{
-		itr->second=QString();
+		//Only touches the attributes that are filled so cleaning an already clean object doesn't write on it
+		if(!itr->second.isEmpty())
+			itr->second=QString();
 		itr++;
 	}
 }
@@ -977,6 +1001,55 @@ void BaseObject::enableCachedCode(bool value)
 	use_cached_code=value;
 }
 
+bool BaseObject::isCachedCodeEnabled(void)
+{
+	return(use_cached_code);
+}
+
+void BaseObject::setReducedCodeReuse(bool value)
+{
+	reuse_reduced_code=value;
+}
+
+void BaseObject::getCachedCodes(QString &xml_code, QString &reduced_code, QString &sql_code, QString &pgsql_ver)
+{
+	xml_code=reduced_code=sql_code=pgsql_ver=QString();
+
+	if(use_cached_code && !code_invalidated)
+	{
+		xml_code=cached_code[SchemaParser::XML_DEFINITION];
+		reduced_code=cached_reduced_code;
+		sql_code=cached_code[SchemaParser::SQL_DEFINITION];
+
+		if(!sql_code.isEmpty())
+			pgsql_ver=schparser.getPgSQLVersion();
+	}
+}
+
+void BaseObject::restoreCachedCodes(const QString &xml_code, const QString &reduced_code, const QString &sql_code, const QString &pgsql_ver)
+{
+	if(!use_cached_code || obj_type==OBJ_DATABASE)
+		return;
+
+	cached_code[SchemaParser::XML_DEFINITION]=xml_code;
+	cached_reduced_code=reduced_code;
+	cached_code[SchemaParser::SQL_DEFINITION]=QString();
+
+	//The SQL code is only restored when the version used to generate it is valid
+	if(!sql_code.isEmpty() && !pgsql_ver.isEmpty())
+	{
+		try
+		{
+			schparser.setPgSQLVersion(pgsql_ver);
+			cached_code[SchemaParser::SQL_DEFINITION]=sql_code;
+		}
+		catch(Exception &)
+		{}
+	}
+
+	code_invalidated=false;
+}
+
 void BaseObject::operator = (BaseObject &obj)
 {
 	this->owner=obj.owner;
@@ -989,7 +1062,8 @@ void BaseObject::operator = (BaseObject &obj)
 	this->is_protected=obj.is_protected;
 	this->sql_disabled=obj.sql_disabled;
 	this->system_obj=obj.system_obj;
-	this->setCodeInvalidated(use_cached_code);
+	this->setCodeInvalidated(true);
+	this->setSignatureChanged();
 }
 
 void BaseObject::setCodeInvalidated(bool value)
@@ -1005,6 +1079,15 @@ void BaseObject::setCodeInvalidated(bool value)
 
 		code_invalidated=value;
 	}
+
+	if(value && database)
+		database->notifyObjectChanged(this);
+}
+
+void BaseObject::setSignatureChanged(void)
+{
+	if(database)
+		database->notifySignatureChanged(this);
 }
 
 bool BaseObject::isCodeInvalidated(void)
@@ -80,6 +80,11 @@ class BaseObject {
 		//! \brief Indicates the the cached code enabled
 		static bool use_cached_code;
 
+		/*! \brief Indicates that the cached reduced XML forms are returned instead of being generated again. This is
+		set per thread and only enabled by the code generation threads (see DatabaseModel::generateObjectsCode) so they
+		read the shared objects (schemas, roles, etc) instead of writing on them. The serial generation is not affected */
+		static thread_local bool reuse_reduced_code;
+
 		//! \brief Stores the database wich the object belongs
 		BaseObject *database;
 
@@ -199,6 +204,18 @@ class BaseObject {
 		//! \brief Clears all the attributes used by the SchemaParser
 		void clearAttributes(void);
 
+		/*! \brief Registers that the object's signature has changed. This method must be called by any setter that
+		changes the value returned by getSignature(). Objects that don't belong to a database model are ignored */
+		void setSignatureChanged(void);
+
+		/*! \brief Informs the database model that owns this object that the provided object (this one or one of its children)
+		was changed. The default implementation does nothing, DatabaseModel overrides it to keep its reference graph up to date */
+		virtual void notifyObjectChanged(BaseObject *) {}
+
+		/*! \brief Informs the database model that owns this object that the signature of the provided object was changed.
+		The default implementation does nothing, DatabaseModel overrides it to detect when its name lookup indexes are outdated */
+		virtual void notifySignatureChanged(BaseObject *) {}
+
 		/*! \brief Returns the cached code for the specified code type. This method returns an empty
 		 string in case of no code is cached */
 		QString getCachedCode(unsigned def_type, bool reduced_form);
@@ -442,6 +459,21 @@ class BaseObject {
 				of this class changes you need to call setCodeInvalidated() in order to force the update of the code cache */
 		static void enableCachedCode(bool value);
 
+		//! \brief Returns if the use of cached sql/xml code is enabled
+		static bool isCachedCodeEnabled(void);
+
+		//! \brief Enables the reuse of the cached reduced XML forms in the calling thread (see reuse_reduced_code)
+		static void setReducedCodeReuse(bool value);
+
+		/*! \brief Returns the cached codes of the object as well the PostgreSQL version used to generate the SQL code.
+		Empty strings are returned when the code is invalidated or when there is no code cached */
+		void getCachedCodes(QString &xml_code, QString &reduced_code, QString &sql_code, QString &pgsql_ver);
+
+		/*! \brief Restores the codes previously obtained via getCachedCodes() marking them as valid. This method
+		must be used only when it's certain that the codes correspond to the current state of the object.
+		This method has no effect when the cached code support is disabled */
+		void restoreCachedCodes(const QString &xml_code, const QString &reduced_code, const QString &sql_code, const QString &pgsql_ver);
+
 		/*! \brief Returns the valid object types in a vector. The types
 		BASE_OBJECT, TYPE_ATTRIBUTE and BASE_TABLE aren't included in return vector.
 		By default table objects (columns, trigger, constraints, etc) are included. To
@@ -52,6 +52,7 @@ void Cast::setDataType(unsigned type_idx, PgSQLType type)
 
 	//Configures the cast name (in form of signature: cast(src_type, dst_type) )
 	this->obj_name=QString("cast(%1,%2)").arg(~types[SRC_TYPE]).arg(~types[DST_TYPE]);
+	setSignatureChanged();
 }
 
 void Cast::setCastType(unsigned cast_type)
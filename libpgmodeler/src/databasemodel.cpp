@@ -18,8 +18,17 @@
 
 #include "databasemodel.h"
 #include "pgmodelerns.h"
+#include <QThread>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QtConcurrent>
 
 unsigned DatabaseModel::dbmodel_id=2000;
+bool DatabaseModel::use_ref_graph=true;
+bool DatabaseModel::use_parallel_codegen=true;
+bool DatabaseModel::use_code_cache=true;
+const QString DatabaseModel::CODE_CACHE_MAGIC=QString("pgmodeler-code-cache");
+QString DatabaseModel::code_cache_dir;
 
 DatabaseModel::DatabaseModel(void)
 {
@@ -38,6 +47,7 @@ DatabaseModel::DatabaseModel(void)
 	conn_limit=-1;
 	last_zoom=1;
 	loading_model=invalidated=append_at_eod=prepend_at_bod=false;
+	ref_graph_built=false;
 	attributes[ParsersAttributes::ENCODING]=QString();
 	attributes[ParsersAttributes::TEMPLATE_DB]=QString();
 	attributes[ParsersAttributes::CONN_LIMIT]=QString();
@@ -424,7 +434,18 @@ void DatabaseModel::__addObject(BaseObject *object, int obj_idx)
 	obj_list=getObjectList(object->getObjectType());
 
 	if(obj_idx < 0 || obj_idx >= static_cast<int>(obj_list->size()))
+	{
 		obj_list->push_back(object);
+
+		/* Appending the object to the indexes (when they are up to date) is enough since
+		the positions of the other objects in the list don't change */
+		if(positions_index.count(obj_type) &&
+				positions_index[obj_type].size()==static_cast<int>(obj_list->size()) - 1)
+		{
+			positions_index[obj_type][object]=obj_list->size() - 1;
+			addToNamesIndex(object);
+		}
+	}
 	else
 	{
 		if(obj_idx >=0 && idx < 0)
@@ -436,9 +457,19 @@ void DatabaseModel::__addObject(BaseObject *object, int obj_idx)
 			obj_list->insert((obj_list->begin() + idx), object);
 		else
 			obj_list->push_back(object);
+
+		//Inserting in the middle of the list shifts the positions of the subsequent objects
+		invalidateObjectsIndex(obj_type);
 	}
 
 	object->setDatabase(this);
+
+	if(ref_graph_built)
+	{
+		ref_graph_edges[object].clear();
+		ref_graph_changed.insert(object);
+	}
+
 	emit s_objectAdded(object);
 	this->setInvalidated(true);
 }
@@ -505,7 +536,21 @@ void DatabaseModel::__removeObject(BaseObject *object, int obj_idx, bool check_r
 				if(Permission::objectAcceptsPermission(obj_type))
 					removePermissions(object);
 
+				/* Removing the last object of the list doesn't affect the positions of the others
+				so it's only necessary to remove it from the indexes, otherwise, they're discarded */
+				if(obj_idx == static_cast<int>(obj_list->size()) - 1 &&
+						positions_index.count(obj_type) && positions_index[obj_type].remove(object) > 0)
+					removeFromNamesIndex(object);
+				else
+					invalidateObjectsIndex(obj_type);
+
 				obj_list->erase(obj_list->begin() + obj_idx);
+
+				if(ref_graph_built)
+				{
+					removeReferenceGraphEdges(object);
+					ref_graph_changed.erase(object);
+				}
 			}
 		}
 
@@ -569,6 +614,122 @@ vector<BaseObject *> DatabaseModel::getObjects(BaseObject *schema)
 	return(sel_list);
 }
 
+bool DatabaseModel::isIndexedType(ObjectType obj_type)
+{
+	return(obj_type!=OBJ_PERMISSION && getObjectList(obj_type)!=nullptr);
+}
+
+void DatabaseModel::updateObjectsIndex(ObjectType obj_type)
+{
+	vector<BaseObject *> *obj_list=getObjectList(obj_type);
+
+	if(!isIndexedType(obj_type))
+		return;
+
+	/* The indexes are rebuilt when they don't exist or when the list was changed without
+	passing through __addObject/__removeObject */
+	if(positions_index.count(obj_type)==0 ||
+			positions_index[obj_type].size()!=static_cast<int>(obj_list->size()))
+	{
+		QHash<BaseObject *, int> &positions=positions_index[obj_type];
+		int idx=0;
+
+		names_index[obj_type].clear();
+		signatures_index[obj_type].clear();
+		dup_signatures[obj_type]=0;
+		positions.clear();
+		names_index[obj_type].reserve(obj_list->size());
+		signatures_index[obj_type].reserve(obj_list->size());
+		positions.reserve(obj_list->size());
+
+		for(auto &object : *obj_list)
+		{
+			addToNamesIndex(object);
+			positions[object]=idx++;
+		}
+	}
+}
+
+void DatabaseModel::addToNamesIndex(BaseObject *object)
+{
+	ObjectType obj_type=object->getObjectType();
+	QHash<QString, BaseObject *> &names=names_index[obj_type];
+	QString signature=object->getSignature().remove('"');
+
+	signatures_index[obj_type][object]=signature;
+
+	//Only the first object with a certain signature is indexed (the same returned by a linear search)
+	if(!names.contains(signature))
+		names[signature]=object;
+	else
+		dup_signatures[obj_type]++;
+}
+
+bool DatabaseModel::removeFromNamesIndex(BaseObject *object)
+{
+	ObjectType obj_type=object->getObjectType();
+	QString signature=signatures_index[obj_type].take(object);
+
+	if(names_index[obj_type].value(signature)!=object)
+	{
+		//The object was a duplicate so it was never in the names index
+		if(dup_signatures[obj_type] > 0)
+			dup_signatures[obj_type]--;
+	}
+	//Another object may share the removed signature so the index is rebuilt in order to index it
+	else if(dup_signatures[obj_type] > 0)
+	{
+		invalidateObjectsIndex(obj_type);
+		return(false);
+	}
+	else
+		names_index[obj_type].remove(signature);
+
+	return(true);
+}
+
+void DatabaseModel::notifySignatureChanged(BaseObject *object)
+{
+	ObjectType obj_type=object->getObjectType();
+
+	//Replacing the old signature of the object by the new one
+	if(positions_index.count(obj_type) && signatures_index[obj_type].contains(object) &&
+			removeFromNamesIndex(object))
+		addToNamesIndex(object);
+
+	/* The signatures of the objects inside a schema carry its name and the signatures of functions, operators
+	and casts carry the names of their parameters' types, so the indexes of those types are discarded */
+	if(obj_type==OBJ_SCHEMA)
+	{
+		for(auto itr=positions_index.begin(); itr!=positions_index.end();)
+		{
+			if(itr->first!=OBJ_SCHEMA)
+			{
+				names_index.erase(itr->first);
+				signatures_index.erase(itr->first);
+				dup_signatures.erase(itr->first);
+				itr=positions_index.erase(itr);
+			}
+			else
+				itr++;
+		}
+	}
+	else if(obj_type==OBJ_TYPE || obj_type==OBJ_DOMAIN || obj_type==OBJ_TABLE || obj_type==OBJ_VIEW ||
+					obj_type==OBJ_SEQUENCE || obj_type==OBJ_EXTENSION)
+	{
+		for(ObjectType type : { OBJ_FUNCTION, OBJ_AGGREGATE, OBJ_OPERATOR, OBJ_CAST })
+			invalidateObjectsIndex(type);
+	}
+}
+
+void DatabaseModel::invalidateObjectsIndex(ObjectType obj_type)
+{
+	names_index.erase(obj_type);
+	signatures_index.erase(obj_type);
+	dup_signatures.erase(obj_type);
+	positions_index.erase(obj_type);
+}
+
 BaseObject *DatabaseModel::getObject(const QString &name, ObjectType obj_type, int &obj_idx)
 {
 	BaseObject *object=nullptr;
@@ -581,6 +742,24 @@ BaseObject *DatabaseModel::getObject(const QString &name, ObjectType obj_type, i
 
 	if(!obj_list)
 		throw Exception(ERR_OBT_OBJ_INVALID_TYPE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+	else if(isIndexedType(obj_type))
+	{
+		aux_name1=QString(name).remove('"');
+		updateObjectsIndex(obj_type);
+		object=names_index[obj_type].value(aux_name1);
+
+		/* Checking if the indexed object still has the searched signature. If not, some signature
+		was changed without being registered so the index is discarded and rebuilt. Misses are trusted
+		since the index is kept up to date by the additions, removals and signature changes */
+		if(object && object->getSignature().remove('"')!=aux_name1)
+		{
+			invalidateObjectsIndex(obj_type);
+			updateObjectsIndex(obj_type);
+			object=names_index[obj_type].value(aux_name1);
+		}
+
+		obj_idx=(object ? positions_index[obj_type].value(object, -1) : -1);
+	}
 	else
 	{
 		QString signature;
@@ -737,6 +916,13 @@ void DatabaseModel::destroyObjects(void)
 	BaseObject *object=nullptr;
 	unsigned i, cnt=sizeof(types)/sizeof(ObjectType);
 
+	/* Discarding the reference graph so the objects being destroyed aren't tracked anymore.
+	It'll be rebuilt on demand when searching references */
+	ref_graph.clear();
+	ref_graph_edges.clear();
+	ref_graph_changed.clear();
+	ref_graph_built=false;
+
 	//Blocking signals of all graphical objects to avoid uneeded updates in the destruction
 	this->blockSignals(true);
 
@@ -775,6 +961,15 @@ void DatabaseModel::destroyObjects(void)
 		}
 	}
 
+	names_index.clear();
+	signatures_index.clear();
+	dup_signatures.clear();
+	positions_index.clear();
+	ref_graph.clear();
+	ref_graph_edges.clear();
+	ref_graph_changed.clear();
+	ref_graph_built=false;
+
 	PgSQLType::removeUserTypes(this);
 }
 
@@ -1270,9 +1465,7 @@ void DatabaseModel::validateRelationships(void)
 	vector<BaseObject *> vet_rel, vet_rel_inv, rels, fail_rels;
 	bool found_inval_rel, valid_fail_rels=false;
 	vector<Exception> errors;
-	map<unsigned, QString>::iterator itr1, itr1_end;
 	map<unsigned, Exception> error_map;
-	map<unsigned, Exception>::iterator itr2, itr2_end;
 	map<BaseObject *, unsigned> conn_tries;
 	unsigned idx, rels_gen_pk=0;
 	vector<Schema *> schemas;
@@ -1465,40 +1658,7 @@ void DatabaseModel::validateRelationships(void)
 			}
 
 			//Recreating the special objects
-			itr1=xml_special_objs.begin();
-			itr1_end=xml_special_objs.end();
-
-			//The special objects are created only when the model is not being loaded
-			if(!loading_model && itr1!=itr1_end)
-			{
-				do
-				{
-					try
-					{
-						//Try to create the special object
-						createSpecialObject(itr1->second, itr1->first);
-
-						/* If the special object is successfully created, remove the errors
-							 related to a previous attempt to create it */
-						if(error_map.count(itr1->first))
-							error_map.erase(error_map.find(itr1->first));
-
-						//Removes the definition of the special object when it is created successfully
-						xml_special_objs.erase(itr1);
-
-						//Restart the special object creation
-						itr1=xml_special_objs.begin();
-						itr1_end=xml_special_objs.end();
-					}
-					catch(Exception &e)
-					{
-						//If some error related to the special object is raised, stores it for latter creation attempts
-						error_map[itr1->first]=e;
-						itr1++; idx++;
-					}
-				}
-				while(itr1!=itr1_end);
-			}
+			createSpecialObjects(error_map);
 		}
 	}
 	//The validation continues until there is some invalid relationship
@@ -1511,14 +1671,57 @@ void DatabaseModel::validateRelationships(void)
 		schemas.pop_back();
 	}
 
-	//Stores the errors related to creation of special objects on the general error vector
-	itr2=error_map.begin();
-	itr2_end=error_map.end();
-	while(itr2!=itr2_end)
+	finishSpecialObjectsCreation(errors, error_map, tables);
+}
+
+void DatabaseModel::createSpecialObjects(map<unsigned, Exception> &error_map)
+{
+	map<unsigned, QString>::iterator itr, itr_end;
+
+	itr=xml_special_objs.begin();
+	itr_end=xml_special_objs.end();
+
+	//The special objects are created only when the model is not being loaded
+	if(!loading_model && itr!=itr_end)
 	{
-		errors.push_back(itr2->second);
-		itr2++;
+		do
+		{
+			try
+			{
+				//Try to create the special object
+				createSpecialObject(itr->second, itr->first);
+
+				/* If the special object is successfully created, remove the errors
+					 related to a previous attempt to create it */
+				if(error_map.count(itr->first))
+					error_map.erase(error_map.find(itr->first));
+
+				//Removes the definition of the special object when it is created successfully
+				xml_special_objs.erase(itr);
+
+				//Restart the special object creation
+				itr=xml_special_objs.begin();
+				itr_end=xml_special_objs.end();
+			}
+			catch(Exception &e)
+			{
+				//If some error related to the special object is raised, stores it for latter creation attempts
+				error_map[itr->first]=e;
+				itr++;
+			}
+		}
+		while(itr!=itr_end);
 	}
+}
+
+void DatabaseModel::finishSpecialObjectsCreation(vector<Exception> &errors, map<unsigned, Exception> &error_map, const vector<BaseObject *> &tabs)
+{
+	vector<BaseObject *>::iterator itr, itr_end;
+	BaseRelationship *base_rel=nullptr;
+
+	//Stores the errors related to creation of special objects on the general error vector
+	for(auto &itr_err : error_map)
+		errors.push_back(itr_err.second);
 
 	//If errors were caught on the above executions they will be redirected to the user
 	if(!errors.empty())
@@ -1550,13 +1753,204 @@ void DatabaseModel::validateRelationships(void)
 
 	if(!loading_model)
 	{
-		for(auto &tab : tables)
+		for(auto &tab : (tabs.empty() ? tables : tabs))
 			dynamic_cast<Table *>(tab)->restoreRelObjectsIndexes();
 
 		xml_special_objs.clear();
 	}
 }
 
+bool DatabaseModel::getAffectedRelationships(const vector<Table *> &tables, vector<Relationship *> &rels)
+{
+	map<Table *, vector<Relationship *>> rels_by_ref_tab;
+	map<Relationship *, vector<Table *>> ref_tables;
+	map<Relationship *, unsigned> pending_deps;
+	vector<Table *> tabs_to_visit;
+	vector<Relationship *> affected_rels;
+	vector<Relationship *>::iterator itr;
+	Relationship *rel=nullptr;
+	Table *table=nullptr;
+
+	rels.clear();
+
+	//Mapping each table to the relationships that propagate its columns to other tables
+	for(auto &obj : relationships)
+	{
+		rel=dynamic_cast<Relationship *>(obj);
+
+		if(rel->getRelationshipType()==Relationship::RELATIONSHIP_NN)
+		{
+			ref_tables[rel].push_back(dynamic_cast<Table *>(rel->getTable(BaseRelationship::SRC_TABLE)));
+			ref_tables[rel].push_back(dynamic_cast<Table *>(rel->getTable(BaseRelationship::DST_TABLE)));
+		}
+		else
+			ref_tables[rel].push_back(rel->getReferenceTable());
+
+		for(auto &tab : ref_tables[rel])
+			rels_by_ref_tab[tab].push_back(rel);
+	}
+
+	/* Starting from the touched tables walks through the relationships that use them as reference tables.
+	The receiver tables of those relationships are visited next since their columns will also change */
+	tabs_to_visit=tables;
+	while(!tabs_to_visit.empty())
+	{
+		table=tabs_to_visit.back();
+		tabs_to_visit.pop_back();
+
+		if(!table || !rels_by_ref_tab.count(table))
+			continue;
+
+		for(auto &ref_rel : rels_by_ref_tab[table])
+		{
+			if(std::find(affected_rels.begin(), affected_rels.end(), ref_rel)==affected_rels.end())
+			{
+				affected_rels.push_back(ref_rel);
+				tabs_to_visit.push_back(ref_rel->getReceiverTable());
+			}
+		}
+	}
+
+	/* Sorting the affected relationships in topological order: a relationship is only connected after the ones
+	that add columns to its reference tables. The relationships' order in the model is kept when there are no dependencies */
+	for(auto &aff_rel : affected_rels)
+	{
+		pending_deps[aff_rel]=0;
+
+		for(auto &dep_rel : affected_rels)
+		{
+			if(dep_rel!=aff_rel && dep_rel->getReceiverTable() &&
+				 std::find(ref_tables[aff_rel].begin(), ref_tables[aff_rel].end(), dep_rel->getReceiverTable())!=ref_tables[aff_rel].end())
+				pending_deps[aff_rel]++;
+		}
+	}
+
+	affected_rels.clear();
+	for(auto &obj : relationships)
+	{
+		rel=dynamic_cast<Relationship *>(obj);
+		if(pending_deps.count(rel))
+			affected_rels.push_back(rel);
+	}
+
+	while(!affected_rels.empty())
+	{
+		itr=affected_rels.begin();
+
+		while(itr!=affected_rels.end() && pending_deps[*itr] > 0)
+			itr++;
+
+		//All the remaining relationships depend on each other so there is no valid connection order
+		if(itr==affected_rels.end())
+		{
+			rels.clear();
+			return(false);
+		}
+
+		rel=(*itr);
+		affected_rels.erase(itr);
+		rels.push_back(rel);
+
+		for(auto &aff_rel : affected_rels)
+		{
+			if(rel->getReceiverTable() &&
+				 std::find(ref_tables[aff_rel].begin(), ref_tables[aff_rel].end(), rel->getReceiverTable())!=ref_tables[aff_rel].end())
+				pending_deps[aff_rel]--;
+		}
+	}
+
+	return(true);
+}
+
+void DatabaseModel::validateRelationships(const vector<Table *> &tables)
+{
+	try
+	{
+		vector<Relationship *> rels;
+		vector<BaseObject *> recv_tabs;
+
+		//If there is no valid order to reconnect the relationships all of them are revalidated
+		if(!getAffectedRelationships(tables, rels))
+		{
+			storeSpecialObjectsXML();
+			disconnectRelationships();
+			validateRelationships();
+		}
+		else if(!rels.empty())
+		{
+			getReceiverTables(rels, recv_tabs);
+
+			//Only the special objects of the tables that will lose their columns need to be stored
+			storeSpecialObjectsXML(recv_tabs);
+
+			//The relationships are disconnected in the inverse order of their connection
+			for(auto ritr=rels.rbegin(); ritr!=rels.rend(); ritr++)
+				(*ritr)->disconnectRelationship();
+
+			reconnectRelationships(rels, recv_tabs);
+		}
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(),e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__,&e);
+	}
+}
+
+void DatabaseModel::getReceiverTables(const vector<Relationship *> &rels, vector<BaseObject *> &recv_tabs)
+{
+	BaseObject *recv_tab=nullptr;
+
+	recv_tabs.clear();
+
+	for(auto &rel : rels)
+	{
+		recv_tab=rel->getReceiverTable();
+
+		if(recv_tab && std::find(recv_tabs.begin(), recv_tabs.end(), recv_tab)==recv_tabs.end())
+			recv_tabs.push_back(recv_tab);
+	}
+}
+
+void DatabaseModel::reconnectRelationships(vector<Relationship *> &rels, const vector<BaseObject *> &recv_tabs)
+{
+	vector<Exception> errors;
+	map<unsigned, Exception> error_map;
+	bool connected=true;
+
+	try
+	{
+		for(auto &rel : rels)
+			rel->connectRelationship();
+	}
+	catch(Exception &)
+	{
+		connected=false;
+	}
+
+	/* When some relationship could not be connected the failures are handled by the full validation (retrying or removing
+	the invalid relationships). The special objects of the other tables are stored before disconnecting all the relationships */
+	if(!connected)
+	{
+		storeSpecialObjectsXML();
+		disconnectRelationships();
+		validateRelationships();
+		return;
+	}
+
+	//Relationships invalidated by previous operations require the full validation as well
+	for(auto &obj : relationships)
+	{
+		if(dynamic_cast<Relationship *>(obj)->isInvalidated())
+		{
+			validateRelationships();
+			return;
+		}
+	}
+
+	createSpecialObjects(error_map);
+	finishSpecialObjectsCreation(errors, error_map, recv_tabs);
+}
+
 void DatabaseModel::checkRelationshipRedundancy(Relationship *rel)
 {
 	try
@@ -1653,7 +2047,7 @@ void DatabaseModel::checkRelationshipRedundancy(Relationship *rel)
 	}
 }
 
-void DatabaseModel::storeSpecialObjectsXML(void)
+void DatabaseModel::storeSpecialObjectsXML(const vector<BaseObject *> &tabs)
 {
 	unsigned count=0, i=0, type_id=0;
 	vector<BaseObject *>::iterator itr, itr_end;
@@ -1671,10 +2065,17 @@ void DatabaseModel::storeSpecialObjectsXML(void)
 	bool found=false;
 	vector<BaseObject *> objects, rem_objects;
 
+	//Returns if the table object belongs to one of the provided tables (all tables when none is provided)
+	auto isParentTableListed=[&tabs](TableObject *tab_obj) {
+		return(tabs.empty() ||
+					 (tab_obj && std::find(tabs.begin(), tabs.end(), tab_obj->getParentTable())!=tabs.end()));
+	};
+
 	try
 	{
-		itr=tables.begin();
-		itr_end=tables.end();
+		rem_objects=(tabs.empty() ? tables : tabs);
+		itr=rem_objects.begin();
+		itr_end=rem_objects.end();
 
 		/* Check on tables if there is some constraint/index/trigger that is referencing
 		 some column added by relationship */
@@ -1749,7 +2150,7 @@ void DatabaseModel::storeSpecialObjectsXML(void)
 			sequence=dynamic_cast<Sequence *>(*itr);
 			itr++;
 
-			if(sequence->isReferRelationshipAddedColumn())
+			if(sequence->isReferRelationshipAddedColumn() && isParentTableListed(sequence->getOwnerColumn()))
 			{
 				xml_special_objs[sequence->getObjectId()]=sequence->getCodeDefinition(SchemaParser::XML_DEFINITION);
 				removeSequence(sequence);
@@ -1766,8 +2167,15 @@ void DatabaseModel::storeSpecialObjectsXML(void)
 		{
 			view=dynamic_cast<View *>(*itr);
 			itr++;
+			found=tabs.empty();
+
+			for(i=0; i < view->getReferenceCount() && !found; i++)
+			{
+				Column *col=view->getReference(i).getColumn();
+				found=(col && col->isAddedByRelationship() && isParentTableListed(col));
+			}
 
-			if(view->isReferRelationshipAddedColumn())
+			if(found)
 			{
 				xml_special_objs[view->getObjectId()]=view->getCodeDefinition(SchemaParser::XML_DEFINITION);
 
@@ -1821,7 +2229,7 @@ void DatabaseModel::storeSpecialObjectsXML(void)
 			tab_obj=dynamic_cast<TableObject *>(permission->getObject());
 			itr++;
 
-			if(tab_obj)
+			if(tab_obj && isParentTableListed(tab_obj))
 			{
 				xml_special_objs[permission->getObjectId()]=permission->getCodeDefinition(SchemaParser::XML_DEFINITION);
 				removePermission(permission);
@@ -1924,16 +2332,45 @@ void DatabaseModel::removeRelationship(BaseRelationship *rel, int obj_idx)
 		if(getObjectIndex(rel) >= 0)
 		{
 			Table *recv_tab=nullptr;
+			vector<Relationship *> affected_rels;
+			vector<BaseObject *> recv_tabs;
+			bool incremental=false;
 
 			if(rel->getObjectType()==OBJ_RELATIONSHIP)
 			{
+				Relationship *aux_rel=dynamic_cast<Relationship *>(rel);
+
 				/* If the relationship is not a many-to-many we store the receiver table in order to
 		   update the fk relationships (if there are any) */
 				if(rel->getRelationshipType()!=Relationship::RELATIONSHIP_NN)
-					recv_tab=dynamic_cast<Relationship *>(rel)->getReceiverTable();
+					recv_tab=aux_rel->getReceiverTable();
 
-				storeSpecialObjectsXML();
-				disconnectRelationships();
+				/* Only the relationships that receive columns from the removed relationship's receiver table
+				need to be reconnected. If there is no valid order to do that all relationships are disconnected */
+				incremental=getAffectedRelationships(vector<Table *>{ recv_tab }, affected_rels);
+
+				if(incremental)
+				{
+					affected_rels.erase(std::remove(affected_rels.begin(), affected_rels.end(), aux_rel), affected_rels.end());
+
+					//Only the special objects of the tables that will lose their columns need to be stored
+					getReceiverTables(affected_rels, recv_tabs);
+
+					if(recv_tab && std::find(recv_tabs.begin(), recv_tabs.end(), recv_tab)==recv_tabs.end())
+						recv_tabs.push_back(recv_tab);
+
+					storeSpecialObjectsXML(recv_tabs);
+
+					for(auto ritr=affected_rels.rbegin(); ritr!=affected_rels.rend(); ritr++)
+						(*ritr)->disconnectRelationship();
+
+					aux_rel->disconnectRelationship();
+				}
+				else
+				{
+					storeSpecialObjectsXML();
+					disconnectRelationships();
+				}
 			}
 			else if(rel->getObjectType()==BASE_RELATIONSHIP)
 			{
@@ -1944,7 +2381,10 @@ void DatabaseModel::removeRelationship(BaseRelationship *rel, int obj_idx)
 
 			if(rel->getObjectType()==OBJ_RELATIONSHIP)
 			{
-				validateRelationships();
+				if(incremental)
+					reconnectRelationships(affected_rels, recv_tabs);
+				else
+					validateRelationships();
 			}
 
 			//Updating the fk relationships for the receiver table after removing the old relationship
@@ -2657,6 +3097,12 @@ void DatabaseModel::addPermission(Permission *perm)
 
 		permissions.push_back(perm);
 		perm->setDatabase(this);
+
+		if(ref_graph_built)
+		{
+			ref_graph_edges[perm].clear();
+			ref_graph_changed.insert(perm);
+		}
 	}
 	catch(Exception &e)
 	{
@@ -2702,6 +3148,12 @@ void DatabaseModel::removePermissions(BaseObject *object)
 
 		if(perm->getObject()==object)
 		{
+			if(ref_graph_built)
+			{
+				removeReferenceGraphEdges(perm);
+				ref_graph_changed.erase(perm);
+			}
+
 			permissions.erase(itr);
 			itr=itr_end=permissions.end();
 
@@ -2834,6 +3286,23 @@ int DatabaseModel::getObjectIndex(BaseObject *object)
 
 		if(!obj_list)
 			throw Exception(ERR_OBT_OBJ_INVALID_TYPE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+		else if(isIndexedType(obj_type))
+		{
+			int idx;
+
+			updateObjectsIndex(obj_type);
+			idx=positions_index[obj_type].value(object, -1);
+
+			//Discarding the index if the object isn't at the indexed position anymore
+			if(idx >= 0 && obj_list->at(idx)!=object)
+			{
+				invalidateObjectsIndex(obj_type);
+				updateObjectsIndex(obj_type);
+				idx=positions_index[obj_type].value(object, -1);
+			}
+
+			return(idx);
+		}
 		else
 		{
 			itr=obj_list->begin();
@@ -2869,7 +3338,7 @@ void DatabaseModel::configureDatabase(attribs_map &attribs)
 	setBasicAttributes(this);
 }
 
-void DatabaseModel::loadModel(const QString &filename)
+void DatabaseModel::loadModel(const QString &filename, bool use_stream, bool validate)
 {
 	if(!filename.isEmpty())
 	{
@@ -2895,12 +3364,17 @@ void DatabaseModel::loadModel(const QString &filename)
 			xmlparser.restartParser();
 
 			//Loads the root DTD
-			xmlparser.setDTDFile(dtd_file + GlobalAttributes::ROOT_DTD +
-								 GlobalAttributes::OBJECT_DTD_EXT,
-								 GlobalAttributes::ROOT_DTD);
-
-			//Loads the file validating it against the root DTD
-			xmlparser.loadXMLFile(filename);
+			if(validate)
+				xmlparser.setDTDFile(dtd_file + GlobalAttributes::ROOT_DTD +
+									 GlobalAttributes::OBJECT_DTD_EXT,
+									 GlobalAttributes::ROOT_DTD);
+
+			/* Loads the file validating it against the root DTD. In stream mode only the
+			element being loaded is kept in memory instead of the whole document */
+			if(use_stream)
+				xmlparser.openXMLStream(filename, validate);
+			else
+				xmlparser.loadXMLFile(filename);
 
 			//Gets the basic model information
 			xmlparser.getElementAttributes(attribs);
@@ -2922,7 +3396,7 @@ void DatabaseModel::loadModel(const QString &filename)
 			def_objs[OBJ_COLLATION]=attribs[ParsersAttributes::DEFAULT_COLLATION];
 			def_objs[OBJ_TABLESPACE]=attribs[ParsersAttributes::DEFAULT_TABLESPACE];
 
-			if(xmlparser.accessElement(XMLParser::CHILD_ELEMENT))
+			if(use_stream ? xmlparser.readNextStreamElement() : xmlparser.accessElement(XMLParser::CHILD_ELEMENT))
 			{
 				do
 				{
@@ -2957,7 +3431,8 @@ void DatabaseModel::loadModel(const QString &filename)
 											dynamic_cast<Relationship *>(object)->getRelationshipType()==BaseRelationship::RELATIONSHIP_GEN)
 										found_inh_rel=true;
 
-									emit s_objectLoaded((xmlparser.getCurrentBufferLine()/static_cast<float>(xmlparser.getBufferLineCount()))*100,
+									emit s_objectLoaded(use_stream ? xmlparser.getStreamProgress() :
+																	 (xmlparser.getCurrentBufferLine()/static_cast<float>(xmlparser.getBufferLineCount()))*100,
 														trUtf8("Loading: `%1' (%2)")
 														.arg(object->getName())
 														.arg(object->getTypeName()),
@@ -2974,9 +3449,13 @@ void DatabaseModel::loadModel(const QString &filename)
 						}
 					}
 				}
-				while(xmlparser.accessElement(XMLParser::NEXT_ELEMENT));
+				while(use_stream ? xmlparser.readNextStreamElement() : xmlparser.accessElement(XMLParser::NEXT_ELEMENT));
 			}
 
+			//Releases the stream reader and the file handle as soon as all the elements are read
+			if(use_stream)
+				xmlparser.restartParser();
+
 			this->BaseObject::setProtected(protected_model);
 
 			//Validating default objects
@@ -3014,6 +3493,9 @@ void DatabaseModel::loadModel(const QString &filename)
 			this->setInvalidated(false);
 			this->setObjectsModified({OBJ_RELATIONSHIP, BASE_RELATIONSHIP});
 
+			if(use_code_cache)
+				loadCodeCache(filename);
+
 			//Doing another relationship validation when there are inheritances to avoid incomplete tables
 			if(found_inh_rel)
 			{
@@ -6258,12 +6740,9 @@ void DatabaseModel::validateRelationships(TableObject *object, Table *parent_tab
 				}
 			}
 
+			//Only the relationships that propagate the parent table's columns need to be revalidated
 			if(revalidate_rels || ref_tab_inheritance)
-			{
-				storeSpecialObjectsXML();
-				disconnectRelationships();
-				validateRelationships();
-			}
+				validateRelationships(vector<Table *>{ parent_tab });
 		}
 	}
 	catch(Exception &e)
@@ -6356,22 +6835,20 @@ QString DatabaseModel::getCodeDefinition(unsigned def_type, bool export_file)
 {
 	attribs_map attribs_aux;
 	unsigned general_obj_cnt, gen_defs_count;
-	bool sql_disabled=false;
 	BaseObject *object=nullptr;
 	QString def, search_path=QString("pg_catalog,public"),
 			msg=trUtf8("Generating %1 of the object `%2' (%3)"),
-			attrib=ParsersAttributes::OBJECTS, attrib_aux,
-			def_type_str=(def_type==SchemaParser::SQL_DEFINITION ? QString("SQL") : QString("XML"));
-	Type *usr_type=nullptr;
+			attrib=ParsersAttributes::OBJECTS;
 	map<unsigned, BaseObject *> objects_map;
 	ObjectType obj_type;
+	vector<BaseObject *> par_objs;
+	vector<QString> par_objs_code;
+	vector<ObjectCode> objs_code;
+	map<BaseObject *, unsigned> par_objs_idx;
+	map<BaseObject *, unsigned>::iterator code_itr;
 
 	try
 	{
-		objects_map=getCreationOrder(def_type);
-		general_obj_cnt=this->getObjectCount();
-		gen_defs_count=0;
-
 		attribs_aux[ParsersAttributes::SHELL_TYPES]=QString();
 		attribs_aux[ParsersAttributes::PERMISSION]=QString();
 		attribs_aux[ParsersAttributes::SCHEMA]=QString();
@@ -6381,169 +6858,536 @@ QString DatabaseModel::getCodeDefinition(unsigned def_type, bool export_file)
 		if(def_type==SchemaParser::SQL_DEFINITION)
 		{
 			attribs_aux[ParsersAttributes::FUNCTION]=(!functions.empty() ? ParsersAttributes::_TRUE_ : QString());
+			getSQLObjectsCode(objs_code, search_path);
+
+			for(auto &obj_code : objs_code)
+				attribs_aux[obj_code.section]+=obj_code.code;
+		}
+		else
+		{
+			objects_map=getCreationOrder(def_type);
+			general_obj_cnt=this->getObjectCount();
+			gen_defs_count=0;
+
+			/* Generating in parallel the code of the objects that don't need a special treatment. The definitions
+			are concatenated below in the creation order so the result is the same as the serial generation */
+			if(use_parallel_codegen)
+			{
+				for(auto &obj_itr : objects_map)
+				{
+					if(isParallelCodeGenSafe(obj_itr.second, def_type))
+					{
+						par_objs_idx[obj_itr.second]=par_objs.size();
+						par_objs.push_back(obj_itr.second);
+					}
+				}
+
+				generateObjectsCode(par_objs, def_type, par_objs_code);
+			}
 
-			for(auto &type : types)
+			for(auto &obj_itr : objects_map)
 			{
-				usr_type=dynamic_cast<Type *>(type);
+				object=obj_itr.second;
+				obj_type=object->getObjectType();
+				code_itr=par_objs_idx.find(object);
 
-				if(usr_type->getConfiguration()==Type::BASE_TYPE)
-					usr_type->convertFunctionParameters();
+				if(!par_objs_code.empty() && code_itr!=par_objs_idx.end())
+				{
+					if(obj_type==OBJ_PERMISSION)
+						attribs_aux[ParsersAttributes::PERMISSION]+=par_objs_code[code_itr->second];
+					else
+						attribs_aux[attrib]+=par_objs_code[code_itr->second];
+				}
+				else if(obj_type==OBJ_DATABASE)
+					attribs_aux[attrib]+=this->__getCodeDefinition(def_type);
+				else if(obj_type==OBJ_PERMISSION)
+					attribs_aux[ParsersAttributes::PERMISSION]+=dynamic_cast<Permission *>(object)->getCodeDefinition(def_type);
+				else if(obj_type==OBJ_CONSTRAINT)
+					attribs_aux[attrib]+=dynamic_cast<Constraint *>(object)->getCodeDefinition(def_type, true);
+				else if(obj_type==OBJ_ROLE || obj_type==OBJ_TABLESPACE ||  obj_type==OBJ_SCHEMA)
+				{
+					//System object doesn't has the XML generated (the only exception is for public schema)
+					if((obj_type!=OBJ_SCHEMA && !object->isSystemObject()) ||
+						 (obj_type==OBJ_SCHEMA && object->getName()!=QString("pg_catalog")))
+						attribs_aux[attrib]+=object->getCodeDefinition(def_type);
+				}
+				else if(!object->isSystemObject())
+					attribs_aux[attrib]+=object->getCodeDefinition(def_type);
+
+				gen_defs_count++;
+
+				if(!object->isSystemObject())
+				{
+					emit s_objectLoaded((gen_defs_count/static_cast<unsigned>(general_obj_cnt)) * 100,
+										msg.arg(QString("XML"))
+										.arg(object->getName())
+										.arg(object->getTypeName()),
+										object->getObjectType());
+				}
+			}
+
+			attribs_aux[ParsersAttributes::PROTECTED]=(this->is_protected ? ParsersAttributes::_TRUE_ : QString());
+			attribs_aux[ParsersAttributes::LAST_POSITION]=QString("%1,%2").arg(last_pos.x()).arg(last_pos.y());
+			attribs_aux[ParsersAttributes::LAST_ZOOM]=QString::number(last_zoom);
+			attribs_aux[ParsersAttributes::DEFAULT_SCHEMA]=(default_objs[OBJ_SCHEMA] ? default_objs[OBJ_SCHEMA]->getName(true) : QString());
+			attribs_aux[ParsersAttributes::DEFAULT_OWNER]=(default_objs[OBJ_ROLE] ? default_objs[OBJ_ROLE]->getName(true) : QString());
+			attribs_aux[ParsersAttributes::DEFAULT_TABLESPACE]=(default_objs[OBJ_TABLESPACE] ? default_objs[OBJ_TABLESPACE]->getName(true) : QString());
+			attribs_aux[ParsersAttributes::DEFAULT_COLLATION]=(default_objs[OBJ_COLLATION] ? default_objs[OBJ_COLLATION]->getName(true) : QString());
+		}
+
+		attribs_aux[ParsersAttributes::SEARCH_PATH]=search_path;
+		attribs_aux[ParsersAttributes::MODEL_AUTHOR]=author;
+		attribs_aux[ParsersAttributes::PGMODELER_VERSION]=GlobalAttributes::PGMODELER_VERSION;
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+
+	attribs_aux[ParsersAttributes::EXPORT_TO_FILE]=(export_file ? ParsersAttributes::_TRUE_ : QString());
+	def=schparser.getCodeDefinition(ParsersAttributes::DB_MODEL, attribs_aux, def_type);
+
+	if(prepend_at_bod && def_type==SchemaParser::SQL_DEFINITION)
+		def=QString("-- Prepended SQL commands --\n") +	this->prepended_sql + QString("\n---\n\n") + def;
+
+	if(append_at_eod && def_type==SchemaParser::SQL_DEFINITION)
+		def+=QString("-- Appended SQL commands --\n") +	this->appended_sql + QString("\n---\n");
+
+	return(def);
+}
+
+void DatabaseModel::getSQLObjectsCode(vector<ObjectCode> &objs_code, QString &search_path)
+{
+	unsigned general_obj_cnt, gen_defs_count=0;
+	bool sql_disabled=false;
+	BaseObject *object=nullptr;
+	QString msg=trUtf8("Generating %1 of the object `%2' (%3)"), section, code;
+	Type *usr_type=nullptr;
+	map<unsigned, BaseObject *> objects_map;
+	ObjectType obj_type;
+	vector<BaseObject *> par_objs, base_types;
+	vector<QString> par_objs_code;
+	map<BaseObject *, unsigned> par_objs_idx;
+	map<BaseObject *, unsigned>::iterator code_itr;
+
+	objs_code.clear();
+	search_path=QString("pg_catalog,public");
+
+	try
+	{
+		objects_map=getCreationOrder(SchemaParser::SQL_DEFINITION);
+		general_obj_cnt=this->getObjectCount();
+
+		for(auto &type : types)
+		{
+			usr_type=dynamic_cast<Type *>(type);
+
+			if(usr_type->getConfiguration()==Type::BASE_TYPE)
+			{
+				usr_type->convertFunctionParameters();
+				base_types.push_back(usr_type);
 			}
 		}
 
+		/* Generating in parallel the code of the objects that don't need a special treatment. The definitions
+		are stored below in the creation order so the result is the same as the serial generation */
+		if(use_parallel_codegen)
+		{
+			for(auto &obj_itr : objects_map)
+			{
+				if(isParallelCodeGenSafe(obj_itr.second, SchemaParser::SQL_DEFINITION))
+				{
+					par_objs_idx[obj_itr.second]=par_objs.size();
+					par_objs.push_back(obj_itr.second);
+				}
+			}
+
+			generateObjectsCode(par_objs, SchemaParser::SQL_DEFINITION, par_objs_code);
+		}
+
 		for(auto &obj_itr : objects_map)
 		{
 			object=obj_itr.second;
 			obj_type=object->getObjectType();
+			code_itr=par_objs_idx.find(object);
+			section=(obj_type==OBJ_PERMISSION ? ParsersAttributes::PERMISSION : ParsersAttributes::OBJECTS);
+			code.clear();
 
-			if(obj_type==OBJ_TYPE && def_type==SchemaParser::SQL_DEFINITION)
+			if(!par_objs_code.empty() && code_itr!=par_objs_idx.end())
+				code=par_objs_code[code_itr->second];
+			else if(obj_type==OBJ_TYPE)
 			{
 				usr_type=dynamic_cast<Type *>(object);
 
 				//Generating the shell type declaration (only for base types)
 				if(usr_type->getConfiguration()==Type::BASE_TYPE)
-					attribs_aux[ParsersAttributes::SHELL_TYPES]+=usr_type->getCodeDefinition(def_type, true);
-				else
-					attribs_aux[attrib]+=usr_type->getCodeDefinition(def_type);
-			}
-			else if(obj_type==OBJ_DATABASE)
-			{
-				if(def_type==SchemaParser::SQL_DEFINITION)
 				{
-					/* The Database has the SQL code definition disabled when generating the
-		  code of the entire model because this object cannot be created from a multiline sql command */
-
-					//Saving the sql disabled state
-					sql_disabled=this->isSQLDisabled();
-
-					//Disables the sql to generate a commented code
-					this->setSQLDisabled(true);
-					attribs_aux[this->getSchemaName()]+=this->__getCodeDefinition(def_type);
-
-					//Restore the original sql disabled state
-					this->setSQLDisabled(sql_disabled);
+					section=ParsersAttributes::SHELL_TYPES;
+					code=usr_type->getCodeDefinition(SchemaParser::SQL_DEFINITION, true);
 				}
 				else
-					attribs_aux[attrib]+=this->__getCodeDefinition(def_type);
+					code=usr_type->getCodeDefinition(SchemaParser::SQL_DEFINITION);
 			}
-			else if(obj_type==OBJ_PERMISSION)
+			else if(obj_type==OBJ_DATABASE)
 			{
-				attribs_aux[ParsersAttributes::PERMISSION]+=dynamic_cast<Permission *>(object)->getCodeDefinition(def_type);
+				/* The Database has the SQL code definition disabled when generating the
+				code of the entire model because this object cannot be created from a multiline sql command */
+				section=this->getSchemaName();
+				sql_disabled=this->isSQLDisabled();
+				this->setSQLDisabled(true);
+				code=this->__getCodeDefinition(SchemaParser::SQL_DEFINITION);
+				this->setSQLDisabled(sql_disabled);
 			}
+			else if(obj_type==OBJ_PERMISSION)
+				code=dynamic_cast<Permission *>(object)->getCodeDefinition(SchemaParser::SQL_DEFINITION);
 			else if(obj_type==OBJ_CONSTRAINT)
-			{
-				attribs_aux[attrib]+=dynamic_cast<Constraint *>(object)->getCodeDefinition(def_type, true);
-			}
+				code=dynamic_cast<Constraint *>(object)->getCodeDefinition(SchemaParser::SQL_DEFINITION, true);
 			else if(obj_type==OBJ_ROLE || obj_type==OBJ_TABLESPACE ||  obj_type==OBJ_SCHEMA)
 			{
-				//The "public" schema does not have the SQL code definition generated
-				if(def_type==SchemaParser::SQL_DEFINITION)
-					attrib_aux=BaseObject::getSchemaName(obj_type);
-				else
-					attrib_aux=attrib;
+				section=BaseObject::getSchemaName(obj_type);
 
 				/* The Tablespace has the SQL code definition disabled when generating the
-		  code of the entire model because this object cannot be created from a multiline sql command */
-				if(obj_type==OBJ_TABLESPACE && !object->isSystemObject() && def_type==SchemaParser::SQL_DEFINITION)
+				code of the entire model because this object cannot be created from a multiline sql command */
+				if(obj_type==OBJ_TABLESPACE && !object->isSystemObject())
 				{
-					//Saving the sql disabled state
 					sql_disabled=object->isSQLDisabled();
-
-					//Disables the sql to generate a commented code
 					object->setSQLDisabled(true);
-					attribs_aux[attrib_aux]+=object->getCodeDefinition(def_type);
-
-					//Restore the original sql disabled state
+					code=object->getCodeDefinition(SchemaParser::SQL_DEFINITION);
 					object->setSQLDisabled(sql_disabled);
 				}
-				//System object doesn't has the XML generated (the only exception is for public schema)
+				//The "public" and "pg_catalog" schemas does not have the SQL code definition generated
 				else if((obj_type!=OBJ_SCHEMA && !object->isSystemObject()) ||
-						(obj_type==OBJ_SCHEMA &&
-						 ((object->getName()==QString("public") && def_type==SchemaParser::XML_DEFINITION) ||
-						  (object->getName()!=QString("public") && object->getName()!=QString("pg_catalog")))))
+								(obj_type==OBJ_SCHEMA && object->getName()!=QString("public") && object->getName()!=QString("pg_catalog")))
 				{
-					if(object->getObjectType()==OBJ_SCHEMA)
+					if(obj_type==OBJ_SCHEMA)
 						search_path+=QString(",") + object->getName(true);
 
-					//Generates the code definition and concatenates to the others
-					attribs_aux[attrib_aux]+=object->getCodeDefinition(def_type);
+					code=object->getCodeDefinition(SchemaParser::SQL_DEFINITION);
 				}
 			}
-			else
-			{
-				if(object->isSystemObject())
-					attribs_aux[attrib]+=QString();
-				else
-					attribs_aux[attrib]+=object->getCodeDefinition(def_type);
-			}
+			else if(!object->isSystemObject())
+				code=object->getCodeDefinition(SchemaParser::SQL_DEFINITION);
 
+			objs_code.push_back(ObjectCode{ object, section, code });
 			gen_defs_count++;
 
-			if((def_type==SchemaParser::SQL_DEFINITION && !object->isSQLDisabled()) ||
-					(def_type==SchemaParser::XML_DEFINITION && !object->isSystemObject()))
+			if(!object->isSQLDisabled())
 			{
 				emit s_objectLoaded((gen_defs_count/static_cast<unsigned>(general_obj_cnt)) * 100,
-									msg.arg(def_type_str)
+									msg.arg(QString("SQL"))
 									.arg(object->getName())
 									.arg(object->getTypeName()),
 									object->getObjectType());
 			}
 		}
 
-		attribs_aux[ParsersAttributes::SEARCH_PATH]=search_path;
-		attribs_aux[ParsersAttributes::MODEL_AUTHOR]=author;
-		attribs_aux[ParsersAttributes::PGMODELER_VERSION]=GlobalAttributes::PGMODELER_VERSION;
-
-		if(def_type==SchemaParser::XML_DEFINITION)
+		//The complete definition of base types is generated after all the other objects
+		for(auto &type : base_types)
 		{
-			attribs_aux[ParsersAttributes::PROTECTED]=(this->is_protected ? ParsersAttributes::_TRUE_ : QString());
-			attribs_aux[ParsersAttributes::LAST_POSITION]=QString("%1,%2").arg(last_pos.x()).arg(last_pos.y());
-			attribs_aux[ParsersAttributes::LAST_ZOOM]=QString::number(last_zoom);
-			attribs_aux[ParsersAttributes::DEFAULT_SCHEMA]=(default_objs[OBJ_SCHEMA] ? default_objs[OBJ_SCHEMA]->getName(true) : QString());
-			attribs_aux[ParsersAttributes::DEFAULT_OWNER]=(default_objs[OBJ_ROLE] ? default_objs[OBJ_ROLE]->getName(true) : QString());
-			attribs_aux[ParsersAttributes::DEFAULT_TABLESPACE]=(default_objs[OBJ_TABLESPACE] ? default_objs[OBJ_TABLESPACE]->getName(true) : QString());
-			attribs_aux[ParsersAttributes::DEFAULT_COLLATION]=(default_objs[OBJ_COLLATION] ? default_objs[OBJ_COLLATION]->getName(true) : QString());
+			usr_type=dynamic_cast<Type *>(type);
+			objs_code.push_back(ObjectCode{ usr_type, ParsersAttributes::OBJECTS, usr_type->getCodeDefinition(SchemaParser::SQL_DEFINITION) });
+			usr_type->convertFunctionParameters(true);
 		}
+	}
+	catch(Exception &e)
+	{
+		for(auto &type : base_types)
+			dynamic_cast<Type *>(type)->convertFunctionParameters(true);
+
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void DatabaseModel::getSQLStatements(vector<SQLStatement> &stmts, bool incl_drop_cmds)
+{
+	QString search_path;
+	vector<ObjectCode> objs_code;
+	vector<SQLStatement> schema_stmts, shell_type_stmts, obj_stmts, perm_stmts;
+	vector<SQLStatement> *dest_stmts=nullptr;
+
+	stmts.clear();
+
+	try
+	{
+		getSQLObjectsCode(objs_code, search_path);
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+
+	//The statements are grouped in the same sections used by the dbmodel template to keep the code order
+	for(auto &obj_code : objs_code)
+	{
+		if(obj_code.section==ParsersAttributes::SCHEMA)
+			dest_stmts=&schema_stmts;
+		else if(obj_code.section==ParsersAttributes::SHELL_TYPES)
+			dest_stmts=&shell_type_stmts;
+		else if(obj_code.section==ParsersAttributes::PERMISSION)
+			dest_stmts=&perm_stmts;
+		else if(obj_code.section==ParsersAttributes::OBJECTS)
+			dest_stmts=&obj_stmts;
+		//Database, roles and tablespaces are created separately (see ModelExportHelper::exportToDBMS())
 		else
+			continue;
+
+		splitSQLStatements(obj_code.object, obj_code.object->getObjectType(), obj_code.code, incl_drop_cmds, *dest_stmts);
+	}
+
+	if(prepend_at_bod)
+		splitSQLStatements(nullptr, BASE_OBJECT, prepended_sql, false, stmts);
+
+	if(!functions.empty())
+		stmts.push_back(SQLStatement{ nullptr, BASE_OBJECT, QString("SET check_function_bodies = false;\n") });
+
+	if(!schema_stmts.empty())
+	{
+		stmts.insert(stmts.end(), schema_stmts.begin(), schema_stmts.end());
+		stmts.push_back(SQLStatement{ nullptr, BASE_OBJECT, QString("SET search_path TO %1;\n").arg(search_path) });
+	}
+
+	stmts.insert(stmts.end(), shell_type_stmts.begin(), shell_type_stmts.end());
+	stmts.insert(stmts.end(), obj_stmts.begin(), obj_stmts.end());
+	stmts.insert(stmts.end(), perm_stmts.begin(), perm_stmts.end());
+
+	if(append_at_eod)
+		splitSQLStatements(nullptr, BASE_OBJECT, appended_sql, false, stmts);
+}
+
+void DatabaseModel::splitSQLStatements(BaseObject *object, ObjectType obj_type, const QString &code,
+																			 bool incl_drop_cmds, vector<SQLStatement> &stmts)
+{
+	QString sql, cmd;
+	int start=0, end=0, comm_cnt=0;
+	QStringRef line;
+
+	while(start < code.size())
+	{
+		end=code.indexOf(QChar('\n'), start);
+
+		if(end < 0)
+			end=code.size();
+
+		line=code.midRef(start, end - start);
+		start=end + 1;
+
+		if(!line.startsWith(QString("--")))
 		{
-			for(auto &type : types)
+			if(!line.isEmpty())
 			{
-				usr_type=dynamic_cast<Type *>(type);
-				if(usr_type->getConfiguration()==Type::BASE_TYPE)
-				{
-					attribs_aux[attrib]+=usr_type->getCodeDefinition(def_type);
-					usr_type->convertFunctionParameters(true);
-				}
+				sql+=line;
+				sql+=QChar('\n');
+			}
+		}
+		//The ddl end token delimits the statements
+		else if(line.contains(ParsersAttributes::DDL_END_TOKEN))
+		{
+			if(!sql.trimmed().isEmpty())
+				stmts.push_back(SQLStatement{ object, obj_type, sql });
+
+			sql.clear();
+		}
+		else if(incl_drop_cmds)
+		{
+			cmd=line.toString();
+			comm_cnt=0;
+
+			while(cmd.startsWith(QString("--")))
+			{
+				cmd=cmd.mid(2).trimmed();
+				comm_cnt++;
 			}
+
+			/* Only the DROP commands (DROP [OBJECT] or ALTER TABLE...DROP) commented once are related to enabled objects,
+			the ones of objects with SQL disabled have an additional comment indicator */
+			if(comm_cnt==1 && (cmd.startsWith(QString("DROP ")) ||
+												 (cmd.startsWith(QString("ALTER TABLE ")) && cmd.contains(QString(" DROP ")))))
+				stmts.push_back(SQLStatement{ object, obj_type, cmd + QString("\n") });
 		}
 	}
-	catch(Exception &e)
+
+	if(!sql.trimmed().isEmpty())
+		stmts.push_back(SQLStatement{ object, obj_type, sql });
+}
+
+bool DatabaseModel::isParallelCodeGenSafe(BaseObject *object, unsigned def_type)
+{
+	ObjectType obj_type=object->getObjectType();
+	Table *table=dynamic_cast<Table *>(object);
+	Constraint *constr=dynamic_cast<Constraint *>(object);
+
+	//Objects that are handled in a special way by getCodeDefinition() or that don't have their code generated
+	if(object->isSystemObject() || obj_type==OBJ_DATABASE || obj_type==OBJ_ROLE ||
+		 obj_type==OBJ_TABLESPACE || obj_type==OBJ_SCHEMA ||
+		 (obj_type==OBJ_TYPE && def_type==SchemaParser::SQL_DEFINITION))
+		return(false);
+
+	//The SQL code references the other objects only by their names
+	if(def_type==SchemaParser::SQL_DEFINITION)
+		return(true);
+
+	/* In XML the objects request the reduced form of the objects they reference. Only the objects whose
+	references are restricted to schemas, roles, tablespaces, collations and tags (which reduced forms are
+	cached in advance by generateObjectsCode() and only read by the threads) are accepted. Exclude constraints are rejected because
+	their elements request the reduced form of operators and operator classes */
+	if(table)
 	{
-		if(def_type==SchemaParser::SQL_DEFINITION)
+		for(unsigned i=0; i < table->getConstraintCount(); i++)
+		{
+			if(table->getConstraint(i)->getConstraintType()==ConstraintType::exclude)
+				return(false);
+		}
+	}
+	else if(constr)
+		return(constr->getConstraintType()!=ConstraintType::exclude);
+
+	return(table || obj_type==OBJ_RULE || obj_type==OBJ_VIEW || obj_type==OBJ_SEQUENCE ||
+				 obj_type==OBJ_DOMAIN || obj_type==OBJ_EXTENSION || obj_type==OBJ_TEXTBOX ||
+				 obj_type==OBJ_PERMISSION);
+}
+
+void DatabaseModel::generateObjectsCode(const vector<BaseObject *> &objects, unsigned def_type, vector<QString> &objs_code)
+{
+	unsigned thread_cnt=QThread::idealThreadCount(), i=0;
+	vector<vector<unsigned>> groups;
+	map<BaseObject *, unsigned> groups_idx;
+	vector<Exception> errors;
+	vector<int> error_objs;
+	QVector<unsigned> grp_indexes;
+	BaseObject *grp_owner=nullptr;
+	TableObject *tab_obj=nullptr;
+	Relationship *rel=nullptr;
+	int error_obj=-1;
+	unsigned error_grp=0;
+
+	objs_code.clear();
+
+	/* The parallel generation depends on the cached code because the shared objects have their
+	reduced forms generated in advance, so the threads only read them */
+	if(!BaseObject::isCachedCodeEnabled() || thread_cnt < 2 || objects.size() < PARALLEL_CODEGEN_MIN_OBJS)
+		return;
+
+	for(auto &object : objects)
+	{
+		/* Table children objects are grouped with their parent tables and relationships with their receiver
+		tables since the SQL of 1-1 and 1-n relationships includes the constraints added to the receiver table */
+		tab_obj=dynamic_cast<TableObject *>(object);
+		rel=dynamic_cast<Relationship *>(object);
+
+		if(tab_obj && tab_obj->getParentTable())
+			grp_owner=tab_obj->getParentTable();
+		else if(rel && rel->getReceiverTable())
+			grp_owner=rel->getReceiverTable();
+		else
+			grp_owner=object;
+
+		if(groups_idx.count(grp_owner)==0)
+		{
+			groups_idx[grp_owner]=groups.size();
+			groups.push_back(vector<unsigned>());
+		}
+
+		groups[groups_idx[grp_owner]].push_back(i++);
+	}
+
+	if(def_type==SchemaParser::XML_DEFINITION)
+	{
+		vector<BaseObject *> ref_objs;
+		BaseTable *base_tab=nullptr;
+		Table *table=nullptr;
+
+		for(auto &object : objects)
+		{
+			ref_objs.push_back(object->getSchema());
+			ref_objs.push_back(object->getOwner());
+			ref_objs.push_back(object->getTablespace());
+			ref_objs.push_back(object->getCollation());
+
+			base_tab=dynamic_cast<BaseTable *>(object);
+			table=dynamic_cast<Table *>(object);
+
+			if(base_tab)
+				ref_objs.push_back(base_tab->getTag());
+
+			for(unsigned col=0; table && col < table->getColumnCount(); col++)
+				ref_objs.push_back(table->getColumn(col)->getCollation());
+		}
+
+		try
 		{
-			for(auto &type : types)
+			for(auto &ref_obj : ref_objs)
 			{
-				usr_type=dynamic_cast<Type *>(type);
-				if(usr_type->getConfiguration()==Type::BASE_TYPE)
-				{
-					attribs_aux[attrib]+=usr_type->getCodeDefinition(def_type);
-					usr_type->convertFunctionParameters(true);
-				}
+				if(ref_obj)
+					ref_obj->getCodeDefinition(def_type, true);
 			}
 		}
-		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+		catch(Exception &)
+		{
+			//The serial generation will raise the error in the proper context
+			return;
+		}
 	}
 
-	attribs_aux[ParsersAttributes::EXPORT_TO_FILE]=(export_file ? ParsersAttributes::_TRUE_ : QString());
-	def=schparser.getCodeDefinition(ParsersAttributes::DB_MODEL, attribs_aux, def_type);
+	objs_code.resize(objects.size());
+	errors.resize(groups.size());
+	error_objs.resize(groups.size(), -1);
 
-	if(prepend_at_bod && def_type==SchemaParser::SQL_DEFINITION)
-		def=QString("-- Prepended SQL commands --\n") +	this->prepended_sql + QString("\n---\n\n") + def;
+	for(i=0; i < groups.size(); i++)
+		grp_indexes.push_back(i);
 
-	if(append_at_eod && def_type==SchemaParser::SQL_DEFINITION)
-		def+=QString("-- Appended SQL commands --\n") +	this->appended_sql + QString("\n---\n");
+	//Each group is generated by one of the threads of the global pool
+	QtConcurrent::blockingMap(grp_indexes, [&](unsigned grp_idx){
+		generateObjectsCodeGroup(objects, groups[grp_idx], def_type, objs_code, errors[grp_idx], error_objs[grp_idx]);
+	});
 
-	return(def);
+	//Raises the error of the first object (in creation order) that failed
+	for(i=0; i < groups.size(); i++)
+	{
+		if(error_objs[i] >= 0 && (error_obj < 0 || error_objs[i] < error_obj))
+		{
+			error_obj=error_objs[i];
+			error_grp=i;
+		}
+	}
+
+	if(error_obj >= 0)
+	{
+		objs_code.clear();
+		throw Exception(errors[error_grp].getErrorMessage(), errors[error_grp].getErrorType(),
+										__PRETTY_FUNCTION__,__FILE__,__LINE__, &errors[error_grp]);
+	}
+}
+
+void DatabaseModel::generateObjectsCodeGroup(const vector<BaseObject *> &objects, const vector<unsigned> &group,
+																						unsigned def_type, vector<QString> &objs_code, Exception &error, int &error_obj)
+{
+	BaseObject *object=nullptr;
+	int curr_obj=-1;
+
+	//The thread reads the cached reduced forms of the shared objects instead of generating them again
+	BaseObject::setReducedCodeReuse(true);
+
+	try
+	{
+		for(auto &obj_idx : group)
+		{
+			curr_obj=obj_idx;
+			object=objects.at(obj_idx);
+
+			//Constraints are generated in the same way as in getCodeDefinition()
+			if(object->getObjectType()==OBJ_CONSTRAINT)
+				objs_code.at(obj_idx)=dynamic_cast<Constraint *>(object)->getCodeDefinition(def_type, true);
+			else
+				objs_code.at(obj_idx)=object->getCodeDefinition(def_type);
+		}
+	}
+	catch(Exception &e)
+	{
+		error=e;
+		error_obj=curr_obj;
+	}
+
+	BaseObject::setReducedCodeReuse(false);
 }
 
 map<unsigned, BaseObject *> DatabaseModel::getCreationOrder(unsigned def_type, bool incl_relnn_objs, bool incl_rel1n_constrs)
@@ -6998,7 +7842,7 @@ vector<BaseObject *> DatabaseModel::getCreationOrder(BaseObject *object, bool on
 	return(objs);
 }
 
-void DatabaseModel::saveModel(const QString &filename, unsigned def_type)
+void DatabaseModel::saveModel(const QString &filename, unsigned def_type, bool save_code_cache)
 {
 	QFile output(filename);
 	QByteArray buf;
@@ -7014,6 +7858,10 @@ void DatabaseModel::saveModel(const QString &filename, unsigned def_type)
 		buf.append(this->getCodeDefinition(def_type));
 		output.write(buf.data(),buf.size());
 		output.close();
+
+		//Persisting the code generated so the next load of the model doesn't need to regenerate it
+		if(use_code_cache && save_code_cache && def_type==SchemaParser::XML_DEFINITION)
+			saveCodeCache(filename, QCryptographicHash::hash(buf, QCryptographicHash::Md5));
 	}
 	catch(Exception &e)
 	{
@@ -7449,17 +8297,810 @@ void DatabaseModel::getObjectDependecies(BaseObject *object, vector<BaseObject *
 }
 
 void DatabaseModel::getObjectReferences(BaseObject *object, vector<BaseObject *> &refs, bool exclusion_mode, bool exclude_perms)
+{
+	if(use_ref_graph)
+		searchReferenceGraph(object, refs, exclusion_mode, exclude_perms);
+	else
+		scanObjectReferences(object, refs, exclusion_mode, exclude_perms);
+}
+
+void DatabaseModel::searchReferenceGraph(BaseObject *object, vector<BaseObject *> &refs, bool exclusion_mode, bool exclude_perms)
 {
 	refs.clear();
 
 	if(object)
 	{
-		vector<BaseObject *>::iterator itr_perm, itr_perm_end;
-		ObjectType obj_type=object->getObjectType();
-		bool refer=false;
+		map<BaseObject *, vector<BaseObject *>>::iterator itr;
+		vector<BaseObject *> referrers;
+		ObjectType obj_type=object->getObjectType(), ref_type;
 		Permission *perm=nullptr;
+		BaseRelationship *base_rel=nullptr;
+		bool refer=false;
 
-		if(!exclude_perms)
+		updateReferenceGraph();
+
+		itr=ref_graph.find(object);
+		if(itr!=ref_graph.end())
+			referrers=itr->second;
+
+		//Permissions applied to the object are listed first
+		if(!exclude_perms)
+		{
+			for(auto &ref : referrers)
+			{
+				perm=dynamic_cast<Permission *>(ref);
+
+				if(perm && perm->getObject()==object)
+				{
+					refer=true;
+					refs.push_back(perm);
+					if(exclusion_mode) return;
+				}
+			}
+		}
+
+		if(exclusion_mode && default_objs.count(obj_type) && default_objs[obj_type]==object)
+		{
+			refs.push_back(this);
+			return;
+		}
+
+		//The children of views and tables are always considered references of their parents
+		if(obj_type==OBJ_VIEW)
+		{
+			vector<BaseObject *> tab_objs=dynamic_cast<View *>(object)->getObjects();
+			refs.insert(refs.end(), tab_objs.begin(), tab_objs.end());
+		}
+		else if(obj_type==OBJ_TABLE)
+		{
+			Table *table=dynamic_cast<Table *>(object);
+			vector<TableObject *> *tab_objs=nullptr;
+			ObjectType tab_obj_types[3]={ OBJ_TRIGGER, OBJ_RULE, OBJ_INDEX };
+
+			for(unsigned i=0; i < 3; i++)
+			{
+				tab_objs=table->getObjectList(tab_obj_types[i]);
+				refs.insert(refs.end(), tab_objs->begin(), tab_objs->end());
+			}
+		}
+
+		for(auto &ref : referrers)
+		{
+			if(exclusion_mode && refer) break;
+
+			ref_type=ref->getObjectType();
+
+			//Permissions applied to the object were already handled above
+			if(ref_type==OBJ_PERMISSION && dynamic_cast<Permission *>(ref)->getObject()==object)
+				continue;
+
+			/* As base relationship are created automatically by the model they aren't considered
+			as a reference to the table in exclusion mode (except for the fk relationships) */
+			if(exclusion_mode && ref_type==BASE_RELATIONSHIP)
+			{
+				base_rel=dynamic_cast<BaseRelationship *>(ref);
+				if(base_rel->getRelationshipType()!=BaseRelationship::RELATIONSHIP_FK)
+					continue;
+			}
+
+			refer=true;
+			refs.push_back(ref);
+		}
+
+		//Special case: check if the object is the owner or the default tablespace of the database
+		if(!exclusion_mode || !refer)
+		{
+			if((obj_type==OBJ_ROLE && this->getOwner()==object) ||
+				 (obj_type==OBJ_TABLESPACE && this->BaseObject::getTablespace()==object))
+				refs.push_back(this);
+		}
+	}
+}
+
+void DatabaseModel::notifyObjectChanged(BaseObject *object)
+{
+	//Only the objects already present in the graph are marked, the others will be handled by updateReferenceGraph()
+	if(ref_graph_built && ref_graph_edges.count(object))
+		ref_graph_changed.insert(object);
+}
+
+void DatabaseModel::updateReferenceGraph(void)
+{
+	if(!ref_graph_built)
+	{
+		vector<ObjectType> types=BaseObject::getObjectTypes(false, { OBJ_DATABASE });
+		vector<BaseObject *> *obj_list=nullptr;
+
+		ref_graph.clear();
+		ref_graph_edges.clear();
+		ref_graph_changed.clear();
+
+		for(auto &type : types)
+		{
+			obj_list=getObjectList(type);
+
+			for(auto &object : *obj_list)
+				addReferenceGraphEdges(object);
+		}
+
+		ref_graph_built=true;
+	}
+	else if(!ref_graph_changed.empty())
+	{
+		for(auto &object : ref_graph_changed)
+		{
+			removeReferenceGraphEdges(object);
+			addReferenceGraphEdges(object);
+		}
+
+		ref_graph_changed.clear();
+	}
+}
+
+void DatabaseModel::addReferenceGraphEdge(vector<pair<BaseObject *, BaseObject *>> &edges, BaseObject *referrer, BaseObject *referenced)
+{
+	if(referenced)
+		edges.push_back(make_pair(referrer, referenced));
+}
+
+void DatabaseModel::addConstraintGraphEdges(vector<pair<BaseObject *, BaseObject *>> &edges, BaseObject *referrer, Constraint *constr)
+{
+	ConstraintType constr_type=constr->getConstraintType();
+	unsigned i, count;
+
+	//Mirrors the columns checked by Constraint::isColumnReferenced()
+	if(constr_type==ConstraintType::primary_key || constr_type==ConstraintType::unique ||
+		 constr_type==ConstraintType::foreign_key)
+	{
+		count=constr->getColumnCount(Constraint::SOURCE_COLS);
+		for(i=0; i < count; i++)
+			addReferenceGraphEdge(edges, referrer, constr->getColumn(i, Constraint::SOURCE_COLS));
+
+		if(constr_type==ConstraintType::foreign_key)
+		{
+			count=constr->getColumnCount(Constraint::REFERENCED_COLS);
+			for(i=0; i < count; i++)
+				addReferenceGraphEdge(edges, referrer, constr->getColumn(i, Constraint::REFERENCED_COLS));
+		}
+	}
+	else if(constr_type==ConstraintType::exclude)
+	{
+		for(auto &elem : constr->getExcludeElements())
+			addReferenceGraphEdge(edges, referrer, elem.getColumn());
+	}
+}
+
+void DatabaseModel::addReferenceGraphEdges(BaseObject *object)
+{
+	vector<pair<BaseObject *, BaseObject *>> &edges=ref_graph_edges[object];
+	vector<BaseObject *> *referrers=nullptr;
+	ObjectType obj_type=object->getObjectType();
+	vector<ObjectType> schema_types={ OBJ_FUNCTION, OBJ_TABLE, OBJ_VIEW, OBJ_DOMAIN, OBJ_AGGREGATE, OBJ_OPERATOR,
+									  OBJ_SEQUENCE, OBJ_CONVERSION, OBJ_TYPE, OBJ_OPFAMILY, OBJ_OPCLASS },
+			owner_types={ OBJ_FUNCTION, OBJ_TABLE, OBJ_DOMAIN, OBJ_AGGREGATE, OBJ_SCHEMA, OBJ_OPERATOR,
+						  OBJ_SEQUENCE, OBJ_CONVERSION, OBJ_LANGUAGE, OBJ_TABLESPACE, OBJ_TYPE, OBJ_OPFAMILY, OBJ_OPCLASS },
+			collation_types={ OBJ_DOMAIN, OBJ_COLLATION, OBJ_TYPE };
+	unsigned i, i1, count;
+
+	/* The edges created here must reflect exactly the references searched by scanObjectReferences()
+	so any new reference checked there must be added here too */
+	edges.clear();
+
+	if(std::find(schema_types.begin(), schema_types.end(), obj_type)!=schema_types.end())
+		addReferenceGraphEdge(edges, object, object->getSchema());
+
+	if(std::find(owner_types.begin(), owner_types.end(), obj_type)!=owner_types.end())
+		addReferenceGraphEdge(edges, object, object->getOwner());
+
+	if(std::find(collation_types.begin(), collation_types.end(), obj_type)!=collation_types.end())
+		addReferenceGraphEdge(edges, object, object->getCollation());
+
+	if(obj_type==OBJ_PERMISSION)
+	{
+		Permission *perm=dynamic_cast<Permission *>(object);
+
+		addReferenceGraphEdge(edges, perm, perm->getObject());
+
+		count=perm->getRoleCount();
+		for(i=0; i < count; i++)
+			addReferenceGraphEdge(edges, perm, perm->getRole(i));
+	}
+	else if(obj_type==OBJ_ROLE)
+	{
+		Role *role=dynamic_cast<Role *>(object);
+		unsigned role_types[3]={Role::REF_ROLE, Role::MEMBER_ROLE, Role::ADMIN_ROLE};
+
+		for(i=0; i < 3; i++)
+		{
+			count=role->getRoleCount(role_types[i]);
+			for(i1=0; i1 < count; i1++)
+				addReferenceGraphEdge(edges, role, role->getRole(role_types[i], i1));
+		}
+	}
+	else if(obj_type==OBJ_TABLE)
+	{
+		Table *table=dynamic_cast<Table *>(object);
+		Column *col=nullptr;
+		Constraint *constr=nullptr;
+		Index *index=nullptr;
+		Trigger *trig=nullptr;
+		IndexElement elem;
+
+		addReferenceGraphEdge(edges, table, table->getTablespace());
+		addReferenceGraphEdge(edges, table, table->getTag());
+
+		count=table->getColumnCount();
+		for(i=0; i < count; i++)
+		{
+			col=table->getColumn(i);
+
+			if(!col->isAddedByRelationship())
+				addReferenceGraphEdge(edges, col, getUserTypeObject(col->getType()));
+
+			addReferenceGraphEdge(edges, col, col->getCollation());
+			addReferenceGraphEdge(edges, col, col->getSequence());
+		}
+
+		count=table->getConstraintCount();
+		for(i=0; i < count; i++)
+		{
+			constr=table->getConstraint(i);
+			addReferenceGraphEdge(edges, constr, constr->getTablespace());
+
+			//If a constraint references its own parent table it'll not be included on the references list
+			if(constr->getConstraintType()==ConstraintType::foreign_key &&
+				 constr->getParentTable()!=constr->getReferencedTable() &&
+				 constr->getReferencedTable() && constr->getReferencedTable()->getObjectType()==OBJ_TABLE)
+				addReferenceGraphEdge(edges, constr, constr->getReferencedTable());
+
+			for(auto &excl_elem : constr->getExcludeElements())
+			{
+				addReferenceGraphEdge(edges, constr, excl_elem.getOperatorClass());
+
+				if(constr->getConstraintType()==ConstraintType::exclude)
+					addReferenceGraphEdge(edges, constr, excl_elem.getOperator());
+			}
+
+			addConstraintGraphEdges(edges, constr, constr);
+		}
+
+		count=table->getIndexCount();
+		for(i=0; i < count; i++)
+		{
+			index=table->getIndex(i);
+			addReferenceGraphEdge(edges, index, index->getTablespace());
+
+			for(i1=0; i1 < index->getIndexElementCount(); i1++)
+			{
+				elem=index->getIndexElement(i1);
+				addReferenceGraphEdge(edges, index, elem.getOperatorClass());
+				addReferenceGraphEdge(edges, index, elem.getCollation());
+				addReferenceGraphEdge(edges, index, elem.getColumn());
+			}
+		}
+
+		count=table->getTriggerCount();
+		for(i=0; i < count; i++)
+		{
+			trig=table->getTrigger(i);
+			addReferenceGraphEdge(edges, trig, trig->getFunction());
+
+			if(trig->getReferencedTable() && trig->getReferencedTable()->getObjectType()==OBJ_TABLE)
+				addReferenceGraphEdge(edges, trig, trig->getReferencedTable());
+
+			for(i1=0; i1 < trig->getColumnCount(); i1++)
+				addReferenceGraphEdge(edges, trig, trig->getColumn(i1));
+		}
+	}
+	else if(obj_type==OBJ_VIEW)
+	{
+		View *view=dynamic_cast<View *>(object);
+		Reference ref;
+
+		addReferenceGraphEdge(edges, view, view->getTag());
+
+		count=view->getReferenceCount();
+		for(i=0; i < count; i++)
+		{
+			ref=view->getReference(i);
+			addReferenceGraphEdge(edges, view, ref.getTable());
+			addReferenceGraphEdge(edges, view, ref.getColumn());
+		}
+	}
+	else if(obj_type==OBJ_SEQUENCE)
+	{
+		Column *col=dynamic_cast<Sequence *>(object)->getOwnerColumn();
+
+		if(col)
+		{
+			addReferenceGraphEdge(edges, object, col);
+			addReferenceGraphEdge(edges, object, col->getParentTable());
+		}
+	}
+	else if(obj_type==OBJ_FUNCTION)
+	{
+		Function *func=dynamic_cast<Function *>(object);
+
+		addReferenceGraphEdge(edges, func, func->getLanguage());
+		addReferenceGraphEdge(edges, func, getUserTypeObject(func->getReturnType()));
+
+		count=func->getParameterCount();
+		for(i=0; i < count; i++)
+			addReferenceGraphEdge(edges, func, getUserTypeObject(func->getParameter(i).getType()));
+	}
+	else if(obj_type==OBJ_AGGREGATE)
+	{
+		Aggregate *aggreg=dynamic_cast<Aggregate *>(object);
+
+		addReferenceGraphEdge(edges, aggreg, aggreg->getFunction(Aggregate::FINAL_FUNC));
+		addReferenceGraphEdge(edges, aggreg, aggreg->getFunction(Aggregate::TRANSITION_FUNC));
+		addReferenceGraphEdge(edges, aggreg, aggreg->getSortOperator());
+
+		count=aggreg->getDataTypeCount();
+		for(i=0; i < count; i++)
+			addReferenceGraphEdge(edges, aggreg, getUserTypeObject(aggreg->getDataType(i)));
+	}
+	else if(obj_type==OBJ_OPERATOR)
+	{
+		Operator *oper=dynamic_cast<Operator *>(object);
+
+		for(i=Operator::FUNC_OPERATOR; i <= Operator::FUNC_RESTRICT; i++)
+			addReferenceGraphEdge(edges, oper, oper->getFunction(i));
+
+		for(i=Operator::LEFT_ARG; i <= Operator::RIGHT_ARG; i++)
+			addReferenceGraphEdge(edges, oper, getUserTypeObject(oper->getArgumentType(i)));
+
+		for(i=Operator::OPER_COMMUTATOR; i <= Operator::OPER_NEGATOR; i++)
+			addReferenceGraphEdge(edges, oper, oper->getOperator(i));
+	}
+	else if(obj_type==OBJ_CAST)
+	{
+		Cast *cast=dynamic_cast<Cast *>(object);
+
+		addReferenceGraphEdge(edges, cast, cast->getCastFunction());
+		addReferenceGraphEdge(edges, cast, getUserTypeObject(cast->getDataType(Cast::SRC_TYPE)));
+		addReferenceGraphEdge(edges, cast, getUserTypeObject(cast->getDataType(Cast::DST_TYPE)));
+	}
+	else if(obj_type==OBJ_CONVERSION)
+		addReferenceGraphEdge(edges, object, dynamic_cast<Conversion *>(object)->getConversionFunction());
+	else if(obj_type==OBJ_EVENT_TRIGGER)
+		addReferenceGraphEdge(edges, object, dynamic_cast<EventTrigger *>(object)->getFunction());
+	else if(obj_type==OBJ_LANGUAGE)
+	{
+		Language *lang=dynamic_cast<Language *>(object);
+
+		for(i=Language::VALIDATOR_FUNC; i <= Language::INLINE_FUNC; i++)
+			addReferenceGraphEdge(edges, lang, lang->getFunction(i));
+	}
+	else if(obj_type==OBJ_OPCLASS)
+	{
+		OperatorClass *opclass=dynamic_cast<OperatorClass *>(object);
+		OperatorClassElement elem;
+
+		addReferenceGraphEdge(edges, opclass, getUserTypeObject(opclass->getDataType()));
+		addReferenceGraphEdge(edges, opclass, opclass->getFamily());
+
+		count=opclass->getElementCount();
+		for(i=0; i < count; i++)
+		{
+			elem=opclass->getElement(i);
+			addReferenceGraphEdge(edges, opclass, elem.getFunction());
+			addReferenceGraphEdge(edges, opclass, elem.getOperator());
+			addReferenceGraphEdge(edges, opclass, getUserTypeObject(elem.getStorage()));
+		}
+	}
+	else if(obj_type==OBJ_DOMAIN)
+		addReferenceGraphEdge(edges, object, getUserTypeObject(dynamic_cast<Domain *>(object)->getType()));
+	else if(obj_type==OBJ_TYPE)
+	{
+		Type *type=dynamic_cast<Type *>(object);
+
+		for(i=Type::INPUT_FUNC; i <= Type::ANALYZE_FUNC; i++)
+			addReferenceGraphEdge(edges, type, type->getFunction(i));
+
+		addReferenceGraphEdge(edges, type, getUserTypeObject(type->getAlignment()));
+		addReferenceGraphEdge(edges, type, getUserTypeObject(type->getElement()));
+		addReferenceGraphEdge(edges, type, getUserTypeObject(type->getLikeType()));
+		addReferenceGraphEdge(edges, type, getUserTypeObject(type->getSubtype()));
+		addReferenceGraphEdge(edges, type, type->getSubtypeOpClass());
+	}
+	else if(obj_type==OBJ_RELATIONSHIP || obj_type==BASE_RELATIONSHIP)
+	{
+		BaseRelationship *base_rel=dynamic_cast<BaseRelationship *>(object);
+		Relationship *rel=dynamic_cast<Relationship *>(object);
+		BaseTable *table=nullptr;
+
+		//Only the tables are considered to be referenced by relationships
+		for(i=BaseRelationship::SRC_TABLE; i <= BaseRelationship::DST_TABLE; i++)
+		{
+			table=base_rel->getTable(i);
+			if(table && table->getObjectType()==OBJ_TABLE)
+				addReferenceGraphEdge(edges, base_rel, table);
+		}
+
+		if(rel && obj_type==OBJ_RELATIONSHIP)
+		{
+			count=rel->getAttributeCount();
+			for(i=0; i < count; i++)
+				addReferenceGraphEdge(edges, rel, getUserTypeObject(rel->getAttribute(i)->getType()));
+
+			count=rel->getConstraintCount();
+			for(i=0; i < count; i++)
+				addConstraintGraphEdges(edges, rel, rel->getConstraint(i));
+		}
+	}
+
+	/* Registering the referrers of each referenced object. Since the edges of each referrer are created
+	contiguously, checking the last registered referrer is enough to avoid duplicates */
+	for(auto &edge : edges)
+	{
+		referrers=&ref_graph[edge.second];
+
+		if(referrers->empty() || referrers->back()!=edge.first)
+			referrers->push_back(edge.first);
+	}
+}
+
+void DatabaseModel::removeReferenceGraphEdges(BaseObject *object)
+{
+	map<BaseObject *, vector<pair<BaseObject *, BaseObject *>>>::iterator itr=ref_graph_edges.find(object);
+	map<BaseObject *, vector<BaseObject *>>::iterator ref_itr;
+
+	if(itr==ref_graph_edges.end())
+		return;
+
+	//The pointers are only compared here since the objects involved could be already destroyed
+	for(auto &edge : itr->second)
+	{
+		ref_itr=ref_graph.find(edge.second);
+
+		if(ref_itr!=ref_graph.end())
+		{
+			vector<BaseObject *> &referrers=ref_itr->second;
+			referrers.erase(std::remove(referrers.begin(), referrers.end(), edge.first), referrers.end());
+
+			if(referrers.empty())
+				ref_graph.erase(ref_itr);
+		}
+	}
+
+	ref_graph_edges.erase(itr);
+}
+
+BaseObject *DatabaseModel::getUserTypeObject(PgSQLType type)
+{
+	void *ptype=type.getUserTypeReference();
+
+	if(!ptype)
+		return(nullptr);
+
+	switch(type.getUserTypeConfig())
+	{
+		case UserTypeConfig::BASE_TYPE: return(static_cast<Type *>(ptype));
+		case UserTypeConfig::DOMAIN_TYPE: return(static_cast<Domain *>(ptype));
+		case UserTypeConfig::TABLE_TYPE: return(static_cast<Table *>(ptype));
+		case UserTypeConfig::VIEW_TYPE: return(static_cast<View *>(ptype));
+		case UserTypeConfig::SEQUENCE_TYPE: return(static_cast<Sequence *>(ptype));
+		case UserTypeConfig::EXTENSION_TYPE: return(static_cast<Extension *>(ptype));
+		default: return(nullptr);
+	}
+}
+
+bool DatabaseModel::isReferenceGraphConsistent(vector<BaseObject *> *diverging_objs)
+{
+	vector<ObjectType> types=BaseObject::getObjectTypes(false, { OBJ_DATABASE }),
+			tab_obj_types=BaseObject::getChildObjectTypes(OBJ_TABLE);
+	vector<BaseObject *> objects, graph_refs, scan_refs, *obj_list=nullptr;
+	vector<TableObject *> *tab_objs=nullptr;
+	bool consistent=true, diverge=false;
+
+	for(auto &type : types)
+	{
+		obj_list=getObjectList(type);
+		objects.insert(objects.end(), obj_list->begin(), obj_list->end());
+
+		if(type==OBJ_TABLE)
+		{
+			for(auto &object : *obj_list)
+			{
+				for(auto &tab_type : tab_obj_types)
+				{
+					tab_objs=dynamic_cast<Table *>(object)->getObjectList(tab_type);
+					objects.insert(objects.end(), tab_objs->begin(), tab_objs->end());
+				}
+			}
+		}
+	}
+
+	objects.push_back(this);
+
+	if(diverging_objs)
+		diverging_objs->clear();
+
+	for(auto &object : objects)
+	{
+		//Compares if both searches find the same set of objects (the order is not relevant)
+		searchReferenceGraph(object, graph_refs);
+		scanObjectReferences(object, scan_refs);
+
+		std::sort(graph_refs.begin(), graph_refs.end());
+		graph_refs.erase(std::unique(graph_refs.begin(), graph_refs.end()), graph_refs.end());
+		std::sort(scan_refs.begin(), scan_refs.end());
+		scan_refs.erase(std::unique(scan_refs.begin(), scan_refs.end()), scan_refs.end());
+		diverge=(graph_refs!=scan_refs);
+
+		//In exclusion mode both searches must agree on the existence of references
+		if(!diverge)
+		{
+			searchReferenceGraph(object, graph_refs, true, true);
+			scanObjectReferences(object, scan_refs, true, true);
+			diverge=(graph_refs.empty()!=scan_refs.empty());
+		}
+
+		if(diverge)
+		{
+			consistent=false;
+
+			if(diverging_objs)
+				diverging_objs->push_back(object);
+		}
+	}
+
+	return(consistent);
+}
+
+void DatabaseModel::enableReferenceGraph(bool value)
+{
+	use_ref_graph=value;
+}
+
+bool DatabaseModel::isReferenceGraphEnabled(void)
+{
+	return(use_ref_graph);
+}
+
+void DatabaseModel::enableCodeCache(bool value)
+{
+	use_code_cache=value;
+}
+
+bool DatabaseModel::isCodeCacheEnabled(void)
+{
+	return(use_code_cache);
+}
+
+void DatabaseModel::setCodeCacheDirectory(const QString &dir)
+{
+	code_cache_dir=dir;
+}
+
+QString DatabaseModel::getCodeCacheDirectory(void)
+{
+	if(!code_cache_dir.isEmpty())
+		return(code_cache_dir);
+
+	return(GlobalAttributes::CONFIGURATIONS_DIR + GlobalAttributes::DIR_SEPARATOR + QString("codecache"));
+}
+
+void DatabaseModel::getCodeCacheObjects(vector<BaseObject *> &objects)
+{
+	vector<BaseObject *> *obj_list=nullptr, children;
+	BaseTable *base_tab=nullptr;
+
+	objects.clear();
+
+	for(auto &obj_type : BaseObject::getObjectTypes(false, { OBJ_DATABASE }))
+	{
+		obj_list=getObjectList(obj_type);
+
+		if(!obj_list)
+			continue;
+
+		for(auto &object : *obj_list)
+		{
+			objects.push_back(object);
+			base_tab=dynamic_cast<BaseTable *>(object);
+
+			if(base_tab)
+			{
+				children=base_tab->getObjects();
+				objects.insert(objects.end(), children.begin(), children.end());
+			}
+		}
+	}
+}
+
+QString DatabaseModel::getCodeCacheKey(BaseObject *object)
+{
+	return(QString("%1:%2").arg(object->getObjectType()).arg(object->getSignature()));
+}
+
+QString DatabaseModel::getCodeCacheFilename(const QString &filename)
+{
+	QByteArray path=QFileInfo(filename).absoluteFilePath().toUtf8();
+
+	return(getCodeCacheDirectory() + GlobalAttributes::DIR_SEPARATOR +
+				 QString(QCryptographicHash::hash(path, QCryptographicHash::Md5).toHex()) + QString(".cache"));
+}
+
+void DatabaseModel::saveCodeCache(const QString &filename, const QByteArray &model_hash)
+{
+	QString cache_file=getCodeCacheFilename(filename), key, xml_code, reduced_code, sql_code, pgsql_ver;
+	vector<BaseObject *> objects;
+	map<QString, BaseObject *> cached_objs;
+	QFile output;
+	QDataStream stream;
+
+	if(!BaseObject::isCachedCodeEnabled())
+		return;
+
+	getCodeCacheObjects(objects);
+
+	/* Objects sharing the same key can't be told apart when restoring the cache
+	so they are left out (they will have their code generated as usual) */
+	for(auto &object : objects)
+	{
+		key=getCodeCacheKey(object);
+
+		if(cached_objs.count(key))
+			cached_objs[key]=nullptr;
+		else
+			cached_objs[key]=object;
+	}
+
+	//The model keeps only the cache of the file it was last saved to
+	if(!code_cache_file.isEmpty() && code_cache_file!=cache_file)
+		QFile::remove(code_cache_file);
+
+	code_cache_file=cache_file;
+	QDir().mkpath(QFileInfo(cache_file).absolutePath());
+	output.setFileName(cache_file);
+
+	if(!output.open(QFile::WriteOnly | QFile::Truncate))
+		return;
+
+	stream.setDevice(&output);
+	stream.setVersion(QDataStream::Qt_5_0);
+	stream << CODE_CACHE_MAGIC << static_cast<quint32>(CODE_CACHE_VERSION)
+				 << GlobalAttributes::PGMODELER_VERSION << model_hash
+				 << QFileInfo(filename).absoluteFilePath();
+
+	for(auto &itr : cached_objs)
+	{
+		if(!itr.second)
+			continue;
+
+		itr.second->getCachedCodes(xml_code, reduced_code, sql_code, pgsql_ver);
+
+		if(xml_code.isEmpty() && reduced_code.isEmpty() && sql_code.isEmpty())
+			continue;
+
+		stream << itr.first << xml_code << reduced_code << sql_code << pgsql_ver;
+	}
+
+	output.close();
+
+	//Removing incomplete files so they aren't used on the next load
+	if(stream.status()!=QDataStream::Ok)
+		output.remove();
+
+	pruneCodeCache();
+}
+
+void DatabaseModel::pruneCodeCache(void)
+{
+	QDir cache_dir(getCodeCacheDirectory());
+	QFileInfoList cache_files=cache_dir.entryInfoList({ QString("*.cache") }, QDir::Files, QDir::Time);
+	QString magic, pgmodeler_ver, model_file;
+	QByteArray model_hash;
+	quint32 version=0;
+	QFile input;
+	int kept=0;
+
+	//The files are listed from the most to the least recently saved
+	for(auto &file_info : cache_files)
+	{
+		model_file.clear();
+		input.setFileName(file_info.absoluteFilePath());
+
+		if(input.open(QFile::ReadOnly))
+		{
+			QDataStream stream(&input);
+
+			stream.setVersion(QDataStream::Qt_5_0);
+			stream >> magic >> version;
+
+			if(stream.status()==QDataStream::Ok && magic==CODE_CACHE_MAGIC && version==CODE_CACHE_VERSION)
+				stream >> pgmodeler_ver >> model_hash >> model_file;
+
+			input.close();
+		}
+
+		//Unreadable files, files in older formats and files of removed models are discarded
+		if(model_file.isEmpty() || !QFileInfo(model_file).exists() || kept >= CODE_CACHE_MAX_FILES)
+			input.remove();
+		else
+			kept++;
+	}
+}
+
+bool DatabaseModel::loadCodeCache(const QString &filename)
+{
+	QString key, magic, pgmodeler_ver, model_path, xml_code, reduced_code, sql_code, pgsql_ver;
+	QByteArray cache_hash;
+	QCryptographicHash model_hash(QCryptographicHash::Md5);
+	vector<BaseObject *> objects;
+	map<QString, BaseObject *> cached_objs;
+	quint32 version=0;
+	QFile input(getCodeCacheFilename(filename)), model_file(filename);
+	QDataStream stream;
+
+	if(!BaseObject::isCachedCodeEnabled() || !input.open(QFile::ReadOnly))
+		return(false);
+
+	stream.setDevice(&input);
+	stream.setVersion(QDataStream::Qt_5_0);
+	stream >> magic >> version >> pgmodeler_ver >> cache_hash >> model_path;
+
+	//The cache is discarded when generated by other pgModeler version since the code may differ
+	if(stream.status()!=QDataStream::Ok || magic!=CODE_CACHE_MAGIC ||
+		 version!=CODE_CACHE_VERSION || pgmodeler_ver!=GlobalAttributes::PGMODELER_VERSION)
+		return(false);
+
+	//The cache is valid only if the model file has the same contents of the one saved with the cache
+	if(!model_file.open(QFile::ReadOnly) || !model_hash.addData(&model_file) || model_hash.result()!=cache_hash)
+		return(false);
+
+	model_file.close();
+	code_cache_file=input.fileName();
+	getCodeCacheObjects(objects);
+
+	for(auto &object : objects)
+	{
+		key=getCodeCacheKey(object);
+
+		if(cached_objs.count(key))
+			cached_objs[key]=nullptr;
+		else
+			cached_objs[key]=object;
+	}
+
+	while(!stream.atEnd())
+	{
+		stream >> key >> xml_code >> reduced_code >> sql_code >> pgsql_ver;
+
+		if(stream.status()!=QDataStream::Ok)
+			break;
+
+		if(cached_objs.count(key) && cached_objs[key])
+			cached_objs[key]->restoreCachedCodes(xml_code, reduced_code, sql_code, pgsql_ver);
+	}
+
+	return(true);
+}
+
+void DatabaseModel::enableParallelCodeGeneration(bool value)
+{
+	use_parallel_codegen=value;
+}
+
+bool DatabaseModel::isParallelCodeGenerationEnabled(void)
+{
+	return(use_parallel_codegen);
+}
+
+void DatabaseModel::scanObjectReferences(BaseObject *object, vector<BaseObject *> &refs, bool exclusion_mode, bool exclude_perms)
+{
+	refs.clear();
+
+	if(object)
+	{
+		vector<BaseObject *>::iterator itr_perm, itr_perm_end;
+		ObjectType obj_type=object->getObjectType();
+		bool refer=false;
+		Permission *perm=nullptr;
+
+		if(!exclude_perms)
 		{
 			//Get the permissions thata references the object
 			itr_perm=permissions.begin();
@@ -8074,7 +9715,7 @@ void DatabaseModel::getObjectReferences(BaseObject *object, vector<BaseObject *>
 				for(i1=0; i1 < 3 && (!exclusion_mode || (exclusion_mode && !refer)); i1++)
 				{
 					count=role_aux->getRoleCount(role_types[i1]);
-					for(i=0; i < count && !refer; i++)
+					for(i=0; i < count && (!exclusion_mode || (exclusion_mode && !refer)); i++)
 					{
 						if(role_aux->getRole(role_types[i1], i)==role)
 						{
@@ -8302,7 +9943,7 @@ void DatabaseModel::getObjectReferences(BaseObject *object, vector<BaseObject *>
 				}
 				else if(obj_types[i]==OBJ_OPERATOR)
 				{
-					while(itr!=itr_end && !refer)
+					while(itr!=itr_end && (!exclusion_mode || (exclusion_mode && !refer)))
 					{
 						oper_aux=dynamic_cast<Operator *>(*itr);
 						itr++;
@@ -8320,7 +9961,7 @@ void DatabaseModel::getObjectReferences(BaseObject *object, vector<BaseObject *>
 				}
 				else
 				{
-					while(itr!=itr_end && !refer)
+					while(itr!=itr_end && (!exclusion_mode || (exclusion_mode && !refer)))
 					{
 						table=dynamic_cast<Table *>(*itr);
 						itr++;
@@ -30,6 +30,7 @@ Additionally, this class, saves, loads and generates the XML/SQL definition of a
 #include <QFile>
 #include <QObject>
 #include <QStringList>
+#include <QHash>
 #include "baseobject.h"
 #include "table.h"
 #include "function.h"
@@ -54,6 +55,7 @@ Additionally, this class, saves, loads and generates the XML/SQL definition of a
 #include "tag.h"
 #include "eventtrigger.h"
 #include <algorithm>
+#include <set>
 #include <locale.h>
 
 class ModelWidget;
@@ -62,6 +64,20 @@ class DatabaseModel:  public QObject, public BaseObject {
 	private:
 		Q_OBJECT
 
+	public:
+		//! \brief Stores a single SQL statement generated for an object (see getSQLStatements())
+		struct SQLStatement {
+			//! \brief The object that generated the statement. Auxiliary commands (e.g. SET, custom SQL) have no object
+			BaseObject *object;
+
+			//! \brief The type of the object (BASE_OBJECT for auxiliary commands)
+			ObjectType obj_type;
+
+			//! \brief The statement text without comments
+			QString sql;
+		};
+
+	private:
 		static unsigned dbmodel_id;
 
 		XMLParser xmlparser;
@@ -116,6 +132,63 @@ class DatabaseModel:  public QObject, public BaseObject {
 		 when revalidating the relationships */
 		map<unsigned, QString> xml_special_objs;
 
+		/*! \brief Indexes the objects of each type by their signatures (without quotes) so getObject(name, type)
+		doesn't need to scan the whole object list. When two objects share the same signature only the first one
+		in the list is indexed, matching the result of the linear search */
+		map<ObjectType, QHash<QString, BaseObject *>> names_index;
+
+		//! \brief Indexes the position of each object in its list. This index always mirrors the lists' ordering
+		map<ObjectType, QHash<BaseObject *, int>> positions_index;
+
+		/*! \brief Stores the signature under which each object was indexed so the names index can be updated
+		when the object is renamed or moved to another schema (see notifySignatureChanged()) */
+		map<ObjectType, QHash<BaseObject *, QString>> signatures_index;
+
+		/*! \brief Counts the objects of each type that share the signature of another one and thus are not in the names index.
+		While there are duplicates, removing a signature from the index may hide the duplicate so the index is rebuilt instead */
+		map<ObjectType, unsigned> dup_signatures;
+
+		/*! \brief Indicates if getObjectReferences() must use the reference graph instead of scanning
+		the whole model. Disabling the graph is meant to be used only for debugging purposes */
+		static bool use_ref_graph;
+
+		//! \brief Indicates if getCodeDefinition() distributes the code generation of the objects among threads
+		static bool use_parallel_codegen;
+
+		//! \brief Minimum amount of objects needed to run the code generation in parallel
+		static const unsigned PARALLEL_CODEGEN_MIN_OBJS=64;
+
+		//! \brief Indicates if the objects' code is persisted in a cache file when saving and restored when loading the model
+		static bool use_code_cache;
+
+		//! \brief Identifies the code cache files and the version of their format
+		static const QString CODE_CACHE_MAGIC;
+		static const unsigned CODE_CACHE_VERSION=2;
+
+		//! \brief Maximum amount of code cache files kept in the cache directory (the least recently saved are removed)
+		static const int CODE_CACHE_MAX_FILES=50;
+
+		//! \brief Directory where the code cache files are stored. When empty the codecache dir in the configurations dir is used
+		static QString code_cache_dir;
+
+		//! \brief Stores the code cache file last written or read by the model. The model keeps only one cache file
+		QString code_cache_file;
+
+		/*! \brief Reverse reference graph. Maps each object to the objects that reference it. The graph is built
+		on demand in updateReferenceGraph() and is maintained incrementally as the objects are changed */
+		map<BaseObject *, vector<BaseObject *>> ref_graph;
+
+		/*! \brief Stores the edges (referrer, referenced object) inserted in the reference graph by each object of the model,
+		including the ones related to its children (e.g. the columns, constraints, indexes and triggers of a table).
+		The keys of this map are also used to determine which objects are tracked by the graph */
+		map<BaseObject *, vector<pair<BaseObject *, BaseObject *>>> ref_graph_edges;
+
+		//! \brief Objects changed since the last update of the reference graph which edges must be recalculated
+		set<BaseObject *> ref_graph_changed;
+
+		//! \brief Indicates if the reference graph was built and is being incrementally maintained
+		bool ref_graph_built;
+
 		//! \brief Indicates if the model is being loaded
 		bool loading_model,
 
@@ -138,6 +211,57 @@ class DatabaseModel:  public QObject, public BaseObject {
 		 the object index */
 		BaseObject *getObject(const QString &name, ObjectType obj_type, int &obj_idx);
 
+		/*! \brief Returns if the objects of the specified type can be searched using the names/positions indexes.
+		Permissions are always searched linearly since their signatures depend on several attributes */
+		bool isIndexedType(ObjectType obj_type);
+
+		//! \brief Rebuilds the names and positions indexes of the specified type in case they are outdated
+		void updateObjectsIndex(ObjectType obj_type);
+
+		//! \brief Discards the indexes of the specified type forcing their recreation in the next search
+		void invalidateObjectsIndex(ObjectType obj_type);
+
+		//! \brief Inserts the current signature of the object in the names index of its type
+		void addToNamesIndex(BaseObject *object);
+
+		/*! \brief Removes the signature under which the object was indexed from the names index of its type.
+		Returns false when the index had to be discarded (see dup_signatures) */
+		bool removeFromNamesIndex(BaseObject *object);
+
+		//! \brief Marks the provided object as changed so its edges in the reference graph are recalculated on the next search
+		virtual void notifyObjectChanged(BaseObject *object);
+
+		/*! \brief Updates the names index when the signature of an object of the model changes. The indexes of the types whose
+		signatures embed the changed object's name (e.g. functions referencing a renamed type) are discarded */
+		virtual void notifySignatureChanged(BaseObject *object);
+
+		//! \brief Builds the reference graph if needed or recalculates the edges of the objects changed since the last update
+		void updateReferenceGraph(void);
+
+		//! \brief Inserts in the reference graph the edges of the references made by the object and its children
+		void addReferenceGraphEdges(BaseObject *object);
+
+		//! \brief Removes from the reference graph all the edges previously inserted by the object
+		void removeReferenceGraphEdges(BaseObject *object);
+
+		//! \brief Registers the edge (referrer, referenced) in the provided list. Null referenced objects are ignored
+		void addReferenceGraphEdge(vector<pair<BaseObject *, BaseObject *>> &edges, BaseObject *referrer, BaseObject *referenced);
+
+		//! \brief Registers the edges between the referrer and the columns referenced by the provided constraint
+		void addConstraintGraphEdges(vector<pair<BaseObject *, BaseObject *>> &edges, BaseObject *referrer, Constraint *constr);
+
+		/*! \brief Returns the objects that references the passed object using the reference graph. The parameters
+		have the same semantics of the ones in getObjectReferences() */
+		void searchReferenceGraph(BaseObject *object, vector<BaseObject *> &refs, bool exclusion_mode=false, bool exclude_perms=false);
+
+		/*! \brief Returns the object that owns the user defined type referenced by the provided pgsql type.
+		Differently from getObjectPgSQLType() this method doesn't perform a name search */
+		BaseObject *getUserTypeObject(PgSQLType type);
+
+		/*! \brief Brute-force version of getObjectReferences() which scans the whole model looking for the references.
+		This method is used when the reference graph is disabled and to check the graph's consistency */
+		void scanObjectReferences(BaseObject *object, vector<BaseObject *> &refs, bool exclusion_mode=false, bool exclude_perms=false);
+
 		//! \brief Generic method that adds an object to the model
 		void __addObject(BaseObject *object, int obj_idx=-1);
 
@@ -145,6 +269,87 @@ class DatabaseModel:  public QObject, public BaseObject {
 		to enable/disable reference checking before remove the object from model. */
 		void __removeObject(BaseObject *object, int obj_idx=-1, bool check_refs=true);
 
+		/*! \brief Returns in topological order the relationships affected by changes in the provided tables.
+		Returns false when the affected relationships depend on each other in a cycle */
+		bool getAffectedRelationships(const vector<Table *> &tables, vector<Relationship *> &rels);
+
+		//! \brief Returns the distinct receiver tables of the provided relationships
+		void getReceiverTables(const vector<Relationship *> &rels, vector<BaseObject *> &recv_tabs);
+
+		/*! \brief Connects the provided relationships in the given order and recreates the special objects stored for the
+		receiver tables. In case of errors, or if some relationship of the model is still invalidated, the full validation
+		takes care of all the relationships */
+		void reconnectRelationships(vector<Relationship *> &rels, const vector<BaseObject *> &recv_tabs);
+
+		//! \brief Recreates the stored special objects (see storeSpecialObjectsXML()) registering the failures in the error map
+		void createSpecialObjects(map<unsigned, Exception> &error_map);
+
+		/*! \brief Raises the errors of the validation (including the failures to recreate special objects) or, if there are none,
+		restores the relationship objects' indexes of the provided tables (all tables when none is provided) */
+		void finishSpecialObjectsCreation(vector<Exception> &errors, map<unsigned, Exception> &error_map, const vector<BaseObject *> &tabs);
+
+		/*! \brief Returns if the code of the object can be generated by a code generation thread. Objects that
+		change attributes of the objects they reference (e.g. the ones that request the reduced form of functions
+		and operators in XML) or that need a special treatment in getCodeDefinition() must be handled serially */
+		bool isParallelCodeGenSafe(BaseObject *object, unsigned def_type);
+
+		/*! \brief Generates the code of the objects using the global thread pool storing each definition in the same position
+		of the object in the list. Table children objects are handled by the same thread of their parent tables
+		since a table generates the code of some of its children. The list of definitions is left empty when the
+		parallel generation can't be performed so the caller must generate the code serially */
+		void generateObjectsCode(const vector<BaseObject *> &objects, unsigned def_type, vector<QString> &objs_code);
+
+		/*! \brief Generates the code of one group of objects. This method is executed by the code generation threads.
+		The first error of the group is stored in error and the erroneous object's index in error_obj (which is left
+		untouched when the group was successfully generated) */
+		static void generateObjectsCodeGroup(const vector<BaseObject *> &objects, const vector<unsigned> &group,
+																				 unsigned def_type, vector<QString> &objs_code, Exception &error, int &error_obj);
+
+		//! \brief Stores the SQL code of an object and the section of the dbmodel schema file in which it is written
+		struct ObjectCode {
+			BaseObject *object;
+			QString section, code;
+		};
+
+		/*! \brief Generates the SQL code of the objects in the creation order storing the section of the dbmodel schema
+		file (schema, shell-types, objects, permission, etc) in which each code is written, as well the search path
+		built from the schemas. This is the generation shared by getCodeDefinition(SQL_DEFINITION) and getSQLStatements()
+		so both produce the code in the same order. Database and tablespaces have their code commented */
+		void getSQLObjectsCode(vector<ObjectCode> &objs_code, QString &search_path);
+
+		/*! \brief Splits the code of an object in statements (delimited by the ddl-end token) appending them to the list.
+		Comments are discarded, except the DROP commands of enabled objects when incl_drop_cmds is true which are
+		uncommented and stored as statements */
+		static void splitSQLStatements(BaseObject *object, ObjectType obj_type, const QString &code,
+																	 bool incl_drop_cmds, vector<SQLStatement> &stmts);
+
+		//! \brief Returns the objects (including the table children) that have their code stored in the code cache file
+		void getCodeCacheObjects(vector<BaseObject *> &objects);
+
+		//! \brief Returns the key used to identify the object on the code cache file
+		QString getCodeCacheKey(BaseObject *object);
+
+		//! \brief Returns the directory where the code cache files are stored
+		static QString getCodeCacheDirectory(void);
+
+		/*! \brief Returns the path to the code cache file of the provided model file. The cache files are stored
+		in the code cache dir and their names are the hash of the model file absolute path */
+		static QString getCodeCacheFilename(const QString &filename);
+
+		/*! \brief Saves the cached code of the objects in the code cache file of the provided model file. The hash is
+		the one of the model file contents and is used to validate the cache on the next load. The cache file previously
+		written by the model (e.g. before a "save as") is removed. Errors are ignored since the cache is only used to
+		speed up the code generation */
+		void saveCodeCache(const QString &filename, const QByteArray &model_hash);
+
+		/*! \brief Removes the cache files of the model files that don't exist anymore as well the least recently
+		saved ones when the cache dir has more than CODE_CACHE_MAX_FILES files */
+		static void pruneCodeCache(void);
+
+		/*! \brief Restores the cached code of the objects from the code cache file of the provided model file. The codes
+		are restored only if the model file was not changed since the cache was saved. Returns true when the cache was used */
+		bool loadCodeCache(const QString &filename);
+
 		//! \brief Recreates the special object from the passed xml code buffer
 		void createSpecialObject(const QString &xml_def, unsigned obj_id=0);
 
@@ -189,12 +394,20 @@ class DatabaseModel:  public QObject, public BaseObject {
 		void disconnectRelationships(void);
 
 		/*! \brief Detects and stores the XML for special objects (that is referencing columns created
-		 by relationship) in order to be reconstructed in a posterior moment */
-		void storeSpecialObjectsXML(void);
+		 by relationship) in order to be reconstructed in a posterior moment. When tables are provided only
+		 the special objects referencing columns of those tables are stored */
+		void storeSpecialObjectsXML(const vector<BaseObject *> &tabs=vector<BaseObject *>());
 
 		//! \brief Validates all the relationship, propagating all column modifications over the tables
 		void validateRelationships(void);
 
+		/*! \brief Revalidates only the relationships affected by changes in the provided tables: the ones that use them
+		as reference tables and, transitively, the ones that use the receiver tables of those relationships as reference.
+		The affected relationships are disconnected and reconnected in topological order and only the special objects of their
+		receiver tables are stored and recreated. All relationships are revalidated by validateRelationships() in case some of
+		them could not be reconnected or is still invalidated, so the full validation always works as a fallback */
+		void validateRelationships(const vector<Table *> &tables);
+
 		//! \brief Returns the list of specified object type that belongs to the passed schema
 		vector<BaseObject *> getObjects(ObjectType obj_type, BaseObject *schema=nullptr);
 
@@ -221,8 +434,10 @@ class DatabaseModel:  public QObject, public BaseObject {
 
 		/*! \brief Loads a database model from a file. In case of loading errors
 	the objects in the model will not be destroyed automatically. The user need to call
-	destroyObjects() or delete the entire model */
-		void loadModel(const QString &filename);
+	destroyObjects() or delete the entire model. When use_stream is true the file is read as a stream
+	(see XMLParser::openXMLStream) so the memory usage is proportional to the loaded objects instead
+	of the file size. The validate parameter controls whether the file is validated against the DTD */
+		void loadModel(const QString &filename, bool use_stream=false, bool validate=true);
 
 		//! \brief Sets the database encoding
 		void setEncoding(EncodingType encod);
@@ -288,8 +503,10 @@ class DatabaseModel:  public QObject, public BaseObject {
 		//! \brief Indicate if the model invalidated
 		void setInvalidated(bool value);
 
-		//! \brief Saves the specified code definition for the model on the specified filename
-		void saveModel(const QString &filename, unsigned def_type);
+		/*! \brief Saves the specified code definition for the model on the specified filename. The code cache file is
+		written only when save_code_cache is true, so temporary saves (e.g. the ones done periodically in the background)
+		don't replace the cache of the model file */
+		void saveModel(const QString &filename, unsigned def_type, bool save_code_cache=true);
 
 		/*! \brief Returns the complete SQL/XML defintion for the entire model (including all the other objects).
 		 The parameter 'export_file' is used to format the generated code in a way that can be saved
@@ -302,6 +519,12 @@ class DatabaseModel:  public QObject, public BaseObject {
 		//! \brief Returns the code definition only for the database (excluding the definition of the other objects)
 		QString __getCodeDefinition(unsigned def_type);
 
+		/*! \brief Generates the SQL of the model as a list of statements in the same order of getCodeDefinition() storing
+		the object that generated each one. Roles, tablespaces and the database itself are not included since they are
+		created separately when exporting to the server (same as getCodeDefinition(SQL_DEFINITION, false)). The parameter
+		incl_drop_cmds causes the commented DROP commands of the enabled objects to be included as statements */
+		void getSQLStatements(vector<SQLStatement> &stmts, bool incl_drop_cmds=false);
+
 		/*! \brief Returns the creation order of objects in each definition type (SQL or XML).
 
 		The parameter incl_relnn_objs when 'true' includes the generated objects (table and constraint)
@@ -534,6 +757,35 @@ class DatabaseModel:  public QObject, public BaseObject {
 		meaning that ALL objects directly or inderectly linked to the 'object' are retrieved. */
 		void __getObjectReferences(BaseObject *object, vector<BaseObject *> &refs, bool exclude_perms=false);
 
+		/*! \brief Compares the references returned by the reference graph against the ones found by scanning
+		the whole model for every object (and table child object) in the model. Returns true when both results match.
+		The objects for which the results diverge are stored in the optional list */
+		bool isReferenceGraphConsistent(vector<BaseObject *> *diverging_objs=nullptr);
+
+		/*! \brief Enables or disables the use of the reference graph by getObjectReferences(). When disabled
+		the references are determined by scanning the whole model */
+		static void enableReferenceGraph(bool value);
+
+		//! \brief Returns if the reference graph is being used by getObjectReferences()
+		static bool isReferenceGraphEnabled(void);
+
+		/*! \brief Enables or disables the parallel code generation in getCodeDefinition(). The generated code is the
+		same in both modes. The parallel generation is only performed when the cached code is enabled */
+		static void enableParallelCodeGeneration(bool value);
+
+		//! \brief Returns if the parallel code generation is enabled
+		static bool isParallelCodeGenerationEnabled(void);
+
+		/*! \brief Enables or disables the code cache file. When enabled, saving the model in XML stores the objects' code
+		in a file in the configurations dir and loading the same model restores the code avoiding its regeneration */
+		static void enableCodeCache(bool value);
+
+		//! \brief Returns if the code cache file is enabled
+		static bool isCodeCacheEnabled(void);
+
+		//! \brief Defines the directory where the code cache files are stored. An empty path restores the default one
+		static void setCodeCacheDirectory(const QString &dir);
+
 		/*! \brief Marks the graphical objects as modified forcing their redraw. User can specify only a set of
 	 graphical objects to be marked */
 		void setObjectsModified(vector<ObjectType> types={});
@@ -157,6 +157,9 @@ void Operator::setArgumentType(PgSQLType arg_type, unsigned arg_id)
 	if(arg_id > RIGHT_ARG)
 		throw Exception( ERR_REF_OPER_ARG_INV_TYPE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
+	if(argument_types[arg_id] != arg_type)
+		setSignatureChanged();
+
 	setCodeInvalidated(argument_types[arg_id] != arg_type);
 	argument_types[arg_id]=arg_type;
 }
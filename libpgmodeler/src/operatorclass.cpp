@@ -53,6 +53,9 @@ void OperatorClass::setFamily(OperatorFamily *family)
 
 void OperatorClass::setIndexingType(IndexingType index_type)
 {
+	if(indexing_type != index_type)
+		setSignatureChanged();
+
 	setCodeInvalidated(indexing_type != index_type);
 	this->indexing_type=index_type;
 }
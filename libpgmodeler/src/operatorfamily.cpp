@@ -26,6 +26,9 @@ OperatorFamily::OperatorFamily(void)
 
 void OperatorFamily::setIndexingType(IndexingType idx_type)
 {
+	if(indexing_type != idx_type)
+		setSignatureChanged();
+
 	setCodeInvalidated(indexing_type != idx_type);
 	indexing_type=idx_type;
 }
@@ -223,7 +223,7 @@ namespace PgModelerNS {
 			if(!keywords.contains(chr))
 				return(false);
 			else
-				return(keywords[chr].contains(word.toUpper()));
+				return(keywords.value(chr).contains(word.toUpper()));
 		}
 	}
 }
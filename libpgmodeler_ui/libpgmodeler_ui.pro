@@ -108,7 +108,8 @@ SOURCES += src/mainwindow.cpp \
     src/welcomewidget.cpp \
 		src/tabledatawidget.cpp \
 		src/plaintextitemdelegate.cpp \
-    src/csvloadwidget.cpp
+    src/csvloadwidget.cpp \
+		src/resultsetmodel.cpp
 
 HEADERS += src/mainwindow.h \
 	   src/modelwidget.h \
@@ -203,7 +204,8 @@ HEADERS += src/mainwindow.h \
     src/welcomewidget.h \
 		src/tabledatawidget.h \
 		src/plaintextitemdelegate.h \
-    src/csvloadwidget.h
+    src/csvloadwidget.h \
+		src/resultsetmodel.h
 
 FORMS += ui/mainwindow.ui \
 	 ui/textboxwidget.ui \
@@ -25,6 +25,7 @@ CsvLoadWidget::CsvLoadWidget(QWidget * parent, bool cols_in_first_row) : QWidget
 {
 	setupUi(this);
 	separator_edt->setVisible(false);
+	setBulkLoadVisible(false);
 
 	if(!cols_in_first_row)
 	{
@@ -41,6 +42,7 @@ CsvLoadWidget::CsvLoadWidget(QWidget * parent, bool cols_in_first_row) : QWidget
 	connect(select_file_tb, SIGNAL(clicked(bool)), this, SLOT(selectCsvFile()));
 	connect(txt_delim_chk, SIGNAL(toggled(bool)), txt_delim_edt, SLOT(setEnabled(bool)));
 	connect(load_btn, SIGNAL(clicked(bool)), this, SLOT(loadCsvFile()));
+	connect(bulk_load_btn, SIGNAL(clicked(bool)), this, SIGNAL(s_csvBulkLoadRequested()));
 
 	connect(separator_cmb, &QComboBox::currentTextChanged, [=](){
 			separator_edt->setVisible(separator_cmb->currentIndex() == separator_cmb->count()-1);
@@ -48,6 +50,7 @@ CsvLoadWidget::CsvLoadWidget(QWidget * parent, bool cols_in_first_row) : QWidget
 
 	connect(file_edt, &QLineEdit::textChanged, [=](){
 		load_btn->setEnabled(!file_edt->text().isEmpty());
+		bulk_load_btn->setEnabled(!file_edt->text().isEmpty());
 	});
 }
 
@@ -100,13 +103,10 @@ void CsvLoadWidget::loadCsvFile(void)
 	{
 		QString	double_quote=QString("%1%1").arg(txt_delim_edt->text()),
 				placeholder = QString("⁋"), separator;
-		QStringList separators={ QString(";"), QString(","), QString(" "), QString("\t") },
-				values, rows;
+		QStringList values, rows;
 		QRegExp empty_val;
 
-		//If no custom separator is specified we use the default ';'
-		separators += (separator_edt->text().isEmpty() ? QString(";") : separator_edt->text());
-		separator = separators[separator_cmb->currentIndex()];
+		separator = getSeparator();
 		rows=csv_buffer.split(QChar::LineFeed, QString::SkipEmptyParts);
 
 		if(col_names_chk->isChecked())
@@ -167,3 +167,48 @@ bool CsvLoadWidget::isColumnsInFirstRow(void)
 {
 	return(col_names_chk->isChecked());
 }
+
+QString CsvLoadWidget::getSeparator(void)
+{
+	QStringList separators={ QString(";"), QString(","), QString(" "), QString("\t") };
+
+	//If no custom separator is specified we use the default ';'
+	separators += (separator_edt->text().isEmpty() ? QString(";") : separator_edt->text());
+	return(separators[separator_cmb->currentIndex()]);
+}
+
+QString CsvLoadWidget::getTextDelimiter(void)
+{
+	return(txt_delim_edt->text());
+}
+
+QString CsvLoadWidget::getCsvFile(void)
+{
+	return(file_edt->text());
+}
+
+void CsvLoadWidget::setBulkLoadVisible(bool value)
+{
+	bulk_load_btn->setVisible(value);
+	bulk_load_pb->setVisible(false);
+}
+
+void CsvLoadWidget::updateBulkLoadProgress(qint64 sent_bytes, qint64 total_bytes)
+{
+	if(sent_bytes < 0 || total_bytes <= 0)
+	{
+		bulk_load_pb->setValue(0);
+		bulk_load_pb->setVisible(false);
+		bulk_load_btn->setEnabled(!file_edt->text().isEmpty());
+		load_btn->setEnabled(!file_edt->text().isEmpty());
+		return;
+	}
+
+	//The buttons stay disabled while the file is being sent
+	bulk_load_btn->setEnabled(false);
+	load_btn->setEnabled(false);
+	bulk_load_pb->setVisible(true);
+
+	//QProgressBar repaints itself immediately so the progress is visible even while the event loop is blocked
+	bulk_load_pb->setValue(static_cast<int>((sent_bytes * 100) / total_bytes));
+}
@@ -55,12 +55,31 @@ class CsvLoadWidget : public QWidget, Ui::CsvLoadWidget {
 
 		bool isColumnsInFirstRow(void);
 
+		//! \brief Returns the values separator configured in the widget
+		QString getSeparator(void);
+
+		//! \brief Returns the text delimiter configured in the widget
+		QString getTextDelimiter(void);
+
+		//! \brief Returns the currently selected csv file
+		QString getCsvFile(void);
+
+		//! \brief Shows/hides the controls used to request the bulk load of the selected file (see s_csvBulkLoadRequested())
+		void setBulkLoadVisible(bool value);
+
+		/*! \brief Updates the bulk load progress bar according to the amount of bytes already sent from the file (total_bytes).
+		Passing a negative value resets and hides the progress bar */
+		void updateBulkLoadProgress(qint64 sent_bytes, qint64 total_bytes);
+
 	private slots:
 		void selectCsvFile(void);
 		void loadCsvFile(void);
 
 	signals:
 		void s_csvFileLoaded(void);
+
+		//! \brief Signal emitted when the user requests the selected file to be sent directly to the database
+		void s_csvBulkLoadRequested(void);
 };
 
 #endif
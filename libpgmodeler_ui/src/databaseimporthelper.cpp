@@ -28,6 +28,8 @@ DatabaseImportHelper::DatabaseImportHelper(QObject *parent) : QObject(parent)
 	import_canceled=ignore_errors=import_sys_objs=import_ext_objs=rand_rel_colors=update_fk_rels=false;
 	auto_resolve_deps=true;
 	import_filter=Catalog::LIST_ALL_OBJS | Catalog::EXCL_EXTENSION_OBJS | Catalog::EXCL_SYSTEM_OBJS;
+	retrieval_conns=std::max(1, std::min(QThread::idealThreadCount(), 4));
+	retrieval_queries=0;
 	xmlparser=nullptr;
 	dbmodel=nullptr;
 }
@@ -114,6 +116,16 @@ unsigned DatabaseImportHelper::getLastSystemOID(void)
 	return(catalog.getLastSysObjectOID());
 }
 
+unsigned DatabaseImportHelper::getCatalogQueryCount(void)
+{
+	return(catalog.getQueryCount() + retrieval_queries);
+}
+
+void DatabaseImportHelper::setRetrievalConnections(unsigned count)
+{
+	retrieval_conns=count;
+}
+
 QString DatabaseImportHelper::getCurrentDatabase(void)
 {
 	return(connection.getConnectionParam(Connection::PARAM_DB_NAME));
@@ -169,101 +181,367 @@ void DatabaseImportHelper::swapSequencesTablesIds(void)
 
 void DatabaseImportHelper::retrieveSystemObjects(void)
 {
-	int progress=0;
-	vector<attribs_map>::iterator itr;
+	vector<ObjectType> sys_objs={ OBJ_SCHEMA, OBJ_ROLE, OBJ_TABLESPACE,
+																OBJ_LANGUAGE, /* OBJ_COLLATION,*/ OBJ_TYPE };
+	vector<unsigned> filters;
+	vector<vector<attribs_map>> objects;
 	map<unsigned, attribs_map> *obj_map=nullptr;
-	vector<attribs_map> objects;
-	ObjectType sys_objs[]={ OBJ_SCHEMA, OBJ_ROLE, OBJ_TABLESPACE,
-							OBJ_LANGUAGE, /* OBJ_COLLATION,*/ OBJ_TYPE };
-	unsigned i=0, oid=0, cnt=sizeof(sys_objs)/sizeof(ObjectType);
+	unsigned oid=0;
 
-	for(i=0; i < cnt && !import_canceled; i++)
+	for(auto &obj_type : sys_objs)
 	{
-		emit s_progressUpdated(progress,
-								 trUtf8("Retrieving system objects... `%1'").arg(BaseObject::getTypeName(sys_objs[i])),
-							   sys_objs[i]);
+		if(obj_type!=OBJ_TYPE && obj_type!=OBJ_LANGUAGE)
+			filters.push_back(Catalog::LIST_ONLY_SYS_OBJS);
+		else
+			filters.push_back(Catalog::LIST_ALL_OBJS);
+	}
 
-		if(sys_objs[i]!=OBJ_TYPE)
-		{
-			obj_map=&system_objs;
+	//Query the objects on the catalog and put them on the maps
+	retrieveObjectsAttributes(sys_objs, filters, vector<vector<unsigned>>(sys_objs.size()), objects,
+														trUtf8("Retrieving system objects... `%1'"));
 
-			if(sys_objs[i]!=OBJ_LANGUAGE)
-				catalog.setFilter(Catalog::LIST_ONLY_SYS_OBJS);
-			else
-				catalog.setFilter(Catalog::LIST_ALL_OBJS);
-		}
-		else
+	for(unsigned i=0; i < sys_objs.size() && !import_canceled; i++)
+	{
+		obj_map=(sys_objs[i]!=OBJ_TYPE ? &system_objs : &types);
+
+		for(auto &attribs : objects[i])
 		{
-			obj_map=&types;
-			catalog.setFilter(Catalog::LIST_ALL_OBJS);
+			oid=attribs.at(ParsersAttributes::OID).toUInt();
+			(*obj_map)[oid]=attribs;
 		}
+	}
+}
 
-		//Query the objects on the catalog and put them on the map
-		objects=catalog.getObjectsAttributes(sys_objs[i]);
-		itr=objects.begin();
+void DatabaseImportHelper::retrieveUserObjects(void)
+{
+	vector<ObjectType> obj_types;
+	vector<unsigned> filters;
+	vector<vector<unsigned>> oids;
+	vector<vector<attribs_map>> objects;
+	unsigned oid=0;
 
-		while(itr!=objects.end() && !import_canceled)
+	//Retrieving selected database level objects and table children objects (except columns)
+	for(auto &itr : object_oids)
+	{
+		obj_types.push_back(itr.first);
+		filters.push_back(import_filter);
+		oids.push_back(itr.second);
+	}
+
+	retrieveObjectsAttributes(obj_types, filters, oids, objects, trUtf8("Retrieving objects... `%1'"));
+
+	for(unsigned i=0; i < objects.size() && !import_canceled; i++)
+	{
+		for(auto &attribs : objects[i])
 		{
-			oid=itr->at(ParsersAttributes::OID).toUInt();
-			(*obj_map)[oid]=(*itr);
-			itr++;
+			oid=attribs.at(ParsersAttributes::OID).toUInt();
+			user_objs[oid]=attribs;
 		}
+	}
+
+	catalog.setFilter(import_filter);
+
+	//Retrieving all selected table columns
+	if(!column_oids.empty() && !import_canceled)
+	{
+		emit s_progressUpdated(100,
+								 trUtf8("Retrieving objects... `%1'").arg(BaseObject::getTypeName(OBJ_COLUMN)),
+							   OBJ_COLUMN);
 
-		progress=(i/static_cast<float>(cnt))*10;
+		retrieveTablesColumns(column_oids);
 	}
 }
 
-void DatabaseImportHelper::retrieveUserObjects(void)
+void DatabaseImportHelper::retrieveObjectsAttributes(const vector<ObjectType> &obj_types, const vector<unsigned> &filters, const vector<vector<unsigned>> &oids,
+																										 vector<vector<attribs_map>> &results, const QString &progress_msg)
 {
+	vector<int> status(obj_types.size(), 0);
+	vector<Exception> errors(obj_types.size());
+	vector<Exception> conn_errors;
+	QThreadPool thread_pool;
+	QList<QFuture<void>> futures;
+	QAtomicInt next_type(0), query_count(0);
+	unsigned thread_cnt=std::min<unsigned>(retrieval_conns, obj_types.size()), i;
 	int progress=0;
-	map<ObjectType, vector<unsigned>>::iterator oid_itr=object_oids.begin();
-	vector<attribs_map>::iterator itr;
-	vector<attribs_map> objects;
-	unsigned i=0, oid=0;
-	map<unsigned, vector<unsigned>>::iterator col_itr;
-	QStringList names;
 
-	i=0;
-	catalog.setFilter(import_filter);
+	results.clear();
+	results.resize(obj_types.size());
 
-	//Retrieving selected database level objects and table children objects (except columns)
-	while(oid_itr!=object_oids.end() && !import_canceled)
+	/* The object types are independent from each other so each one is retrieved by the first available connection.
+	All connections share the same snapshot so the retrieved objects are consistent with each other */
+	if(!snapshot_id.isEmpty() && thread_cnt > 1)
 	{
 		emit s_progressUpdated(progress,
-								 trUtf8("Retrieving objects... `%1'").arg(BaseObject::getTypeName(oid_itr->first)),
-							   oid_itr->first);
+								 trUtf8("Retrieving %1 object types using %2 connections...").arg(obj_types.size()).arg(thread_cnt),
+							   BASE_OBJECT);
 
-		objects=catalog.getObjectsAttributes(oid_itr->first, QString(), QString(), oid_itr->second);
-		itr=objects.begin();
+		//A dedicated pool is used so all the retrieval connections run at the same time regardless of the global pool's size
+		thread_pool.setMaxThreadCount(thread_cnt);
+		conn_errors.resize(thread_cnt);
 
-		while(itr!=objects.end() && !import_canceled)
+		for(i=0; i < thread_cnt; i++)
 		{
-			oid=itr->at(ParsersAttributes::OID).toUInt();
-			user_objs[oid]=(*itr);
-			itr++;
+			Exception *conn_error=&conn_errors[i];
+
+			futures.push_back(QtConcurrent::run(&thread_pool, [&, conn_error](){
+				retrieveObjectsAttributesThread(&catalog, snapshot_id, &obj_types, &filters, &oids, &import_canceled,
+																				&next_type, &query_count, &results, &status, &errors, conn_error);
+			}));
 		}
 
-		objects.clear();
-		progress=(i/static_cast<float>(object_oids.size()))*100;
-		oid_itr++; i++;
+		for(auto &future : futures)
+			future.waitForFinished();
+
+		retrieval_queries+=query_count.load();
+
+		/* Connections that failed to be opened or attached to the snapshot are reported so the user is aware
+		of why part of the types will be retrieved sequentially by the helper's catalog */
+		for(auto &conn_error : conn_errors)
+		{
+			if(conn_error.getErrorMessage().isEmpty())
+				continue;
+
+			emit s_progressUpdated(progress,
+									 trUtf8("A retrieval connection failed, the remaining object types will be retrieved sequentially: %1")
+									 .arg(conn_error.getErrorMessage()), BASE_OBJECT);
+
+			if(debug_mode)
+			{
+				QTextStream ts(stdout);
+				ts << QString("<!-- Retrieval connection failed: %1 -->").arg(conn_error.getExceptionsText()) << endl;
+			}
+		}
 	}
 
-	//Retrieving all selected table columns
-	i=0;
-	col_itr=column_oids.begin();
-	while(col_itr!=column_oids.end())
+	for(i=0; i < obj_types.size() && !import_canceled; i++)
 	{
-		emit s_progressUpdated(progress,
-								 trUtf8("Retrieving objects... `%1'").arg(BaseObject::getTypeName(OBJ_COLUMN)),
-							   OBJ_COLUMN);
+		if(status[i] < 0)
+			throw Exception(errors[i].getErrorMessage(), errors[i].getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &errors[i]);
+
+		//Types not handled by the retrieval threads (e.g. a connection could not be opened) are retrieved by the helper's catalog
+		if(status[i]==0)
+		{
+			emit s_progressUpdated(progress, progress_msg.arg(BaseObject::getTypeName(obj_types[i])), obj_types[i]);
+
+			catalog.setFilter(filters[i]);
+			results[i]=catalog.getObjectsAttributes(obj_types[i], QString(), QString(), oids[i]);
+		}
+
+		progress=(i/static_cast<float>(obj_types.size()))*100;
+	}
+}
+
+void DatabaseImportHelper::retrieveObjectsAttributesThread(const Catalog *src_catalog, const QString snapshot_id, const vector<ObjectType> *obj_types,
+																													 const vector<unsigned> *filters, const vector<vector<unsigned>> *oids, const std::atomic<bool> *canceled,
+																													 QAtomicInt *next_type, QAtomicInt *query_count, vector<vector<attribs_map>> *results,
+																													 vector<int> *status, vector<Exception> *errors, Exception *conn_error)
+{
+	int type_idx=0;
+
+	try
+	{
+		Catalog catalog(*src_catalog);
+
+		catalog.importSnapshot(snapshot_id);
+		type_idx=next_type->fetchAndAddOrdered(1);
+
+		while(type_idx < static_cast<int>(obj_types->size()) && !canceled->load())
+		{
+			try
+			{
+				catalog.setFilter(filters->at(type_idx));
+				results->at(type_idx)=catalog.getObjectsAttributes(obj_types->at(type_idx), QString(), QString(), oids->at(type_idx));
+				status->at(type_idx)=1;
+			}
+			catch(Exception &e)
+			{
+				errors->at(type_idx)=Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+				status->at(type_idx)=-1;
+			}
+
+			type_idx=next_type->fetchAndAddOrdered(1);
+		}
+
+		catalog.finishSnapshot();
+		catalog.closeConnection();
+		query_count->fetchAndAddOrdered(catalog.getQueryCount());
+	}
+	catch(Exception &e)
+	{
+		/* Errors related to the connection itself don't abort the import since the object types that this thread
+		couldn't retrieve are retrieved afterwards by the helper's catalog. The error is only stored to be reported */
+		(*conn_error)=Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
 
-		names=getObjectName(QString::number(col_itr->first)).split(".");
+void DatabaseImportHelper::retrieveTablesColumns(const map<unsigned, vector<unsigned>> &col_ids)
+{
+	try
+	{
+		vector<attribs_map> cols;
+		unsigned tab_oid=0, col_oid;
 
-		if(names.size() > 1)
-			retrieveTableColumns(names[0], names[1], col_itr->second);
+		cols=catalog.getColumnsAttributes(col_ids);
 
-		progress=(i/static_cast<float>(column_oids.size()))*100;
-		col_itr++; i++;
+		for(auto &itr : cols)
+		{
+			col_oid=itr.at(ParsersAttributes::OID).toUInt();
+			tab_oid=itr.at(ParsersAttributes::TABLE).toUInt();
+			columns[tab_oid][col_oid]=itr;
+		}
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+bool DatabaseImportHelper::isDependencyResolvable(unsigned oid)
+{
+	return((import_ext_objs && catalog.isExtensionObject(oid)) ||
+		   (import_sys_objs  && oid <= catalog.getLastSysObjectOID()) ||
+		   (oid > catalog.getLastSysObjectOID() && !catalog.isExtensionObject(oid)));
+}
+
+void DatabaseImportHelper::prefetchDependencies(void)
+{
+	//Attributes that hold the oid of a dependency, grouped by the dependency type
+	static const map<ObjectType, vector<QString>> dep_attribs={
+		{ OBJ_ROLE, { ParsersAttributes::OWNER } },
+		{ OBJ_TABLESPACE, { ParsersAttributes::TABLESPACE } },
+		{ OBJ_SCHEMA, { ParsersAttributes::SCHEMA } },
+		{ OBJ_COLLATION, { ParsersAttributes::COLLATION } },
+		{ OBJ_LANGUAGE, { ParsersAttributes::LANGUAGE } },
+		{ OBJ_TABLE, { ParsersAttributes::TABLE, ParsersAttributes::REF_TABLE } },
+		{ OBJ_OPERATOR, { ParsersAttributes::SORT_OP, ParsersAttributes::COMMUTATOR_OP, ParsersAttributes::NEGATOR_OP } },
+		{ OBJ_FUNCTION, { ParsersAttributes::FUNCTION, ParsersAttributes::TRIGGER_FUNC,
+											ParsersAttributes::VALIDATOR_FUNC, ParsersAttributes::HANDLER_FUNC, ParsersAttributes::INLINE_FUNC,
+											ParsersAttributes::OPERATOR_FUNC, ParsersAttributes::RESTRICTION_FUNC, ParsersAttributes::JOIN_FUNC,
+											ParsersAttributes::TRANSITION_FUNC, ParsersAttributes::FINAL_FUNC,
+											ParsersAttributes::INPUT_FUNC, ParsersAttributes::OUTPUT_FUNC, ParsersAttributes::RECV_FUNC,
+											ParsersAttributes::SEND_FUNC, ParsersAttributes::TPMOD_IN_FUNC, ParsersAttributes::TPMOD_OUT_FUNC,
+											ParsersAttributes::ANALYZE_FUNC } },
+		{ OBJ_TYPE, { ParsersAttributes::TYPE, ParsersAttributes::TYPE_OID, ParsersAttributes::RETURN_TYPE,
+									ParsersAttributes::SOURCE_TYPE, ParsersAttributes::DEST_TYPE, ParsersAttributes::ELEMENT,
+									ParsersAttributes::LEFT_TYPE, ParsersAttributes::RIGHT_TYPE, ParsersAttributes::STATE_TYPE,
+									ParsersAttributes::STORAGE } }
+	};
+
+	try
+	{
+		map<ObjectType, vector<unsigned>> dep_oids;
+		map<unsigned, vector<unsigned>> tab_cols;
+		map<unsigned, bool> requested;
+		map<unsigned, attribs_map> *obj_map=nullptr;
+		vector<attribs_map *> pending, user_types;
+		vector<ObjectType> obj_types;
+		vector<vector<unsigned>> oids;
+		vector<vector<attribs_map>> objects;
+		attribs_map::iterator attr_itr;
+		unsigned oid=0;
+
+		for(auto &itr : user_objs)
+			pending.push_back(&itr.second);
+
+		//The selected columns are included since they reference types and collations
+		for(auto &tab : columns)
+		{
+			for(auto &col : tab.second)
+				pending.push_back(&col.second);
+		}
+
+		while(!pending.empty() && !import_canceled)
+		{
+			dep_oids.clear();
+			user_types.clear();
+
+			//Gathering the oids of the references that aren't retrieved yet
+			for(auto &attribs : pending)
+			{
+				for(auto &dep : dep_attribs)
+				{
+					for(auto &attr : dep.second)
+					{
+						attr_itr=attribs->find(attr);
+						if(attr_itr==attribs->end())
+							continue;
+
+						oid=attr_itr->second.toUInt();
+
+						/* All types are retrieved with the system objects so no query is needed for them. Instead, the user defined
+						ones have their own references (schema, owner, functions, etc) gathered in the next iteration */
+						if(dep.first==OBJ_TYPE)
+						{
+							if(oid > catalog.getLastSysObjectOID() && types.count(oid) && requested.count(oid)==0)
+							{
+								requested[oid]=true;
+								user_types.push_back(&types[oid]);
+							}
+
+							continue;
+						}
+
+						if(oid > 0 && requested.count(oid)==0 &&
+							 system_objs.count(oid)==0 && user_objs.count(oid)==0 &&
+							 isDependencyResolvable(oid))
+						{
+							requested[oid]=true;
+							dep_oids[dep.first].push_back(oid);
+						}
+					}
+				}
+			}
+
+			pending=user_types;
+			obj_types.clear();
+			oids.clear();
+
+			for(auto &dep : dep_oids)
+			{
+				obj_types.push_back(dep.first);
+				oids.push_back(dep.second);
+			}
+
+			//Retrieving the attributes of each dependency type in a single query
+			retrieveObjectsAttributes(obj_types, vector<unsigned>(obj_types.size(), Catalog::LIST_ALL_OBJS), oids,
+																objects, trUtf8("Retrieving dependencies... `%1'"));
+
+			for(unsigned i=0; i < objects.size() && !import_canceled; i++)
+			{
+				for(auto &attribs : objects[i])
+				{
+					oid=attribs.at(ParsersAttributes::OID).toUInt();
+					obj_map=(oid <= catalog.getLastSysObjectOID() ? &system_objs : &user_objs);
+					(*obj_map)[oid]=attribs;
+					pending.push_back(&(*obj_map)[oid]);
+				}
+			}
+		}
+
+		//Retrieving at once the columns of the tables that have none of them retrieved yet
+		for(auto &itr : user_objs)
+		{
+			if(itr.second[ParsersAttributes::OBJECT_TYPE].toUInt()==OBJ_TABLE && columns[itr.first].empty())
+				tab_cols[itr.first];
+		}
+
+		if(!tab_cols.empty() && !import_canceled)
+		{
+			emit s_progressUpdated(100,
+									 trUtf8("Retrieving dependencies... `%1'").arg(BaseObject::getTypeName(OBJ_COLUMN)),
+								   OBJ_COLUMN);
+
+			catalog.setFilter(Catalog::LIST_ALL_OBJS);
+			retrieveTablesColumns(tab_cols);
+		}
+
+		catalog.setFilter(import_filter);
+	}
+	catch(Exception &e)
+	{
+		//Restoring the import filter changed by the retrieval of the dependencies
+		catalog.setFilter(import_filter);
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
 	}
 }
 
@@ -546,8 +824,26 @@ void DatabaseImportHelper::importDatabase(void)
 		if(!dbmodel)
 			throw Exception(ERR_OPR_NOT_ALOC_OBJECT ,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
+		catalog.resetQueryCount();
+		retrieval_queries=0;
+
+		/* Exporting the snapshot of the helper's connection so the objects can be retrieved
+		concurrently by other connections reading the same database state */
+		if(retrieval_conns > 1)
+			snapshot_id=catalog.exportSnapshot();
+
 		retrieveSystemObjects();
 		retrieveUserObjects();
+
+		if(auto_resolve_deps)
+			prefetchDependencies();
+
+		if(!snapshot_id.isEmpty())
+		{
+			catalog.finishSnapshot();
+			snapshot_id.clear();
+		}
+
 		createObjects();
 		createTableInheritances();
 		createConstraints();
@@ -568,6 +864,12 @@ void DatabaseImportHelper::importDatabase(void)
 			swapSequencesTablesIds();
 			assignSequencesToColumns();
 
+			if(debug_mode)
+			{
+				QTextStream ts(stdout);
+				ts << QString("<!-- Catalog queries issued: %1 -->").arg(getCatalogQueryCount()) << endl;
+			}
+
 			if(!errors.empty())
 			{
 				QString log_name;
@@ -633,6 +935,17 @@ void DatabaseImportHelper::importDatabase(void)
 	}
 	catch(Exception &e)
 	{
+		//Ending the transaction that holds the exported snapshot so the connection isn't left idle in transaction
+		if(!snapshot_id.isEmpty())
+		{
+			try
+			{
+				catalog.finishSnapshot();
+			}
+			catch(Exception &)
+			{}
+		}
+
 		resetImportParameters();
 
 		/* When running in a separated thread (other than the main application thread)
@@ -774,10 +1087,7 @@ QString DatabaseImportHelper::getDependencyObject(const QString &oid, ObjectType
 
 			/* If the attributes for the dependency does not exists and the automatic dependency
 			resolution is enable, the object's attributes will be retrieved from catalog */
-			if(auto_resolve_deps && obj_attr.empty() &&
-					((import_ext_objs && catalog.isExtensionObject(obj_oid)) ||
-					 (import_sys_objs  && obj_oid <= catalog.getLastSysObjectOID()) ||
-					 (obj_oid > catalog.getLastSysObjectOID() && !catalog.isExtensionObject(obj_oid))))
+			if(auto_resolve_deps && obj_attr.empty() && isDependencyResolvable(obj_oid))
 			{
 				catalog.setFilter(Catalog::LIST_ALL_OBJS);
 				vector<attribs_map> attribs_vect=catalog.getObjectsAttributes(obj_type,QString(),QString(), { obj_oid });
@@ -870,6 +1180,7 @@ void DatabaseImportHelper::resetImportParameters(void)
 	Connection::setPrintSQL(false);
 	import_canceled=false;
 	dbmodel=nullptr;
+	snapshot_id.clear();
 	column_oids.clear();
 	object_oids.clear();
 	types.clear();
@@ -30,6 +30,10 @@
 #include "catalog.h"
 #include "modelwidget.h"
 #include <random>
+#include <QAtomicInt>
+#include <QtConcurrent>
+#include <QThreadPool>
+#include <atomic>
 
 class DatabaseImportHelper: public QObject {
 	private:
@@ -54,13 +58,24 @@ class DatabaseImportHelper: public QObject {
 		Connection connection;
 		
 		//! \brief Stores the current configured catalog filter
-		unsigned import_filter;
-		
-		//! \brief Indicates that import was canceled by user (only on thread mode)
-		bool import_canceled,
+		unsigned import_filter,
+
+		//! \brief Maximum amount of connections used to retrieve the objects from catalog concurrently
+		retrieval_conns,
+
+		//! \brief Amount of catalog queries sent by the connections used in the concurrent retrieval
+		retrieval_queries;
+
+		/*! \brief Id of the snapshot exported by the helper's catalog and shared by the connections used
+		in the concurrent retrieval so all of them read the same database state */
+		QString snapshot_id;
 		
+		/*! \brief Indicates that import was canceled by user (only on thread mode). This flag is atomic since
+		it's also read by the threads that retrieve the objects concurrently */
+		std::atomic<bool> import_canceled;
+
 		//! \brief Indicates that import must ignore any error generated during the import
-		ignore_errors,
+		bool ignore_errors,
 		
 		//! \brief Enables the import of system objects (under pg_catalog / information_schema)
 		import_sys_objs,
@@ -185,6 +200,33 @@ class DatabaseImportHelper: public QObject {
 		//! \brief Returns the type names or xml code for the specified oid vector
 		QStringList getTypes(const QString &oid_vect, bool generate_xml);
 		
+		/*! \brief Retrieves from catalog the attributes of the objects of each type in obj_types using the respective filter and oids,
+		storing them in the same position of the results vector. When a snapshot was exported and more than one retrieval connection is
+		configured the types are retrieved concurrently by separated connections, otherwise, they are retrieved sequentially by the helper's catalog.
+		The progress message must contain the %1 placeholder which is replaced by the name of the type being retrieved */
+		void retrieveObjectsAttributes(const vector<ObjectType> &obj_types, const vector<unsigned> &filters, const vector<vector<unsigned>> &oids,
+																	 vector<vector<attribs_map>> &results, const QString &progress_msg);
+
+		/*! \brief Retrieves the attributes of the object types until there is no type left. This method is the one executed by each
+		retrieval thread which uses its own copy of the helper's catalog attached to the exported snapshot. The status of each type is set
+		to 1 when successfully retrieved or -1 when an error was raised (the error is stored in the type's position of the errors vector).
+		Failures to open the connection or to attach it to the snapshot are stored in conn_error */
+		static void retrieveObjectsAttributesThread(const Catalog *src_catalog, const QString snapshot_id, const vector<ObjectType> *obj_types,
+																								const vector<unsigned> *filters, const vector<vector<unsigned>> *oids, const std::atomic<bool> *canceled,
+																								QAtomicInt *next_type, QAtomicInt *query_count, vector<vector<attribs_map>> *results,
+																								vector<int> *status, vector<Exception> *errors, Exception *conn_error);
+
+		/*! \brief Returns if the dependency identified by the oid can be retrieved from catalog according to
+		the current import options (system objects, extension objects) */
+		bool isDependencyResolvable(unsigned oid);
+
+		/*! \brief Retrieves in bulk, one query per object type, the attributes of all objects referenced by the retrieved ones
+		that are not yet in the system or user objects maps. The process is repeated for the newly retrieved objects until no
+		unknown reference remains. The user defined types referenced by the objects and columns (already retrieved with the
+		system objects) have their references prefetched too. This avoids querying the catalog for each dependency in
+		getDependencyObject(). The catalog filter is restored to the import filter even when an error is raised */
+		void prefetchDependencies(void);
+
 		/*! \brief Returns the xml definition for the specified oid. If the boolean param 'use_signature' is true then the method will
 		return the xml definition with signature attribute instead of name. If the param 'recursive_dep_res' is true the method will
 		create a dependency if it's attributes exists but it doesn't exists on the model yet (note: this is different from auto_resolve_deps attribute) */
@@ -225,6 +267,13 @@ class DatabaseImportHelper: public QObject {
 		
 		//! \brief Returns the last system OID value for the current database
 		unsigned getLastSystemOID(void);
+
+		//! \brief Returns the amount of catalog queries sent to the server by the last import
+		unsigned getCatalogQueryCount(void);
+
+		/*! \brief Sets the maximum amount of connections used to retrieve the objects from catalog concurrently.
+		A value lower than 2 causes the objects to be retrieved sequentially using the helper's connection */
+		void setRetrievalConnections(unsigned count);
 		
 		//! \brief Returns the current database in which the helper is working on
 		QString getCurrentDatabase(void);
@@ -255,6 +304,9 @@ class DatabaseImportHelper: public QObject {
 		void retrieveSystemObjects(void);
 		void retrieveUserObjects(void);
 		void retrieveTableColumns(const QString &sch_name, const QString &tab_name, vector<unsigned> col_ids={});
+
+		//! \brief Retrieves using a single query the columns of the specified tables (see Catalog::getColumnsAttributes())
+		void retrieveTablesColumns(const map<unsigned, vector<unsigned>> &col_ids);
 		void createObjects(void);
 		void createConstraints(void);
 		void createPermissions(void);
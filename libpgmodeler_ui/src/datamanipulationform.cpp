@@ -44,6 +44,7 @@ DataManipulationForm::DataManipulationForm(QWidget * parent, Qt::WindowFlags f):
 	results_tbw->setItemDelegate(new PlainTextItemDelegate(this, false));
 
 	refresh_tb->setToolTip(refresh_tb->toolTip() + QString(" (%1)").arg(refresh_tb->shortcut().toString()));
+	stop_tb->setToolTip(stop_tb->toolTip() + QString(" (%1)").arg(stop_tb->shortcut().toString()));
 	save_tb->setToolTip(save_tb->toolTip() + QString(" (%1)").arg(save_tb->shortcut().toString()));
 	undo_tb->setToolTip(undo_tb->toolTip() + QString(" (%1)").arg(undo_tb->shortcut().toString()));
 	export_tb->setToolTip(export_tb->toolTip() + QString(" (%1)").arg(export_tb->shortcut().toString()));
@@ -59,6 +60,7 @@ DataManipulationForm::DataManipulationForm(QWidget * parent, Qt::WindowFlags f):
 	csv_load_parent->setVisible(false);
 
 	csv_load_wgt = new CsvLoadWidget(this, false);
+	csv_load_wgt->setBulkLoadVisible(true);
 	QVBoxLayout *layout = new QVBoxLayout;
 
 	layout->addWidget(csv_load_wgt);
@@ -75,12 +77,12 @@ DataManipulationForm::DataManipulationForm(QWidget * parent, Qt::WindowFlags f):
 	connect(table_cmb, SIGNAL(currentIndexChanged(int)), this, SLOT(listColumns()));
 	connect(table_cmb, SIGNAL(currentIndexChanged(int)), this, SLOT(retrieveData()));
 	connect(refresh_tb, SIGNAL(clicked()), this, SLOT(retrieveData()));
+	connect(stop_tb, SIGNAL(clicked()), this, SLOT(cancelDataRetrieval()));
 	connect(add_ord_col_tb, SIGNAL(clicked()), this, SLOT(addColumnToList()));
 	connect(ord_columns_lst, SIGNAL(itemDoubleClicked(QListWidgetItem*)), this, SLOT(removeColumnFromList()));
 	connect(ord_columns_lst, SIGNAL(itemPressed(QListWidgetItem*)), this, SLOT(changeOrderMode(QListWidgetItem*)));
 	connect(rem_ord_col_tb, SIGNAL(clicked()), this, SLOT(removeColumnFromList()));
 	connect(clear_ord_cols_tb, SIGNAL(clicked()), this, SLOT(clearColumnList()));
-	connect(results_tbw, SIGNAL(itemChanged(QTableWidgetItem*)), this, SLOT(markUpdateOnRow(QTableWidgetItem *)));
 	connect(delete_tb, SIGNAL(clicked()), this, SLOT(markDeleteOnRows()));
 	connect(add_tb, SIGNAL(clicked()), this, SLOT(addRow()));
 	connect(duplicate_tb, SIGNAL(clicked()), this, SLOT(duplicateRows()));
@@ -91,10 +93,7 @@ DataManipulationForm::DataManipulationForm(QWidget * parent, Qt::WindowFlags f):
 	connect(move_up_tb, SIGNAL(clicked()), this, SLOT(swapColumns()));
 	connect(filter_tb, SIGNAL(toggled(bool)), v_splitter, SLOT(setVisible(bool)));
 
-	//Using the QueuedConnection here to avoid the "edit: editing failed" when editing and navigating through items using tab key
-	connect(results_tbw, SIGNAL(currentCellChanged(int,int,int,int)), this, SLOT(insertRowOnTabPress(int,int,int,int)), Qt::QueuedConnection);
-
-	connect(results_tbw, &QTableWidget::itemPressed,
+	connect(results_tbw, &QTableView::pressed,
 			[=](){ SQLExecutionWidget::copySelection(results_tbw); });
 
 	connect(copy_tb, &QToolButton::clicked,
@@ -103,8 +102,12 @@ DataManipulationForm::DataManipulationForm(QWidget * parent, Qt::WindowFlags f):
 	connect(export_tb, &QToolButton::clicked,
 			[=](){ SQLExecutionWidget::exportResults(results_tbw); });
 
-	connect(results_tbw, SIGNAL(itemSelectionChanged()), this, SLOT(enableRowControlButtons()));
 	connect(csv_load_wgt, SIGNAL(s_csvFileLoaded()), this, SLOT(loadDataFromCsv()));
+	connect(csv_load_wgt, SIGNAL(s_csvBulkLoadRequested()), this, SLOT(bulkLoadFromCsv()));
+
+	connect(&data_exec, &QueryExecutor::s_batchReceived, this, &DataManipulationForm::handleDataBatch);
+	connect(&data_exec, &QueryExecutor::s_executionFinished, this, &DataManipulationForm::finishDataRetrieval);
+	connect(&data_exec, &QueryExecutor::s_executionFailed, this, &DataManipulationForm::handleDataRetrievalError);
 }
 
 void DataManipulationForm::setAttributes(Connection conn, const QString curr_schema, const QString curr_table)
@@ -139,6 +142,31 @@ void DataManipulationForm::setAttributes(Connection conn, const QString curr_sch
 	}
 }
 
+ResultSetModel *DataManipulationForm::getResultsModel(void)
+{
+	return(qobject_cast<ResultSetModel *>(results_tbw->model()));
+}
+
+void DataManipulationForm::configureResultsModel(void)
+{
+	ResultSetModel *model=getResultsModel();
+
+	if(!model)
+		return;
+
+	//For tables, even if there is no pk the user can manipulate data
+	model->setEditable(table_cmb->currentData(Qt::UserRole).toUInt()==OBJ_TABLE);
+
+	/* Each model has its own selection model so the signals need to be connected everytime the grid
+	receives a new model. The connections are destroyed along with the previous models */
+	connect(model, SIGNAL(s_cellValueChanged(int,int)), this, SLOT(markUpdateOnRow(int,int)));
+	connect(results_tbw->selectionModel(), SIGNAL(selectionChanged(QItemSelection,QItemSelection)), this, SLOT(enableRowControlButtons()));
+
+	//Using the QueuedConnection here to avoid the "edit: editing failed" when editing and navigating through items using tab key
+	connect(results_tbw->selectionModel(), SIGNAL(currentChanged(QModelIndex,QModelIndex)),
+					this, SLOT(insertRowOnTabPress(QModelIndex,QModelIndex)), Qt::QueuedConnection);
+}
+
 void DataManipulationForm::listTables(void)
 {
 	table_cmb->clear();
@@ -198,13 +226,10 @@ void DataManipulationForm::listColumns(void)
 
 void DataManipulationForm::retrieveData(void)
 {
-	if(table_cmb->currentIndex() <= 0)
+	if(table_cmb->currentIndex() <= 0 || data_exec.isRunning())
 		return;
 
 	Messagebox msg_box;
-	Catalog catalog;
-	Connection conn_sql=Connection(tmpl_conn_params),
-			conn_cat=Connection(tmpl_conn_params);
 
 	try
 	{
@@ -218,7 +243,6 @@ void DataManipulationForm::retrieveData(void)
 		}
 
 		QString query=QString("SELECT * FROM \"%1\".\"%2\"").arg(schema_cmb->currentText()).arg(table_cmb->currentText());
-		ResultSet res;
 		unsigned limit=limit_spb->value();
 
 		//Building the where clause
@@ -245,52 +269,130 @@ void DataManipulationForm::retrieveData(void)
 		if(limit > 0)
 			query+=QString(" LIMIT %1").arg(limit);
 
-		catalog.setConnection(conn_cat);
-		conn_sql.connect();
-		conn_sql.executeDMLCommand(query, res);
-
 		retrievePKColumns(schema_cmb->currentText(), table_cmb->currentText());
-		SQLExecutionWidget::fillResultsTable(catalog, res, results_tbw, true);
 
-		export_tb->setEnabled(results_tbw->rowCount() > 0);
-		result_info_wgt->setVisible(results_tbw->rowCount() > 0);
-		result_info_lbl->setText(QString("<em>[%1]</em> ").arg(QTime::currentTime().toString(QString("hh:mm:ss.zzz"))) +
-								 trUtf8("Rows returned: <strong>%1</strong>&nbsp;&nbsp;&nbsp;").arg(results_tbw->rowCount()) +
-								 trUtf8("<em>(Limit: <strong>%1</strong>)</em>").arg(limit_spb->value()==0 ? trUtf8("none") : QString::number(limit_spb->value())));
+		data_conn.close();
+		data_conn.setConnectionParams(tmpl_conn_params);
+		data_conn.connect();
 
-		//Reset the changed rows state
-		clearChangedRows();
+		/* The rows are added to the grid as they are received from the server (see handleDataBatch())
+		so the form can be used (or the retrieval cancelled) while the others are retrieved */
+		enableRetrievalControls(true);
+		data_exec.execute(data_conn, query);
+	}
+	catch(Exception &e)
+	{
+		enableRetrievalControls(false);
+		data_conn.close();
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
 
-		//If the table is empty automatically creates a new row
-		if(results_tbw->rowCount()==0 && table_cmb->currentData(Qt::UserRole).toUInt()==OBJ_TABLE)
-			addRow();
-		else
-			results_tbw->setFocus();
+void DataManipulationForm::handleDataBatch(ResultSet &res, bool first_batch)
+{
+	if(first_batch)
+	{
+		Catalog catalog;
+		Connection conn_cat=Connection(tmpl_conn_params);
 
-		if(table_cmb->currentData(Qt::UserRole).toUInt()==OBJ_TABLE)
-			csv_load_tb->setEnabled(true);
-		else
+		try
+		{
+			catalog.setConnection(conn_cat);
+			SQLExecutionWidget::fillResultsTable(catalog, res, results_tbw);
+			catalog.closeConnection();
+
+			configureResultsModel();
+
+			//The rows can only be changed after all of them are received otherwise the changed rows ids could be invalidated
+			getResultsModel()->setEditable(false);
+			clearChangedRows();
+		}
+		catch(Exception &e)
 		{
-			csv_load_tb->setEnabled(false);
-			csv_load_tb->setChecked(false);
+			catalog.closeConnection();
+			throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
 		}
+	}
+	else
+		getResultsModel()->appendResultSet(res);
+}
 
-		conn_sql.close();
-		catalog.closeConnection();
+void DataManipulationForm::finishDataRetrieval(unsigned, bool completed)
+{
+	ResultSetModel *model=getResultsModel();
+	bool is_table=(table_cmb->currentData(Qt::UserRole).toUInt()==OBJ_TABLE);
+	int row_count=(model ? model->rowCount() : 0);
+
+	enableRetrievalControls(false);
+	data_conn.close();
+
+	if(model)
+		model->setEditable(is_table);
+
+	export_tb->setEnabled(row_count > 0);
+	add_tb->setEnabled(model && is_table);
+	result_info_wgt->setVisible(row_count > 0 || !completed);
+	result_info_lbl->setText(QString("<em>[%1]</em> ").arg(QTime::currentTime().toString(QString("hh:mm:ss.zzz"))) +
+							 trUtf8("Rows returned: <strong>%1</strong>&nbsp;&nbsp;&nbsp;").arg(row_count) +
+							 (completed ?
+								 trUtf8("<em>(Limit: <strong>%1</strong>)</em>").arg(limit_spb->value()==0 ? trUtf8("none") : QString::number(limit_spb->value())) :
+								 trUtf8("<em>(Retrieval cancelled by the user)</em>")));
+
+	//If the table is empty automatically creates a new row
+	if(model && row_count==0 && is_table)
+		addRow();
+	else
+		results_tbw->setFocus();
+
+	if(is_table)
+		csv_load_tb->setEnabled(model!=nullptr);
+	else
+	{
+		csv_load_tb->setEnabled(false);
+		csv_load_tb->setChecked(false);
 	}
-	catch(Exception &e)
+}
+
+void DataManipulationForm::handleDataRetrievalError(Exception e)
+{
+	Messagebox msg_box;
+
+	enableRetrievalControls(false);
+	data_conn.close();
+	msg_box.show(e);
+}
+
+void DataManipulationForm::cancelDataRetrieval(void)
+{
+	stop_tb->setEnabled(false);
+	data_exec.cancel();
+}
+
+void DataManipulationForm::enableRetrievalControls(bool running)
+{
+	refresh_tb->setEnabled(!running && schema_cmb->currentIndex() > 0 && table_cmb->currentIndex() > 0);
+	stop_tb->setEnabled(running);
+	schema_cmb->setEnabled(!running);
+	table_cmb->setEnabled(!running && table_cmb->count() > 0);
+	hide_views_chk->setEnabled(!running);
+	filter_tb->setEnabled(!running && ord_column_cmb->count() > 0);
+	save_tb->setEnabled(!running && !changed_rows.empty());
+
+	if(running)
 	{
-		conn_sql.close();
-		catalog.closeConnection();
-		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+		add_tb->setEnabled(false);
+		csv_load_tb->setEnabled(false);
+		csv_load_tb->setChecked(false);
+		results_tbw->setCursor(Qt::BusyCursor);
 	}
+	else
+		results_tbw->unsetCursor();
 }
 
 void DataManipulationForm::disableControlButtons(void)
 {
 	refresh_tb->setEnabled(schema_cmb->currentIndex() > 0 && table_cmb->currentIndex() > 0);
-	results_tbw->setRowCount(0);
-	results_tbw->setColumnCount(0);
+	SQLExecutionWidget::clearResultsTable(results_tbw);
 	warning_frm->setVisible(false);
 	hint_frm->setVisible(false);
 	add_tb->setEnabled(false);
@@ -303,15 +405,19 @@ void DataManipulationForm::disableControlButtons(void)
 
 void DataManipulationForm::enableRowControlButtons(void)
 {
-	QList<QTableWidgetSelectionRange> sel_ranges=results_tbw->selectedRanges();
+	ResultSetModel *model=getResultsModel();
+	QItemSelection sel_ranges;
 	bool cols_selected, rows_selected;
 
+	if(model)
+		sel_ranges=results_tbw->selectionModel()->selection();
+
 	cols_selected = rows_selected = !sel_ranges.isEmpty();
 
 	for(auto &sel_rng : sel_ranges)
 	{
-		cols_selected &= (sel_rng.columnCount() == results_tbw->columnCount());
-		rows_selected &= (sel_rng.rowCount() == results_tbw->rowCount());
+		cols_selected &= (sel_rng.width() == model->columnCount());
+		rows_selected &= (sel_rng.height() == model->rowCount());
 	}
 
 	delete_tb->setEnabled(cols_selected);
@@ -380,33 +486,23 @@ void DataManipulationForm::swapColumns(void)
 
 void DataManipulationForm::loadDataFromCsv(void)
 {
+	ResultSetModel *model=getResultsModel();
 	QList<QStringList> rows=csv_load_wgt->getCsvRows();
 	QStringList cols=csv_load_wgt->getCsvColumns();
 	int row_id = 0, col_id = 0;
 
+	if(!model)
+		return;
+
 	/* If there is only one empty row in the grid, this one will
 	be removed prior the csv loading */
-	if(results_tbw->rowCount()==1)
-	{
-		bool is_empty=true;
-
-		for(int col=0; col < results_tbw->columnCount(); col++)
-		{
-			if(!results_tbw->item(0, col)->text().isEmpty())
-			{
-				is_empty=false;
-				break;
-			}
-		}
-
-		if(is_empty)
-			removeNewRows({0});
-	}
+	if(model->rowCount()==1 && isEmptyNewRow(0))
+		removeNewRows({0});
 
 	for(QStringList &values : rows)
 	{
 		addRow();
-		row_id=results_tbw->rowCount() - 1;
+		row_id=model->rowCount() - 1;
 
 		for(int i = 0; i < values.count(); i++)
 		{
@@ -415,18 +511,145 @@ void DataManipulationForm::loadDataFromCsv(void)
 				//First we need to get the index of the column by its name
 				col_id=col_names.indexOf(cols[i]);
 
-				if(col_id >= 0 && col_id < results_tbw->columnCount())
-					results_tbw->item(row_id, col_id)->setText(values.at(i));
+				if(col_id >= 0 && col_id < model->columnCount())
+					model->setData(model->index(row_id, col_id), values.at(i));
 			}
-			else if(i < results_tbw->columnCount())
+			else if(i < model->columnCount())
 			{
 				//Insert the value to the cell in order of appearance
-				results_tbw->item(row_id, i)->setText(values.at(i));
+				model->setData(model->index(row_id, i), values.at(i));
 			}
 		}
 	}
 }
 
+bool DataManipulationForm::isEmptyNewRow(int row)
+{
+	ResultSetModel *model=getResultsModel();
+
+	if(!model || !model->isNewRow(row))
+		return(false);
+
+	for(int col=0; col < model->columnCount(); col++)
+	{
+		if(!model->isBinaryColumn(col) && !model->index(row, col).data().toString().isEmpty())
+			return(false);
+	}
+
+	return(true);
+}
+
+void DataManipulationForm::bulkLoadFromCsv(void)
+{
+	Messagebox msg_box;
+	Connection conn=Connection(tmpl_conn_params);
+	QFile input;
+	QString separator=csv_load_wgt->getSeparator(),
+			txt_delim=csv_load_wgt->getTextDelimiter(),
+			tab_name=QString("\"%1\".\"%2\"").arg(schema_cmb->currentText()).arg(table_cmb->currentText()),
+			copy_cmd;
+	QStringList cols;
+	int first_line=1;
+	unsigned row_count=0;
+
+	if(table_cmb->currentIndex() <= 0)
+		return;
+
+	//The COPY command only accepts single characters as separator and text delimiter
+	if(separator.size()!=1 || txt_delim.size() > 1)
+	{
+		msg_box.show(trUtf8("The bulk load requires both separator and text delimiter to be a single character!"),
+								 Messagebox::ALERT_ICON);
+		return;
+	}
+
+	//The only pending change allowed is the empty row automatically created for empty tables
+	if(changed_rows.size() > 1 || (changed_rows.size()==1 && !isEmptyNewRow(changed_rows[0])))
+	{
+		msg_box.show(trUtf8("<strong>WARNING: </strong> There are some changed rows waiting the commit! The data will be retrieved again after the bulk load causing them to be discarded. Do you want to proceed?"),
+					 Messagebox::ALERT_ICON, Messagebox::YES_NO_BUTTONS);
+
+		if(msg_box.result()==QDialog::Rejected)
+			return;
+	}
+
+	input.setFileName(csv_load_wgt->getCsvFile());
+
+	if(!input.open(QFile::ReadOnly))
+		throw Exception(Exception::getErrorMessage(ERR_FILE_DIR_NOT_ACCESSED).arg(input.fileName()),
+										ERR_FILE_DIR_NOT_ACCESSED,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	try
+	{
+		/* The column names in the first row are consumed here so they can be used as the column list of the COPY,
+		this way the values are stored in the columns with the same name just like in the ordinary csv loading */
+		if(csv_load_wgt->isColumnsInFirstRow())
+		{
+			QString col_name;
+
+			for(QString col : QString(input.readLine()).split(separator))
+			{
+				col_name=col.remove(txt_delim).trimmed();
+
+				if(!col_name.isEmpty())
+					cols.push_back(QString("\"%1\"").arg(col_name));
+			}
+
+			first_line++;
+		}
+
+		if(txt_delim.isEmpty())
+			txt_delim=QString("\"");
+
+		copy_cmd=QString("COPY %1%2 FROM STDIN WITH (FORMAT csv, DELIMITER '%3', QUOTE '%4')")
+				.arg(tab_name)
+				.arg(cols.isEmpty() ? QString() : QString("(%1)").arg(cols.join(QString(", "))))
+				.arg(separator.replace(QString("'"), QString("''")))
+				.arg(txt_delim.replace(QString("'"), QString("''")));
+
+		qApp->setOverrideCursor(Qt::WaitCursor);
+		csv_load_wgt->updateBulkLoadProgress(input.pos(), input.size());
+
+		conn.connect();
+		row_count=conn.copyFromDevice(copy_cmd, input, [&](qint64){
+			csv_load_wgt->updateBulkLoadProgress(input.pos(), input.size());
+			return(true);
+		});
+		conn.close();
+
+		input.close();
+		csv_load_wgt->updateBulkLoadProgress(-1, -1);
+		qApp->restoreOverrideCursor();
+	}
+	catch(Exception &e)
+	{
+		QRegExp line_regexp(QString("COPY .+, line (\\d+)"));
+
+		line_regexp.setMinimal(true);
+		conn.close();
+		input.close();
+		csv_load_wgt->updateBulkLoadProgress(-1, -1);
+		qApp->restoreOverrideCursor();
+
+		//Translating the line reported by the server (which ignores the consumed header) into the line of the file
+		if(e.getErrorType()==ERR_CMD_SQL_NOT_EXECUTED && line_regexp.indexIn(e.getErrorMessage()) >= 0)
+		{
+			throw Exception(Exception::getErrorMessage(ERR_CSV_LINE_NOT_LOADED)
+							.arg(input.fileName()).arg(tab_name)
+							.arg(line_regexp.cap(1).toInt() + first_line - 1).arg(e.getErrorMessage()),
+							ERR_CSV_LINE_NOT_LOADED,__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+		}
+
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+
+	msg_box.show(trUtf8("<strong>%1</strong> row(s) were loaded into the table <strong>%2</strong>.").arg(row_count).arg(tab_name),
+				 Messagebox::INFO_ICON);
+
+	clearChangedRows();
+	retrieveData();
+}
+
 void DataManipulationForm::removeColumnFromList(void)
 {
 	if(qApp->mouseButtons()==Qt::NoButton || qApp->mouseButtons()==Qt::LeftButton)
@@ -585,12 +808,12 @@ void DataManipulationForm::retrievePKColumns(const QString &schema, const QStrin
 
 void DataManipulationForm::markOperationOnRow(unsigned operation, int row)
 {
-	if(row < results_tbw->rowCount() &&
-			(operation==NO_OPERATION || results_tbw->verticalHeaderItem(row)->data(Qt::UserRole)!=OP_INSERT))
+	ResultSetModel *model=getResultsModel();
+
+	if(model && row < model->rowCount() &&
+			(operation==NO_OPERATION || model->getRowOperation(row)!=OP_INSERT))
 	{
-		QTableWidgetItem *item=nullptr, *header_item=results_tbw->verticalHeaderItem(row);
 		QString tooltip=trUtf8("This row is marked to be %1");
-		QFont fnt=results_tbw->font();
 		int marked_cols=0;
 
 		if(operation==OP_DELETE)
@@ -602,101 +825,56 @@ void DataManipulationForm::markOperationOnRow(unsigned operation, int row)
 		else
 			tooltip.clear();
 
-		results_tbw->blockSignals(true);
-
-		for(int col=0; col < results_tbw->columnCount(); col++)
+		for(int col=0; col < model->columnCount(); col++)
 		{
-			item=results_tbw->item(row, col);
-
-			if(results_tbw->horizontalHeaderItem(col)->data(Qt::UserRole)!=QString("bytea"))
-			{
-				item->setToolTip(tooltip);
-
-				//Restore the item's font and text when the operation is delete or none
-				if(operation==NO_OPERATION || operation==OP_DELETE)
-				{
-					item->setFont(fnt);
-					item->setText(item->data(Qt::UserRole).toString());
-				}
-
-				if(operation==NO_OPERATION)
-					//Restore the item's background
-					item->setBackground(prev_row_colors[row]);
-				else
-				{
-					//Saves the item's background if it isn't already marked
-					if(header_item->data(Qt::UserRole)!=OP_DELETE &&
-							header_item->data(Qt::UserRole)!=OP_UPDATE)
-						prev_row_colors[row]=item->background();
-
-					//Changes the item's background according to the operation
-					item->setBackground(ROW_COLORS[operation - 1]);
-				}
-
+			if(model->headerData(col, Qt::Horizontal, Qt::UserRole)!=QString("bytea"))
 				marked_cols++;
-			}
 		}
 
 		if(marked_cols > 0)
 		{
 			auto itr=std::find(changed_rows.begin(), changed_rows.end(), row);
 
+			//Restore the row's original values when the operation is delete or none
+			if(operation==NO_OPERATION || operation==OP_DELETE)
+				model->restoreRow(row);
+
+			model->setRowOperation(row, operation, (operation==NO_OPERATION ? QColor() : ROW_COLORS[operation - 1]), tooltip);
+
 			if(operation==NO_OPERATION && itr!=changed_rows.end())
-			{
-				changed_rows.erase(std::find(changed_rows.begin(), changed_rows.end(), row));
-				prev_row_colors.erase(row);
-			}
+				changed_rows.erase(itr);
 			else if(operation!=NO_OPERATION && itr==changed_rows.end())
 				changed_rows.push_back(row);
 
-			header_item->setData(Qt::UserRole, operation);
 			undo_tb->setEnabled(!changed_rows.empty());
 			save_tb->setEnabled(!changed_rows.empty());
 			std::sort(changed_rows.begin(), changed_rows.end());
 		}
-
-		results_tbw->blockSignals(false);
 	}
 }
 
-void DataManipulationForm::markUpdateOnRow(QTableWidgetItem *item)
+void DataManipulationForm::markUpdateOnRow(int row, int)
 {
-	if(results_tbw->verticalHeaderItem(item->row())->data(Qt::UserRole)!=OP_INSERT)
-	{
-		bool items_changed=false;
-		QTableWidgetItem *aux_item=nullptr;
-		QFont fnt=item->font();
+	ResultSetModel *model=getResultsModel();
 
-		//Before mark the row to update it's needed to check if some item was changed
-		for(int col=0; col < results_tbw->columnCount(); col++)
-		{
-			aux_item=results_tbw->item(item->row(), col);
-			if(!items_changed && aux_item->text()!=aux_item->data(Qt::UserRole))
-			{
-				items_changed=true;
-				break;
-			}
-		}
-
-		fnt.setBold(items_changed);
-		item->setFont(fnt);
-		markOperationOnRow((items_changed ? OP_UPDATE : NO_OPERATION), item->row());
-	}
+	//The model keeps only the values that differ from the original ones so the row is changed if it has any of them
+	if(model && model->getRowOperation(row)!=OP_INSERT)
+		markOperationOnRow((model->isRowChanged(row) ? OP_UPDATE : NO_OPERATION), row);
 }
 
 void DataManipulationForm::markDeleteOnRows(void)
 {
-	QList<QTableWidgetSelectionRange> sel_ranges=results_tbw->selectedRanges();
-	QTableWidgetItem *item=nullptr;
+	ResultSetModel *model=getResultsModel();
 	vector<int> ins_rows;
 
-	for(auto &sel_rng : sel_ranges)
+	if(!model)
+		return;
+
+	for(auto &sel_rng : results_tbw->selectionModel()->selection())
 	{
-		for(int row=sel_rng.topRow(); row <= sel_rng.bottomRow(); row++)
+		for(int row=sel_rng.top(); row <= sel_rng.bottom(); row++)
 		{
-			item=results_tbw->verticalHeaderItem(row);
-
-			if(item->data(Qt::UserRole)==OP_INSERT)
+			if(model->getRowOperation(row)==OP_INSERT)
 				ins_rows.push_back(row);
 			else
 				markOperationOnRow(OP_DELETE, row);
@@ -709,58 +887,45 @@ void DataManipulationForm::markDeleteOnRows(void)
 
 void DataManipulationForm::addRow(void)
 {
-	int row=results_tbw->rowCount();
-	QTableWidgetItem *item=nullptr;
-
-	results_tbw->blockSignals(true);
-	results_tbw->insertRow(row);
-
-	for(int col=0; col < results_tbw->columnCount(); col++)
-	{
-		item=new QTableWidgetItem;
-
-		//bytea (binary data) columns can't be handled this way the new item is disabled
-		if(results_tbw->horizontalHeaderItem(col)->data(Qt::UserRole)==QString("bytea"))
-		{
-			item->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
-			item->setText(trUtf8("[binary data]"));
-		}
-		else
-			item->setFlags(Qt::ItemIsEditable | Qt::ItemIsSelectable | Qt::ItemIsEnabled);
+	ResultSetModel *model=getResultsModel();
+	QModelIndex index;
+	int row=0;
 
-		results_tbw->setItem(row, col, item);
-	}
+	if(!model)
+		return;
 
-	results_tbw->setVerticalHeaderItem(row, new QTableWidgetItem(QString::number(row + 1)));
-	results_tbw->blockSignals(false);
+	row=model->rowCount();
+	model->insertRows(row, 1);
 	results_tbw->setFocus();
 
 	markOperationOnRow(OP_INSERT, row);
 
 	results_tbw->clearSelection();
-	item=results_tbw->item(row, 0);
-	results_tbw->setCurrentCell(row, 0, QItemSelectionModel::ClearAndSelect);
-	results_tbw->editItem(item);
+	index=model->index(row, 0);
+	results_tbw->selectionModel()->setCurrentIndex(index, QItemSelectionModel::ClearAndSelect);
+	results_tbw->edit(index);
 	hint_frm->setVisible(true);
 }
 
 void DataManipulationForm::duplicateRows(void)
 {
-	QList<QTableWidgetSelectionRange> sel_ranges=results_tbw->selectedRanges();
+	ResultSetModel *model=getResultsModel();
+
+	if(!model)
+		return;
 
-	if(!sel_ranges.isEmpty())
+	QItemSelection sel_ranges=results_tbw->selectionModel()->selection();
+
+	for(auto &sel_rng : sel_ranges)
 	{
-		for(auto &sel_rng : sel_ranges)
+		for(int row=sel_rng.top(); row <= sel_rng.bottom(); row++)
 		{
-			for(int row=sel_rng.topRow(); row <= sel_rng.bottomRow(); row++)
-			{
-				addRow();
+			addRow();
 
-				for(int col=0; col < results_tbw->columnCount(); col++)
-				{
-					results_tbw->item(results_tbw->rowCount() - 1, col)
-							->setText(results_tbw->item(row, col)->text());
-				}
+			for(int col=0; col < model->columnCount(); col++)
+			{
+				model->setData(model->index(model->rowCount() - 1, col),
+											 model->index(row, col).data());
 			}
 		}
 	}
@@ -768,91 +933,77 @@ void DataManipulationForm::duplicateRows(void)
 
 void DataManipulationForm::removeNewRows(const vector<int> &ins_rows)
 {
-	if(!ins_rows.empty())
+	ResultSetModel *model=getResultsModel();
+
+	if(model && !ins_rows.empty())
 	{
-		unsigned idx=0, cnt=ins_rows.size();
-		int row_idx=0;
-		vector<int>::reverse_iterator itr, itr_end;
+		vector<int> rows=ins_rows;
+
+		//Removing the rows from the last to the first one so the remaining indexes keep valid
+		std::sort(rows.begin(), rows.end(), std::greater<int>());
+		rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
 
 		//Mark the rows as no-op to remove their indexes from changed rows set
-		for(idx=0; idx < cnt; idx++)
-			markOperationOnRow(NO_OPERATION, ins_rows[idx]);
+		for(auto &row : rows)
+			markOperationOnRow(NO_OPERATION, row);
 
-		//Remove the rows
-		for(idx=0; idx < cnt; idx++)
-			results_tbw->removeRow(ins_rows[0]);
+		for(auto &row : rows)
+			model->removeRows(row, 1);
 
 		//Reorganizing the changed rows vector to avoid row index out-of-bound errors
-		row_idx=results_tbw->rowCount() - 1;
-		itr=changed_rows.rbegin();
-		itr_end=changed_rows.rend();
-
-		while(itr!=itr_end)
-		{
-			if((*itr) > row_idx)
-			{
-				(*itr)=row_idx;
-				results_tbw->verticalHeaderItem(row_idx)->setText(QString::number(row_idx + 1));
-				row_idx--;
-			}
-			else break;
-
-			itr++;
-		}
+		for(auto &chg_row : changed_rows)
+			chg_row-=std::count_if(rows.begin(), rows.end(), [&chg_row](int rem_row){ return(rem_row < chg_row); });
 	}
 }
 
 void DataManipulationForm::clearChangedRows(void)
 {
 	changed_rows.clear();
-	prev_row_colors.clear();
 	undo_tb->setEnabled(false);
 	save_tb->setEnabled(false);
 }
 
 void DataManipulationForm::undoOperations(void)
 {
-	QTableWidgetItem *item=nullptr;
+	ResultSetModel *model=getResultsModel();
 	vector<int> rows, ins_rows;
-	QList<QTableWidgetSelectionRange> sel_range=results_tbw->selectedRanges();
+	QItemSelection sel_range;
+
+	if(!model)
+		return;
+
+	sel_range=results_tbw->selectionModel()->selection();
 
 	if(!sel_range.isEmpty())
 	{
-		for(int row=sel_range[0].topRow(); row <= sel_range[0].bottomRow(); row++)
+		for(int row=sel_range[0].top(); row <= sel_range[0].bottom(); row++)
 		{
-			if(results_tbw->verticalHeaderItem(row)->data(Qt::UserRole).toUInt()==OP_INSERT)
+			if(model->getRowOperation(row)==OP_INSERT)
 				ins_rows.push_back(row);
 			else
 				rows.push_back(row);
 		}
 	}
 	else
-	{
-		sel_range.clear();
 		rows=changed_rows;
-	}
 
 	//Marking rows to be deleted/updated as no-op
 	for(auto &row : rows)
 	{
-		item=results_tbw->verticalHeaderItem(row);
-		if(item->data(Qt::UserRole).toUInt()!=OP_INSERT)
+		if(model->getRowOperation(row)!=OP_INSERT)
 			markOperationOnRow(NO_OPERATION, row);
 	}
 
 	//If there is no selection, remove all new rows
 	if(sel_range.isEmpty())
 	{
-		if(results_tbw->rowCount() > 0 &&
-				results_tbw->verticalHeaderItem(results_tbw->rowCount()-1)->data(Qt::UserRole)==OP_INSERT)
-		{
-			do
-			{
-				results_tbw->removeRow(results_tbw->rowCount()-1);
-				item=results_tbw->verticalHeaderItem(results_tbw->rowCount()-1);
-			}
-			while(item && item->data(Qt::UserRole)==OP_INSERT);
-		}
+		int first_new=model->rowCount();
+
+		while(first_new > 0 && model->isNewRow(first_new - 1))
+			first_new--;
+
+		if(first_new < model->rowCount())
+			model->removeRows(first_new, model->rowCount() - first_new);
 
 		clearChangedRows();
 	}
@@ -860,16 +1011,17 @@ void DataManipulationForm::undoOperations(void)
 		//Removing just the selected new rows
 		removeNewRows(ins_rows);
 
-
 	results_tbw->clearSelection();
-	hint_frm->setVisible(results_tbw->rowCount() > 0);
+	hint_frm->setVisible(model->rowCount() > 0);
 }
 
-void DataManipulationForm::insertRowOnTabPress(int curr_row, int curr_col, int prev_row, int prev_col)
+void DataManipulationForm::insertRowOnTabPress(const QModelIndex &curr_index, const QModelIndex &prev_index)
 {
-	if(qApp->mouseButtons()==Qt::NoButton &&
-			curr_row==0 && curr_col==0 &&
-			prev_row==results_tbw->rowCount()-1 && prev_col==results_tbw->columnCount()-1)
+	ResultSetModel *model=getResultsModel();
+
+	if(model && qApp->mouseButtons()==Qt::NoButton &&
+			curr_index.row()==0 && curr_index.column()==0 &&
+			prev_index.row()==model->rowCount()-1 && prev_index.column()==model->columnCount()-1)
 		addRow();
 }
 
@@ -891,7 +1043,7 @@ void DataManipulationForm::saveChanges(void)
 		{
 
 			//Forcing the cell editor to be closed by selecting an unexistent cell and clearing the selection
-			results_tbw->setCurrentCell(-1,-1, QItemSelectionModel::Clear);
+			results_tbw->selectionModel()->setCurrentIndex(QModelIndex(), QItemSelectionModel::Clear);
 
 			conn.connect();
 			conn.executeDDLCommand(QString("START TRANSACTION"));
@@ -922,7 +1074,7 @@ void DataManipulationForm::saveChanges(void)
 						 .arg(schema_cmb->currentText())
 						 .arg(table_cmb->currentText());
 
-		unsigned op_type=results_tbw->verticalHeaderItem(row)->data(Qt::UserRole).toUInt();
+		unsigned op_type=getResultsModel()->getRowOperation(row);
 
 		if(conn.isStablished())
 		{
@@ -931,7 +1083,7 @@ void DataManipulationForm::saveChanges(void)
 		}
 
 		results_tbw->selectRow(row);
-		results_tbw->scrollToItem(results_tbw->item(row, 0));
+		results_tbw->scrollTo(getResultsModel()->index(row, 0));
 
 		throw Exception(Exception::getErrorMessage(ERR_ROW_DATA_NOT_MANIPULATED)
 						.arg(op_names[op_type]).arg(tab_name).arg(row + 1).arg(e.getErrorMessage()),
@@ -941,7 +1093,9 @@ void DataManipulationForm::saveChanges(void)
 
 QString DataManipulationForm::getDMLCommand(int row)
 {
-	if(row < 0 || row >= results_tbw->rowCount())
+	ResultSetModel *model=getResultsModel();
+
+	if(!model || row < 0 || row >= model->rowCount())
 		return(QString());
 
 	QString tab_name=QString("\"%1\".\"%2\"").arg(schema_cmb->currentText()).arg(table_cmb->currentText()),
@@ -949,8 +1103,8 @@ QString DataManipulationForm::getDMLCommand(int row)
 			del_cmd=QString("DELETE FROM %1 WHERE %2"),
 			ins_cmd=QString("INSERT INTO %1(%2) VALUES (%3)"),
 			fmt_cmd;
-	QTableWidgetItem *item=nullptr;
-	unsigned op_type=results_tbw->verticalHeaderItem(row)->data(Qt::UserRole).toUInt();
+	QModelIndex index;
+	unsigned op_type=model->getRowOperation(row);
 	QStringList val_list, col_list, flt_list;
 	QString col_name, value;
 
@@ -959,10 +1113,10 @@ QString DataManipulationForm::getDMLCommand(int row)
 		if(pk_col_names.isEmpty())
 		{
 			//Considering all columns as pk when the tables doesn't has one (except bytea columns)
-			for(int col=0; col < results_tbw->columnCount(); col++)
+			for(int col=0; col < model->columnCount(); col++)
 			{
-				if(results_tbw->horizontalHeaderItem(col)->data(Qt::UserRole)!=QString("bytea"))
-					pk_col_names.push_back(results_tbw->horizontalHeaderItem(col)->text());
+				if(model->headerData(col, Qt::Horizontal, Qt::UserRole)!=QString("bytea"))
+					pk_col_names.push_back(model->headerData(col, Qt::Horizontal).toString());
 			}
 		}
 
@@ -970,7 +1124,7 @@ QString DataManipulationForm::getDMLCommand(int row)
 		for(QString pk_col : pk_col_names)
 		{
 			flt_list.push_back(QString("\"%1\"='%2'").arg(pk_col)
-								 .arg(results_tbw->item(row,  col_names.indexOf(pk_col))->data(Qt::UserRole).toString().replace("\'","''")));
+								 .arg(model->index(row, col_names.indexOf(pk_col)).data(Qt::UserRole).toString().replace("\'","''")));
 		}
 	}
 
@@ -982,17 +1136,17 @@ QString DataManipulationForm::getDMLCommand(int row)
 	{
 		fmt_cmd=(op_type==OP_UPDATE ? upd_cmd : ins_cmd);
 
-		for(int col=0; col < results_tbw->columnCount(); col++)
+		for(int col=0; col < model->columnCount(); col++)
 		{
-			item=results_tbw->item(row, col);
+			index=model->index(row, col);
 
 			//bytea columns are ignored
-			if(results_tbw->horizontalHeaderItem(col)->data(Qt::UserRole)!=QString("bytea"))
+			if(model->headerData(col, Qt::Horizontal, Qt::UserRole)!=QString("bytea"))
 			{
-				value=item->text();
-				col_name=results_tbw->horizontalHeaderItem(col)->text();
+				value=index.data().toString();
+				col_name=model->headerData(col, Qt::Horizontal).toString();
 
-				if(op_type==OP_INSERT || (op_type==OP_UPDATE && value!=item->data(Qt::UserRole)))
+				if(op_type==OP_INSERT || (op_type==OP_UPDATE && value!=index.data(Qt::UserRole)))
 				{
 					//Checking if the value is a malformed unescaped value, e.g., {value, value}, {value\}
 					if((value.startsWith(Table::UNESC_VALUE_START) && value.endsWith(QString("\\") + Table::UNESC_VALUE_END)) ||
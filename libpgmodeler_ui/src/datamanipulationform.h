@@ -30,6 +30,8 @@
 #include "syntaxhighlighter.h"
 #include "codecompletionwidget.h"
 #include "csvloadwidget.h"
+#include "resultsetmodel.h"
+#include "queryexecutor.h"
 
 class DataManipulationForm: public QDialog, public Ui::DataManipulationForm {
 	private:
@@ -58,9 +60,13 @@ class DataManipulationForm: public QDialog, public Ui::DataManipulationForm {
 		
 		//! \brief Stores the ids of changed rows. These ids are handled on saveChanges() method
 		vector<int> changed_rows;
-		
-		//! \brief Stores the previous color of the rows before being marked with some operation
-		map<int, QBrush> prev_row_colors;
+
+		//! \brief Connection used to retrieve the table's data
+		Connection data_conn;
+
+		/*! \brief Retrieves the table's data without blocking the form. The rows are added to the grid as they are received.
+		This attribute must be declared after the connection since the executor uses it while being destroyed */
+		QueryExecutor data_exec;
 		
 		//! \brief Fills a combobox with the names of objects retrieved from catalog
 		void listObjects(QComboBox *combo, vector<ObjectType> obj_types, const QString &schema=QString());
@@ -81,6 +87,18 @@ class DataManipulationForm: public QDialog, public Ui::DataManipulationForm {
 		//! \brief Reset the state of changed rows, clearing all attributes used to control the modifications on them
 		void clearChangedRows(void);
 
+		//! \brief Returns if the specified row is a new one without any value filled by the user
+		bool isEmptyNewRow(int row);
+
+		//! \brief Returns the model of the results grid (nullptr if no data was retrieved)
+		ResultSetModel *getResultsModel(void);
+
+		//! \brief Configures the model created for the results grid connecting its signals to the form's slots
+		void configureResultsModel(void);
+
+		//! \brief Enables/disables the controls that can't be used while the data is being retrieved
+		void enableRetrievalControls(bool running);
+
 	public:
 		DataManipulationForm(QWidget * parent = 0, Qt::WindowFlags f = 0);
 		
@@ -94,8 +112,21 @@ class DataManipulationForm: public QDialog, public Ui::DataManipulationForm {
 		//! \brief List the columns based upon the current table
 		void listColumns(void);
 		
-		//! \brief Retrieve the data for the current table filtering the data as configured on the advanced tab
+		/*! \brief Retrieve the data for the current table filtering the data as configured on the advanced tab.
+		The command runs asynchronously (see handleDataBatch() and finishDataRetrieval()) */
 		void retrieveData(void);
+
+		//! \brief Fills the grid with the first batch of rows received and appends the next ones
+		void handleDataBatch(ResultSet &res, bool first_batch);
+
+		//! \brief Updates the form's controls when the data retrieval finishes or is cancelled by the user
+		void finishDataRetrieval(unsigned, bool completed);
+
+		//! \brief Restores the form's controls and shows the error raised while retrieving the data
+		void handleDataRetrievalError(Exception e);
+
+		//! \brief Cancels the data retrieval keeping the rows already received
+		void cancelDataRetrieval(void);
 		
 		//! \brief Disable the buttons used to handle data
 		void disableControlButtons(void);
@@ -121,8 +152,8 @@ class DataManipulationForm: public QDialog, public Ui::DataManipulationForm {
 		//! \brief Toggles the sort mode between ASC and DESC when right clicking on a element at order by list
 		void changeOrderMode(QListWidgetItem *item);
 		
-		//! \brief Mark the entire row in which the item resides
-		void markUpdateOnRow(QTableWidgetItem *item);
+		//! \brief Mark the entire row in which the changed cell resides
+		void markUpdateOnRow(int row, int);
 		
 		//! \brief Mark a seleciton of rows to be delete. New rows are automatically removed
 		void markDeleteOnRows(void);
@@ -137,7 +168,7 @@ class DataManipulationForm: public QDialog, public Ui::DataManipulationForm {
 		void undoOperations(void);
 		
 		//! \brief Insert a new row as the user press tab key on the last column at last row
-		void insertRowOnTabPress(int curr_row, int curr_col, int prev_row, int prev_col);
+		void insertRowOnTabPress(const QModelIndex &curr_index, const QModelIndex &prev_index);
 		
 		//! \brief Commit all changes made on the rows rolling back changes when some error is triggered
 		void saveChanges(void);
@@ -147,6 +178,10 @@ class DataManipulationForm: public QDialog, public Ui::DataManipulationForm {
 
 		//! \brief Add new rows to the grid based upon the CSV loaded
 		void loadDataFromCsv(void);
+
+		/*! \brief Sends the CSV file selected in the csv load widget straight to the current table through COPY ... FROM STDIN
+		reading and transferring it in chunks. Once finished the data is retrieved again */
+		void bulkLoadFromCsv(void);
 };
 
 #endif
@@ -84,6 +84,8 @@ GeneralConfigWidget::GeneralConfigWidget(QWidget * parent) : BaseConfigWidget(pa
 	connect(tab_width_spb, SIGNAL(valueChanged(int)), this, SLOT(updateFontPreview()));
 	connect(tab_width_chk, SIGNAL(toggled(bool)), tab_width_spb, SLOT(setEnabled(bool)));
 	connect(tab_width_chk, SIGNAL(toggled(bool)), this, SLOT(updateFontPreview()));
+	connect(use_lod_chk, SIGNAL(toggled(bool)), lod_box_zoom_spb, SLOT(setEnabled(bool)));
+	connect(use_lod_chk, SIGNAL(toggled(bool)), lod_rect_zoom_spb, SLOT(setEnabled(bool)));
 
 	connect(font_preview_txt, SIGNAL(cursorPositionChanged()), this, SLOT(updateFontPreview()));
 
@@ -120,6 +122,13 @@ GeneralConfigWidget::GeneralConfigWidget(QWidget * parent) : BaseConfigWidget(pa
 	config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::LINE_HIGHLIGHT_COLOR]=QString();
 	config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::HIGHLIGHT_LINES]=QString();
 	config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::USE_PLACEHOLDERS]=QString();
+	config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::USE_LEVEL_OF_DETAIL]=QString();
+	config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::LOD_BOX_ZOOM]=QString();
+	config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::LOD_RECT_ZOOM]=QString();
+	config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::USE_ITEM_CACHE]=QString();
+	config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::SHOW_FRAME_TIME]=QString();
+	config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::LAZY_ITEM_TREES]=QString();
+	config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::STREAM_MODEL_LOADING]=QString();
 
 	simp_obj_creation_ht=new HintTextWidget(simp_obj_creation_hint, this);
 	simp_obj_creation_ht->setText(simple_obj_creation_chk->statusTip());
@@ -154,6 +163,21 @@ GeneralConfigWidget::GeneralConfigWidget(QWidget * parent) : BaseConfigWidget(pa
 	use_placeholders_ht=new HintTextWidget(use_placeholders_hint, this);
 	use_placeholders_ht->setText(use_placeholders_chk->statusTip());
 
+	use_lod_ht=new HintTextWidget(use_lod_hint, this);
+	use_lod_ht->setText(use_lod_chk->statusTip());
+
+	use_item_cache_ht=new HintTextWidget(use_item_cache_hint, this);
+	use_item_cache_ht->setText(use_item_cache_chk->statusTip());
+
+	show_frame_time_ht=new HintTextWidget(show_frame_time_hint, this);
+	show_frame_time_ht->setText(show_frame_time_chk->statusTip());
+
+	lazy_item_trees_ht=new HintTextWidget(lazy_item_trees_hint, this);
+	lazy_item_trees_ht->setText(lazy_item_trees_chk->statusTip());
+
+	stream_loading_ht=new HintTextWidget(stream_loading_hint, this);
+	stream_loading_ht->setText(stream_loading_chk->statusTip());
+
 	selectPaperSize();
 
 	QList<QCheckBox *> chk_boxes=this->findChildren<QCheckBox *>();
@@ -236,6 +260,20 @@ void GeneralConfigWidget::loadConfiguration(void)
 		confirm_validation_chk->setChecked(config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::CONFIRM_VALIDATION]==ParsersAttributes::_TRUE_);
 		code_completion_chk->setChecked(config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::CODE_COMPLETION]==ParsersAttributes::_TRUE_);
 		use_placeholders_chk->setChecked(config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::USE_PLACEHOLDERS]==ParsersAttributes::_TRUE_);
+		use_lod_chk->setChecked(config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::USE_LEVEL_OF_DETAIL]!=ParsersAttributes::_FALSE_);
+		lod_box_zoom_spb->setEnabled(use_lod_chk->isChecked());
+		lod_rect_zoom_spb->setEnabled(use_lod_chk->isChecked());
+
+		if(!config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::LOD_BOX_ZOOM].isEmpty())
+			lod_box_zoom_spb->setValue(config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::LOD_BOX_ZOOM].toInt());
+
+		if(!config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::LOD_RECT_ZOOM].isEmpty())
+			lod_rect_zoom_spb->setValue(config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::LOD_RECT_ZOOM].toInt());
+
+		use_item_cache_chk->setChecked(config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::USE_ITEM_CACHE]!=ParsersAttributes::_FALSE_);
+		show_frame_time_chk->setChecked(config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::SHOW_FRAME_TIME]==ParsersAttributes::_TRUE_);
+		lazy_item_trees_chk->setChecked(config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::LAZY_ITEM_TREES]!=ParsersAttributes::_FALSE_);
+		stream_loading_chk->setChecked(config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::STREAM_MODEL_LOADING]!=ParsersAttributes::_FALSE_);
 
 		print_grid_chk->setChecked(config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::PRINT_GRID]==ParsersAttributes::_TRUE_);
 		print_pg_num_chk->setChecked(config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::PRINT_PG_NUM]==ParsersAttributes::_TRUE_);
@@ -356,6 +394,13 @@ void GeneralConfigWidget::saveConfiguration(void)
 		config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::CODE_COMPLETION]=(code_completion_chk->isChecked() ? ParsersAttributes::_TRUE_ : QString());
 		config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::CODE_TAB_WIDTH]=QString::number(tab_width_chk->isChecked() ? tab_width_spb->value() : 0);
 		config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::USE_PLACEHOLDERS]=(use_placeholders_chk->isChecked() ? ParsersAttributes::_TRUE_ : QString());
+		config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::USE_LEVEL_OF_DETAIL]=(use_lod_chk->isChecked() ? ParsersAttributes::_TRUE_ : QString());
+		config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::LOD_BOX_ZOOM]=QString::number(lod_box_zoom_spb->value());
+		config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::LOD_RECT_ZOOM]=QString::number(lod_rect_zoom_spb->value());
+		config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::USE_ITEM_CACHE]=(use_item_cache_chk->isChecked() ? ParsersAttributes::_TRUE_ : QString());
+		config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::SHOW_FRAME_TIME]=(show_frame_time_chk->isChecked() ? ParsersAttributes::_TRUE_ : QString());
+		config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::LAZY_ITEM_TREES]=(lazy_item_trees_chk->isChecked() ? ParsersAttributes::_TRUE_ : QString());
+		config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::STREAM_MODEL_LOADING]=(stream_loading_chk->isChecked() ? ParsersAttributes::_TRUE_ : QString());
 
 		ObjectsScene::getGridOptions(show_grid, align_grid, show_delim);
 		config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::SHOW_CANVAS_GRID]=(show_grid ? ParsersAttributes::_TRUE_ : QString());
@@ -466,6 +511,12 @@ void GeneralConfigWidget::applyConfiguration(void)
 	ModelWidget::setSimplifiedObjectCreation(simple_obj_creation_chk->isChecked());
 	MainWindow::setConfirmValidation(confirm_validation_chk->isChecked());	
 	BaseObjectView::setPlaceholderEnabled(use_placeholders_chk->isChecked());
+	BaseTableView::setLevelOfDetailEnabled(use_lod_chk->isChecked());
+	BaseObjectView::setItemCacheEnabled(use_item_cache_chk->isChecked());
+	ObjectsScene::setShowFrameTime(show_frame_time_chk->isChecked());
+	BaseTableView::setLazyItemTrees(lazy_item_trees_chk->isChecked());
+	ModelWidget::setStreamLoading(stream_loading_chk->isChecked());
+	BaseTableView::setLevelOfDetailZoom(lod_box_zoom_spb->value() / 100.0, lod_rect_zoom_spb->value() / 100.0);
 
 	fnt.setFamily(config_params[ParsersAttributes::CONFIGURATION][ParsersAttributes::CODE_FONT]);
 	fnt.setPointSize(fnt_size);
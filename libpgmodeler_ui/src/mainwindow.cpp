@@ -403,6 +403,9 @@ MainWindow::~MainWindow(void)
 	delete(restoration_form);
 	delete(overview_wgt);
 	delete(configuration_form);
+
+	//Closing the idle sessions kept by the connection pool
+	ConnectionPool::clear();
 }
 
 void MainWindow::showRightWidgetsBar(void)
@@ -702,7 +705,7 @@ void MainWindow::saveTemporaryModels(void)
 				bg_saving_pb->setValue(((i+1)/static_cast<float>(count)) * 100);
 
 				if(model->isModified() || !QFileInfo(model->getTempFilename()).exists())
-					model->getDatabaseModel()->saveModel(model->getTempFilename(), SchemaParser::XML_DEFINITION);
+					model->getDatabaseModel()->saveModel(model->getTempFilename(), SchemaParser::XML_DEFINITION, false);
 
 				QThread::msleep(200);
 			}
@@ -1186,6 +1189,12 @@ void MainWindow::applyConfigurations(void)
 		{
 			model=dynamic_cast<ModelWidget *>(models_tbw->widget(i));
 			model->db_model->setObjectsModified();
+			model->scene->setZoomFactor(model->current_zoom);
+
+			//Tables created as placeholders must have their item trees created when the lazy item trees are turned off
+			if(!BaseTableView::isLazyItemTrees())
+				model->scene->createAllItemTrees();
+
 			model->update();
 		}
 
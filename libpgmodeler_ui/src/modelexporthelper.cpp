@@ -3,6 +3,7 @@
 
 ModelExportHelper::ModelExportHelper(QObject *parent) : QObject(parent)
 {
+	ddl_batch_size=DEFAULT_DDL_BATCH_SIZE;
 	resetExportParams();
 }
 
@@ -59,6 +60,11 @@ void ModelExportHelper::setIgnoredErrors(const QStringList &err_codes)
 	}
 }
 
+void ModelExportHelper::setDDLBatchSize(unsigned batch_size)
+{
+	ddl_batch_size=(batch_size==0 ? 1 : batch_size);
+}
+
 void ModelExportHelper::exportToSQL(DatabaseModel *db_model, const QString &filename, const QString &pgsql_ver)
 {
 	if(!db_model)
@@ -93,6 +99,9 @@ void ModelExportHelper::exportToPNG(ObjectsScene *scene, const QString &filename
 	if(!scene)
 		throw Exception(ERR_ASG_NOT_ALOC_OBJECT,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
+	//The tables are always rendered in full detail regardless the zoom applied to the canvas
+	double zoom_factor=scene->getZoomFactor();
+
 	try
 	{
 		QPixmap pix;
@@ -115,6 +124,9 @@ void ModelExportHelper::exportToPNG(ObjectsScene *scene, const QString &filename
 
 		//Clear the object scene selection to avoid drawing the selectoin rectangle of the objects
 		scene->clearSelection();
+		scene->setZoomFactor(1);
+		scene->createAllItemTrees();
+		scene->setItemCacheSuspended(true);
 
 		//Make a backup of the current scene options
 		ObjectsScene::getGridOptions(shw_grd, align_objs, shw_dlm);
@@ -212,6 +224,8 @@ void ModelExportHelper::exportToPNG(ObjectsScene *scene, const QString &filename
 			{
 				//Restoring the scene settings before throw error
 				ObjectsScene::setGridOptions(shw_grd, align_objs, shw_dlm);
+				scene->setZoomFactor(zoom_factor);
+				scene->setItemCacheSuspended(false);
 				scene->update();
 
 				throw Exception(Exception::getErrorMessage(ERR_FILE_DIR_NOT_WRITTEN).arg(file),
@@ -221,6 +235,8 @@ void ModelExportHelper::exportToPNG(ObjectsScene *scene, const QString &filename
 
 		//Restoring the scene settings
 		ObjectsScene::setGridOptions(shw_grd, align_objs, shw_dlm);
+		scene->setZoomFactor(zoom_factor);
+		scene->setItemCacheSuspended(false);
 		scene->update();
 
 		if(!export_canceled)
@@ -249,10 +265,14 @@ void ModelExportHelper::exportToSVG(ObjectsScene *scene, const QString &filename
 	QSvgGenerator svg_gen;
 	QRectF scene_rect=scene->itemsBoundingRect();
 	QFileInfo fi(filename);
+	double zoom_factor=scene->getZoomFactor();
 
 	//Making a backup of the current scene options
 	ObjectsScene::getGridOptions(shw_grd, align_objs, shw_dlm);	
 	scene->setBackgroundBrush(Qt::NoBrush);
+	scene->setZoomFactor(1);
+	scene->createAllItemTrees();
+	scene->setItemCacheSuspended(true);
 
 	//Disabling grid and delimiters
 	ObjectsScene::setGridOptions(show_grid, false, show_delim);
@@ -272,6 +292,8 @@ void ModelExportHelper::exportToSVG(ObjectsScene *scene, const QString &filename
 
 	//Restoring the scene settings
 	ObjectsScene::setGridOptions(shw_grd, align_objs, shw_dlm);
+	scene->setZoomFactor(zoom_factor);
+	scene->setItemCacheSuspended(false);
 	scene->update();
 
 	if(!fi.exists() || !fi.isWritable() || !fi.isReadable())
@@ -313,7 +335,8 @@ void ModelExportHelper::exportToSVG(ObjectsScene *scene, const QString &filename
 void ModelExportHelper::exportToDBMS(DatabaseModel *db_model, Connection conn, const QString &pgsql_ver, bool ignore_dup, bool drop_db, bool drop_objs, bool simulate, bool use_tmp_names)
 {
 	int type_id;
-	QString  version, sql_cmd, buf;
+	QString  version, sql_cmd;
+	vector<DatabaseModel::SQLStatement> stmts;
 	Connection new_db_conn;
 	unsigned i, count;
 	ObjectType types[]={OBJ_ROLE, OBJ_TABLESPACE};
@@ -477,10 +500,10 @@ void ModelExportHelper::exportToDBMS(DatabaseModel *db_model, Connection conn, c
 			emit s_progressUpdated(progress,
 								   trUtf8("Generating SQL for `%1' objects...").arg(db_model->getObjectCount()));
 
-			//Exporting the database model definition using the opened connection
-			buf=db_model->getCodeDefinition(SchemaParser::SQL_DEFINITION, false);
+			//Exporting the database model statements using the opened connection
+			db_model->getSQLStatements(stmts, drop_objs);
 			progress=40;
-			exportBufferToDBMS(buf, new_db_conn, drop_objs);
+			exportStatementsToDBMS(stmts, new_db_conn);
 		}
 
 		disconnect(db_model, nullptr, this, nullptr);
@@ -721,6 +744,142 @@ bool ModelExportHelper::isDuplicationError(const QString &error_code)
 	return(err_codes.contains(error_code));
 }
 
+bool ModelExportHelper::isStandaloneCommand(const QString &sql_cmd)
+{
+	static QRegExp standalone_cmd_reg=QRegExp(QString("^((CREATE|DROP|ALTER)( )+(DATABASE|TABLESPACE|SYSTEM)|CREATE( )+(UNIQUE( )+)?INDEX( )+CONCURRENTLY|") +
+																						QString("DROP( )+INDEX( )+CONCURRENTLY|ALTER( )+TYPE(.)+( )+ADD( )+VALUE|VACUUM|CLUSTER|REINDEX|") +
+																						QString("BEGIN|START( )+TRANSACTION|COMMIT|END|ROLLBACK|ABORT|SAVEPOINT|RELEASE|PREPARE( )+TRANSACTION)(.)*"),
+																						Qt::CaseInsensitive);
+
+	return(standalone_cmd_reg.exactMatch(sql_cmd.simplified()));
+}
+
+void ModelExportHelper::emitCommandProgress(const DDLCommand &ddl_cmd)
+{
+	emit s_progressUpdated(ddl_cmd.progress, ddl_cmd.msg, ddl_cmd.obj_type, ddl_cmd.sql);
+}
+
+bool ModelExportHelper::executeDDLBatch(Connection &conn, const vector<DDLCommand> &ddl_cmds)
+{
+	if(ddl_cmds.empty())
+		return(false);
+
+	if(ddl_cmds.size() > 1)
+	{
+		QStringList sql_cmds;
+
+		for(auto &ddl_cmd : ddl_cmds)
+			sql_cmds.push_back(ddl_cmd.sql);
+
+		try
+		{
+			conn.executeDDLCommand(sql_cmds.join(QString("\n")));
+
+			for(auto &ddl_cmd : ddl_cmds)
+				emitCommandProgress(ddl_cmd);
+
+			return(false);
+		}
+		catch(Exception &)
+		{
+			/* The whole batch was rolled back so its commands are executed again one by one below
+			in order to find the failed command(s) */
+		}
+	}
+
+	for(auto &ddl_cmd : ddl_cmds)
+	{
+		emitCommandProgress(ddl_cmd);
+
+		try
+		{
+			conn.executeDDLCommand(ddl_cmd.sql);
+		}
+		catch(Exception &e)
+		{
+			handleSQLError(e, ddl_cmd.sql, ignore_dup);
+		}
+	}
+
+	return(ddl_cmds.size() > 1);
+}
+
+void ModelExportHelper::queueDDLCommand(Connection &conn, const DDLCommand &ddl_cmd, vector<DDLCommand> &batch_cmds, bool &batch_enabled)
+{
+	if(!batch_enabled || isStandaloneCommand(ddl_cmd.sql))
+	{
+		/* Commands that handle transactions disable the batches for the rest of the export since
+		a failed batch inside an explicit transaction would abort the whole transaction */
+		if(batch_enabled && QRegExp(QString("^(BEGIN|START|SAVEPOINT|PREPARE)(.)*"), Qt::CaseInsensitive).exactMatch(ddl_cmd.sql.simplified()))
+			batch_enabled=false;
+
+		//The pending batch is executed first in order to respect the commands order
+		if(executeDDLBatch(conn, batch_cmds))
+			batch_enabled=false;
+
+		batch_cmds.clear();
+		executeDDLBatch(conn, { ddl_cmd });
+	}
+	else
+	{
+		batch_cmds.push_back(ddl_cmd);
+
+		if(static_cast<unsigned>(batch_cmds.size()) >= ddl_batch_size)
+		{
+			if(executeDDLBatch(conn, batch_cmds))
+				batch_enabled=false;
+
+			batch_cmds.clear();
+		}
+	}
+}
+
+void ModelExportHelper::exportStatementsToDBMS(const vector<DatabaseModel::SQLStatement> &stmts, Connection &conn)
+{
+	vector<DDLCommand> batch_cmds;
+	DDLCommand ddl_cmd;
+	QString msg, obj_name;
+	bool batch_enabled=(ddl_batch_size > 1);
+	unsigned idx=0, count=stmts.size();
+
+	for(auto &stmt : stmts)
+	{
+		if(export_canceled)
+			break;
+
+		ddl_cmd.progress=progress + ((idx++/static_cast<float>(count)) * 60);
+		ddl_cmd.sql=stmt.sql;
+
+		if(stmt.object && stmt.obj_type!=BASE_OBJECT)
+		{
+			obj_name=stmt.object->getSignature(false);
+
+			if(stmt.sql.startsWith(QString("DROP")) ||
+				 (stmt.sql.startsWith(QString("ALTER TABLE")) && stmt.sql.contains(QString(" DROP "))))
+				msg=trUtf8("Dropping object `%1' (%2)");
+			else if(stmt.sql.startsWith(QString("CREATE")) || TableObject::isTableObject(stmt.obj_type))
+				msg=trUtf8("Creating object `%1' (%2)");
+			else
+				msg=trUtf8("Changing object `%1' (%2)");
+
+			ddl_cmd.msg=msg.arg(obj_name).arg(stmt.object->getTypeName());
+			ddl_cmd.obj_type=stmt.obj_type;
+		}
+		else
+		{
+			//General commands like grant, revoke or set aren't explicitly shown
+			ddl_cmd.msg=trUtf8("Running auxiliary command.");
+			ddl_cmd.obj_type=BASE_OBJECT;
+		}
+
+		//The progress is emitted only when the command is executed (see executeDDLBatch())
+		queueDDLCommand(conn, ddl_cmd, batch_cmds, batch_enabled);
+	}
+
+	if(!export_canceled)
+		executeDDLBatch(conn, batch_cmds);
+}
+
 void ModelExportHelper::exportBufferToDBMS(const QString &buffer, Connection &conn, bool drop_objs)
 {
 	Connection aux_conn;
@@ -729,9 +888,12 @@ void ModelExportHelper::exportBufferToDBMS(const QString &buffer, Connection &co
 			alter_tab=QString("ALTER TABLE");
 	//vector<Exception> errors;
 	vector<QString> db_sql_cmds;
+	vector<DDLCommand> batch_cmds;
+	DDLCommand ddl_cmd;
 	QTextStream ts;
 	ObjectType obj_type=BASE_OBJECT;
-	bool ddl_tk_found=false, is_create=false, is_drop=false;
+	bool ddl_tk_found=false, is_create=false, is_drop=false,
+			batch_running=false, batch_enabled=(ddl_batch_size > 1);
 	unsigned aux_prog=0, curr_size=0, buf_size=sql_buf.size(),
 			factor=(db_name.isEmpty() ? 70 : 90);
 	int pos=0, pos1=0, comm_cnt=0;
@@ -752,8 +914,9 @@ void ModelExportHelper::exportBufferToDBMS(const QString &buffer, Connection &co
 								   OBJ_EVENT_TRIGGER, OBJ_DATABASE };
 
 
-	/* Extract each SQL command from the buffer and execute them separately. This is done
-   to permit the user, in case of error, identify what object is wrongly configured. */
+	/* Extract each SQL command from the buffer and execute them in batches. This is done to reduce the
+	amount of round trips to the server while still permitting the user, in case of error, identify what
+	object is wrongly configured (see executeDDLBatch()). */
 	ts.setString(&sql_buf);
 
 	if(!conn.isStablished())
@@ -843,7 +1006,8 @@ void ModelExportHelper::exportBufferToDBMS(const QString &buffer, Connection &co
 					else
 						msg=trUtf8("Creating object `%1' (%2)").arg(obj_name).arg(BaseObject::getTypeName(obj_type));
 
-					emit s_progressUpdated(aux_prog, msg, obj_type, sql_cmd);
+					ddl_cmd.msg=msg;
+					ddl_cmd.obj_type=obj_type;
 					is_drop=false;
 				}
 				//Check if the regex matches the sql command
@@ -932,29 +1096,50 @@ void ModelExportHelper::exportBufferToDBMS(const QString &buffer, Connection &co
 						}
 					}
 
-					emit s_progressUpdated(aux_prog, msg, obj_type, sql_cmd);
+					ddl_cmd.msg=msg;
+					ddl_cmd.obj_type=obj_type;
 					is_create=is_drop=false;
 					msg.clear();
 				}
 				else if(!sql_cmd.trimmed().isEmpty())
 				{
 					//General commands like grant, revoke or set aren't explicitly shown
-					emit s_progressUpdated(aux_prog, trUtf8("Running auxiliary command."), BASE_OBJECT, sql_cmd);
+					ddl_cmd.msg=trUtf8("Running auxiliary command.");
+					ddl_cmd.obj_type=BASE_OBJECT;
 				}
 
 				//Executes the extracted SQL command
 				if(!sql_cmd.isEmpty())
 				{
-					if(obj_type!=OBJ_DATABASE)
-						conn.executeDDLCommand(sql_cmd);
-					else
+					ddl_cmd.sql=sql_cmd;
+					ddl_cmd.progress=aux_prog;
+
+					if(obj_type==OBJ_DATABASE)
+					{
+						emitCommandProgress(ddl_cmd);
 						db_sql_cmds.push_back(sql_cmd);
+					}
+					else
+					{
+						//The progress is emitted only when the command is executed (see executeDDLBatch())
+						batch_running=true;
+						queueDDLCommand(conn, ddl_cmd, batch_cmds, batch_enabled);
+						batch_running=false;
+					}
 				}
 
 				sql_cmd.clear();
 				ddl_tk_found=false;
 			}
 
+			if(ts.atEnd() && !batch_cmds.empty())
+			{
+				batch_running=true;
+				executeDDLBatch(conn, batch_cmds);
+				batch_cmds.clear();
+				batch_running=false;
+			}
+
 			if(ts.atEnd() && !db_sql_cmds.empty())
 			{
 				conn.close();
@@ -968,6 +1153,10 @@ void ModelExportHelper::exportBufferToDBMS(const QString &buffer, Connection &co
 		{
 			if(ddl_tk_found) ddl_tk_found=false;
 
+			//Errors raised by batches were already handled (see executeDDLBatch()) so the export is aborted
+			if(batch_running)
+				throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e, e.getExtraInfo());
+
 			handleSQLError(e, sql_cmd, ignore_dup);
 
 			sql_cmd.clear();
@@ -32,6 +32,14 @@ class ModelExportHelper: public QObject {
 	private:
 		Q_OBJECT
 
+		/*! \brief Stores a command queued to be executed in a batch (see queueDDLCommand()) along with the progress info
+		which is only emitted when the command is effectively executed */
+		struct DDLCommand {
+			QString sql, msg;
+			ObjectType obj_type;
+			int progress;
+		};
+
 		//! \brief  Stores the total progress
 		int progress,
 
@@ -76,6 +84,9 @@ class ModelExportHelper: public QObject {
 		//! \brief List of ignored error codes
 		QStringList ignored_errors;
 
+		//! \brief Maximum amount of commands sent to the server at once by exportBufferToDBMS() (see setDDLBatchSize())
+		unsigned ddl_batch_size;
+
 		vector<Exception> errors;
 
 		/*! \brief Indicates which role / tablespaces were created on server (only dbms export).
@@ -115,9 +126,31 @@ class ModelExportHelper: public QObject {
 		//! \brief Restore the original name of the database, roles and tablespaces
 		void restoreObjectNames(void);
 
+		/*! \brief Exports the statements generated by the model (see DatabaseModel::getSQLStatements()) to a previously opened connection.
+		Since each statement carries the object that generated it no parsing is needed to report the progress */
+		void exportStatementsToDBMS(const vector<DatabaseModel::SQLStatement> &stmts, Connection &conn);
+
 		//! \brief Exports the contents of the buffer to a previously opened connection
 		void exportBufferToDBMS(const QString &buffer, Connection &conn, bool drop_objs=false);
 
+		/*! \brief Executes a batch of commands in a single round trip emitting the progress of each command once the batch succeeds.
+		Since a multi-statement command runs in an implicit transaction a failed batch leaves no change in the database, so its commands
+		are executed again one by one. Errors on single commands are handled by handleSQLError() so the ignored errors and duplications
+		keep being attributed to the command that caused them. Returns true when the batch failed and was executed one command at a time */
+		bool executeDDLBatch(Connection &conn, const vector<DDLCommand> &ddl_cmds);
+
+		/*! \brief Appends the command to the current batch executing the batch once it reaches the maximum size. Commands that
+		can't be batched (see isStandaloneCommand()) are executed alone right after the pending batch. After the first failed batch
+		the remaining commands are executed one by one since the failures tend to repeat (e.g. ignored duplication errors) */
+		void queueDDLCommand(Connection &conn, const DDLCommand &ddl_cmd, vector<DDLCommand> &batch_cmds, bool &batch_enabled);
+
+		//! \brief Emits the progress related to a command executed by executeDDLBatch()
+		void emitCommandProgress(const DDLCommand &ddl_cmd);
+
+		/*! \brief Returns if the command can't be executed in a batch because it is not allowed inside a transaction block
+		(e.g. CREATE DATABASE, CREATE INDEX CONCURRENTLY) or because it controls the transactions itself (e.g. BEGIN, COMMIT) */
+		bool isStandaloneCommand(const QString &sql_cmd);
+
 		//! \brief Returns if the error code is one of the treated by the export process as object duplication error
 		bool isDuplicationError(const QString &error_code);
 
@@ -135,8 +168,15 @@ class ModelExportHelper: public QObject {
 		void handleSQLError(Exception &e, const QString &sql_cmd, bool ignore_dup);
 
 	public:
+		//! \brief Default amount of commands grouped in a single batch when exporting to DBMS
+		static const unsigned DEFAULT_DDL_BATCH_SIZE=100;
+
 		ModelExportHelper(QObject *parent = 0);
 
+		/*! \brief Defines the maximum amount of commands sent together to the server in the DBMS export.
+		Using 1 causes each command to be executed separately (one round trip per command) */
+		void setDDLBatchSize(unsigned batch_size);
+
 		/*! \brief Determines which error codes must be ignored during the export process.
 		There must be some caution when ignore some error codes because the export may
 		create an incomplete database or even reach unknown behaviors.
@@ -26,6 +26,10 @@ ModelOverviewWidget::ModelOverviewWidget(QWidget *parent) : QWidget(parent, Qt::
 	zoom_factor=1;
 	curr_resize_factor=RESIZE_FACTOR;
 	this->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+
+	update_timer.setSingleShot(true);
+	update_timer.setInterval(0);
+	connect(&update_timer, SIGNAL(timeout()), this, SLOT(redrawOverview()));
 }
 
 void ModelOverviewWidget::show(ModelWidget *model)
@@ -84,6 +88,11 @@ void ModelOverviewWidget::showEvent(QShowEvent *event)
 }
 
 void ModelOverviewWidget::updateOverview(void)
+{
+	update_timer.start();
+}
+
+void ModelOverviewWidget::redrawOverview(void)
 {
 	this->updateOverview(false);
 }
@@ -92,18 +101,18 @@ void ModelOverviewWidget::updateOverview(bool force_update)
 {
 	if(this->model && (this->isVisible() || force_update))
 	{
-		QPixmap pix;
-		QSize size=scene_rect.size().toSize();
-
-		//Creates a pixmap with the size of the scene
-		pix=QPixmap(size);
-
-		//Draw the scene onto the pixmap
-		QPainter p(&pix);
-		this->model->scene->render(&p, pix.rect(), scene_rect.toRect());
-
-		//Resizes the pixmap to the previous configured QSize
-		label->setPixmap(pix.scaled(curr_size.toSize(), Qt::KeepAspectRatio, Qt::SmoothTransformation));
+		QPixmap pix(curr_size.toSize());
+		QPainter p;
+
+		/* Draws the simplified scene directly on the overview's size instead of rendering the whole
+		scene in its original size and scaling it down afterwards */
+		update_timer.stop();
+		p.begin(&pix);
+		p.setRenderHint(QPainter::Antialiasing);
+		this->model->scene->renderOverview(&p, pix.rect(), scene_rect);
+		p.end();
+
+		label->setPixmap(pix);
 		label->resize(curr_size.toSize());
 	}
 }
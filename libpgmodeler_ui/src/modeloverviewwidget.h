@@ -49,6 +49,10 @@ class ModelOverviewWidget: public QWidget, public Ui::ModelOverviewWidget {
 		//! \brief Current scene rectangle
 		QRectF scene_rect;
 
+		/*! \brief Timer used to coalesce the several update requests (e.g. one per object selected in a range selection)
+		into a single redraw of the overview */
+		QTimer update_timer;
+
 		//! \brief Resize factor applied to overview widgets (default: 20% of the scene original size)
 		static constexpr double RESIZE_FACTOR=0.20f;
 
@@ -66,8 +70,12 @@ class ModelOverviewWidget: public QWidget, public Ui::ModelOverviewWidget {
 	public:
 		ModelOverviewWidget(QWidget *parent = 0);
 
+	private slots:
+		//! \brief Redraws the overview (only if the widget is visible)
+		void redrawOverview(void);
+
 	public slots:
-		//! \brief Updates the overview (only if the widget is visible)
+		//! \brief Schedules the update of the overview (only if the widget is visible)
 		void updateOverview(void);
 
 		//! \brief Resizes the frame that represents the visualization window
@@ -60,6 +60,7 @@ bool ModelWidget::cut_operation=false;
 bool ModelWidget::save_restore_pos=true;
 bool ModelWidget::disable_render_smooth=false;
 bool ModelWidget::simple_obj_creation=true;
+bool ModelWidget::stream_loading=true;
 ModelWidget *ModelWidget::src_model=nullptr;
 
 const unsigned ModelWidget::BREAK_VERT_NINETY_DEGREES=0;
@@ -148,7 +149,6 @@ ModelWidget::ModelWidget(QWidget *parent) : QWidget(parent)
 
 	//Force the scene to be drawn from the left to right and from top to bottom
 	viewport->setAlignment(Qt::AlignLeft | Qt::AlignTop);
-	viewport->setViewportUpdateMode(QGraphicsView::MinimalViewportUpdate);
 	viewport->centerOn(0,0);
 
 	grid=new QGridLayout;
@@ -344,6 +344,9 @@ ModelWidget::ModelWidget(QWidget *parent) : QWidget(parent)
 	connect(scene, SIGNAL(s_objectSelected(BaseGraphicObject*,bool)), new_obj_overlay_wgt, SLOT(hide()));
 	connect(scene, SIGNAL(s_objectsScenePressed(Qt::MouseButtons)), new_obj_overlay_wgt, SLOT(hide()));
 
+	connect(viewport->horizontalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(updateExposedRect()));
+	connect(viewport->verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(updateExposedRect()));
+
 	viewport->installEventFilter(this);
 	viewport->horizontalScrollBar()->installEventFilter(this);
 	viewport->verticalScrollBar()->installEventFilter(this);
@@ -402,6 +405,7 @@ void ModelWidget::resizeEvent(QResizeEvent *)
 						(this->height()/2)  - (zoom_info_lbl->height()/2));
 
 	adjustOverlayPosition();
+	updateExposedRect();
 	emit s_modelResized();
 }
 
@@ -548,6 +552,8 @@ void ModelWidget::applyZoom(double zoom)
 		viewport->resetTransform();
 		viewport->scale(zoom, zoom);
 		this->current_zoom=zoom;
+		scene->setZoomFactor(zoom);
+		updateExposedRect();
 
 		zoom_info_lbl->setText(trUtf8("Zoom: %1%").arg(QString::number(this->current_zoom * 100, 'g' , 3)));
 		zoom_info_lbl->setVisible(true);
@@ -557,6 +563,11 @@ void ModelWidget::applyZoom(double zoom)
 	}
 }
 
+void ModelWidget::updateExposedRect(void)
+{
+	scene->setExposedRect(viewport->mapToScene(viewport->viewport()->rect()).boundingRect());
+}
+
 double ModelWidget::getCurrentZoom(void)
 {
 	return(current_zoom);
@@ -1104,7 +1115,7 @@ void ModelWidget::loadModel(const QString &filename)
 		task_prog_wgt.setWindowTitle(trUtf8("Loading database model"));
 		task_prog_wgt.show();
 
-		db_model->loadModel(filename);
+		db_model->loadModel(filename, stream_loading);
 		this->filename=filename;
 		this->adjustSceneSize();
 
@@ -1166,6 +1177,10 @@ void ModelWidget::printModel(QPrinter *printer, bool print_grid, bool print_page
 		//Reconfigure the grid options based upon the passed settings
 		ObjectsScene::setGridOptions(print_grid, align_objs, false);
 
+		//The tables are printed in full detail regardless the current zoom
+		scene->setZoomFactor(1);
+		scene->createAllItemTrees();
+		scene->setItemCacheSuspended(true);
 		scene->update();
 		scene->clearSelection();
 
@@ -1282,6 +1297,8 @@ void ModelWidget::printModel(QPrinter *printer, bool print_grid, bool print_page
 
 		//Restore the grid option backup
 		ObjectsScene::setGridOptions(show_grid, align_objs, show_delims);
+		scene->setZoomFactor(current_zoom);
+		scene->setItemCacheSuspended(false);
 		scene->update();
 	}
 }
@@ -1291,6 +1308,11 @@ void ModelWidget::updateRenderHints(void)
 	viewport->setRenderHint(QPainter::Antialiasing, !disable_render_smooth);
 	viewport->setRenderHint(QPainter::TextAntialiasing, !disable_render_smooth);
 	viewport->setRenderHint(QPainter::SmoothPixmapTransform, !disable_render_smooth);
+
+	/* When the frame time is displayed the whole viewport is repainted at each frame so the
+	measurements are comparable and the text isn't dragged along while scrolling */
+	viewport->setViewportUpdateMode(ObjectsScene::isShowFrameTime() ?
+																		QGraphicsView::FullViewportUpdate : QGraphicsView::MinimalViewportUpdate);
 }
 
 void ModelWidget::update(void)
@@ -3280,6 +3302,11 @@ void ModelWidget::setSimplifiedObjectCreation(bool value)
 	ModelWidget::simple_obj_creation=value;
 }
 
+void ModelWidget::setStreamLoading(bool value)
+{
+	ModelWidget::stream_loading=value;
+}
+
 void ModelWidget::highlightObject(void)
 {
 	QAction *action=dynamic_cast<QAction *>(sender());
@@ -60,7 +60,10 @@ class ModelWidget: public QWidget {
 		//! \brief Indicates that graphical objects like table, view and textboxes can be created without click canvas (direclty from their editing form)
 		simple_obj_creation,
 
-		disable_render_smooth;
+		disable_render_smooth,
+
+		//! \brief Indicates that the model files are read as a stream instead of being fully loaded in memory (see DatabaseModel::loadModel)
+		stream_loading;
 
 		/*! \brief Stores the model that generates the copy/cut operation. This model is updated
 		from the destination model whenever a past/cut operation is done. */
@@ -254,6 +257,9 @@ class ModelWidget: public QWidget {
 		//! \brief Defines if any instance of the class must simiplify the graphical object's creation
 		static void setSimplifiedObjectCreation(bool value);
 
+		//! \brief Defines if any instance of the class must load the model files as a stream
+		static void setStreamLoading(bool value);
+
 		//! \brief Restore the last editing position on canvas as well the zoom factor
 		void restoreLastCanvasPosition(void);
 
@@ -266,6 +272,9 @@ class ModelWidget: public QWidget {
 		void updateRenderHints(void);
 
 	private slots:
+		//! \brief Informs the scene the area currently visible on the viewport so the tables there can have their item trees created
+		void updateExposedRect(void);
+
 		//! \brief Handles the signals that indicates the object creation on the reference database model
 		void handleObjectAddition(BaseObject *object);
 
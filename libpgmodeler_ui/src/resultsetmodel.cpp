@@ -0,0 +1,409 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2016 - Raphael Araújo e Silva <raphael@pgmodeler.com.br>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "resultsetmodel.h"
+#include <QFont>
+#include <algorithm>
+
+ResultSetModel::ResultSetModel(ResultSet &res, Catalog &catalog, QObject *parent) : QAbstractTableModel(parent)
+{
+	try
+	{
+		vector<unsigned> type_ids;
+		vector<unsigned>::iterator end;
+		vector<attribs_map> types;
+		map<unsigned, QString> types_map;
+		unsigned orig_filter=catalog.getFilter();
+
+		tuple_count=new_row_count=0;
+		col_count=res.getColumnCount();
+		editable=false;
+
+		for(int col=0; col < col_count; col++)
+		{
+			col_names.push_back(res.getColumnName(col));
+			type_ids.push_back(res.getColumnTypeId(col));
+			binary_cols.push_back(res.isColumnBinaryFormat(col));
+		}
+
+		//Retrieving the data type names for each column
+		catalog.setFilter(Catalog::LIST_ALL_OBJS);
+		std::sort(type_ids.begin(), type_ids.end());
+		end=std::unique(type_ids.begin(), type_ids.end());
+		type_ids.erase(end, type_ids.end());
+
+		types=catalog.getObjectsAttributes(OBJ_TYPE, QString(), QString(), type_ids);
+
+		for(auto &tp : types)
+			types_map[tp[ParsersAttributes::OID].toUInt()]=tp[ParsersAttributes::NAME];
+
+		catalog.setFilter(orig_filter);
+
+		for(int col=0; col < col_count; col++)
+			type_names.push_back(types_map[res.getColumnTypeId(col)]);
+
+		appendResultSet(res);
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+ResultSetModel::~ResultSetModel(void)
+{
+	for(auto &res : results)
+		delete(res);
+}
+
+void ResultSetModel::appendResultSet(ResultSet &res)
+{
+	try
+	{
+		int count=(res.isEmpty() ? 0 : res.getTupleCount());
+		ResultSet *new_res=nullptr;
+
+		if(res.getColumnCount()!=col_count)
+			throw Exception(ERR_REF_TUPLE_COL_INV_INDEX, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+		if(count==0)
+			return;
+
+		//The batch's result is moved to the model instead of being copied since the batches aren't used after appended
+		new_res=new ResultSet;
+		new_res->swap(res);
+
+		beginInsertRows(QModelIndex(), tuple_count, tuple_count + count - 1);
+
+		results.push_back(new_res);
+		results_offsets.push_back(tuple_count);
+
+		//Moving the changes made on new rows since the tuples are placed before them
+		shiftRows(changed_values, tuple_count - 1, count);
+		shiftRows(row_ops, tuple_count - 1, count);
+		shiftRows(row_colors, tuple_count - 1, count);
+		shiftRows(row_tooltips, tuple_count - 1, count);
+
+		tuple_count+=count;
+		endInsertRows();
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+unsigned ResultSetModel::getResultSetIndex(int row) const
+{
+	//Finding the result set that contains the row (the last one which offset is less than or equal to the row)
+	auto itr=std::upper_bound(results_offsets.begin(), results_offsets.end(), row);
+	return((itr - results_offsets.begin()) - 1);
+}
+
+QString ResultSetModel::getOriginalValue(int row, int col) const
+{
+	unsigned idx=getResultSetIndex(row);
+	return(QString(results[idx]->getColumnValue(row - results_offsets[idx], col)));
+}
+
+bool ResultSetModel::isOriginalValueNull(int row, int col) const
+{
+	unsigned idx=0;
+
+	if(row >= tuple_count)
+		return(false);
+
+	idx=getResultSetIndex(row);
+	return(results[idx]->isColumnValueNull(row - results_offsets[idx], col));
+}
+
+bool ResultSetModel::isNullCell(int row, int col) const
+{
+	auto row_itr=changed_values.find(row);
+
+	//Changed cells are never considered null since the user typed a value for them
+	if(row_itr!=changed_values.end() && row_itr->second.count(col))
+		return(false);
+
+	return(isOriginalValueNull(row, col));
+}
+
+bool ResultSetModel::isBinaryCell(int row, int col) const
+{
+	return(binary_cols[col] || (isNewRow(row) && type_names[col]==QString("bytea")));
+}
+
+template<class Class>
+void ResultSetModel::shiftRows(map<int, Class> &rows_map, int row, int offset)
+{
+	map<int, Class> shifted;
+
+	for(auto &itr : rows_map)
+	{
+		if(itr.first > row)
+			shifted[itr.first + offset]=itr.second;
+		else
+			shifted[itr.first]=itr.second;
+	}
+
+	rows_map.swap(shifted);
+}
+
+int ResultSetModel::rowCount(const QModelIndex &parent) const
+{
+	if(parent.isValid())
+		return(0);
+
+	return(tuple_count + new_row_count);
+}
+
+int ResultSetModel::columnCount(const QModelIndex &parent) const
+{
+	if(parent.isValid())
+		return(0);
+
+	return(col_count);
+}
+
+QVariant ResultSetModel::data(const QModelIndex &index, int role) const
+{
+	int row=index.row(), col=index.column();
+
+	if(!index.isValid() || row >= rowCount() || col >= col_count)
+		return(QVariant());
+
+	if(role==Qt::DisplayRole || role==Qt::EditRole)
+	{
+		if(isBinaryCell(row, col))
+			return(trUtf8("[binary data]"));
+
+		auto row_itr=changed_values.find(row);
+
+		if(row_itr!=changed_values.end())
+		{
+			auto col_itr=row_itr->second.find(col);
+
+			if(col_itr!=row_itr->second.end())
+				return(col_itr->second);
+		}
+
+		if(row < tuple_count)
+			return(getOriginalValue(row, col));
+
+		return(QString());
+	}
+	else if(role==Qt::UserRole)
+	{
+		if(binary_cols[col] || row >= tuple_count)
+			return(QVariant());
+
+		return(getOriginalValue(row, col));
+	}
+	else if(role==Qt::FontRole)
+	{
+		auto row_itr=changed_values.find(row);
+
+		if(row < tuple_count && row_itr!=changed_values.end() && row_itr->second.count(col))
+		{
+			QFont fnt;
+			fnt.setBold(true);
+			return(fnt);
+		}
+	}
+	else if(role==Qt::BackgroundRole && row_colors.count(row))
+		return(row_colors.at(row));
+	else if(role==Qt::ToolTipRole && row_tooltips.count(row))
+		return(row_tooltips.at(row));
+	/* Null values are displayed as empty strings (so the generated commands and the copied values remain the same)
+	thus they are distinguished from the empty strings by the cell's background and tooltip */
+	else if(role==Qt::BackgroundRole && isNullCell(row, col))
+		return(QColor(225, 225, 225));
+	else if(role==Qt::ToolTipRole && isNullCell(row, col))
+		return(QString("NULL"));
+
+	return(QVariant());
+}
+
+QVariant ResultSetModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+	if(orientation==Qt::Horizontal)
+	{
+		if(section < 0 || section >= col_count)
+			return(QVariant());
+
+		if(role==Qt::DisplayRole)
+			return(col_names[section]);
+		else if(role==Qt::ToolTipRole)
+			return(col_names[section] + QString(" [%1]").arg(type_names[section]));
+		else if(role==Qt::UserRole)
+			return(type_names[section]);
+		else if(role==Qt::TextAlignmentRole)
+			return(static_cast<int>(Qt::AlignLeft | Qt::AlignVCenter));
+	}
+	else if(role==Qt::DisplayRole)
+		return(QString::number(section + 1));
+
+	return(QVariant());
+}
+
+Qt::ItemFlags ResultSetModel::flags(const QModelIndex &index) const
+{
+	Qt::ItemFlags flags=QAbstractTableModel::flags(index);
+
+	//Binary columns can't be edited by user
+	if(editable && index.isValid() && !isBinaryCell(index.row(), index.column()))
+		flags|=Qt::ItemIsEditable;
+
+	return(flags);
+}
+
+bool ResultSetModel::setData(const QModelIndex &index, const QVariant &value, int role)
+{
+	int row=index.row(), col=index.column();
+
+	if(role!=Qt::EditRole || !index.isValid() || row >= rowCount() || col >= col_count || isBinaryCell(row, col))
+		return(false);
+
+	QString str_value=value.toString();
+
+	/* Values equal to the original ones are discarded so only the
+	cells effectively changed are kept in the changed values map */
+	if(row < tuple_count && str_value==getOriginalValue(row, col))
+	{
+		if(changed_values.count(row))
+		{
+			changed_values[row].erase(col);
+
+			if(changed_values[row].empty())
+				changed_values.erase(row);
+		}
+	}
+	else
+		changed_values[row][col]=str_value;
+
+	emit dataChanged(index, index);
+	emit s_cellValueChanged(row, col);
+	return(true);
+}
+
+bool ResultSetModel::insertRows(int row, int count, const QModelIndex &parent)
+{
+	if(parent.isValid() || count <= 0 || row!=rowCount())
+		return(false);
+
+	beginInsertRows(parent, row, row + count - 1);
+	new_row_count+=count;
+	endInsertRows();
+	return(true);
+}
+
+bool ResultSetModel::removeRows(int row, int count, const QModelIndex &parent)
+{
+	int last_row=row + count - 1;
+
+	if(parent.isValid() || count <= 0 || row < tuple_count || last_row >= rowCount())
+		return(false);
+
+	beginRemoveRows(parent, row, last_row);
+
+	for(int rw=row; rw <= last_row; rw++)
+	{
+		changed_values.erase(rw);
+		row_ops.erase(rw);
+		row_colors.erase(rw);
+		row_tooltips.erase(rw);
+	}
+
+	//Moving the data of the rows after the removed ones
+	shiftRows(changed_values, last_row, -count);
+	shiftRows(row_ops, last_row, -count);
+	shiftRows(row_colors, last_row, -count);
+	shiftRows(row_tooltips, last_row, -count);
+
+	new_row_count-=count;
+	endRemoveRows();
+	return(true);
+}
+
+void ResultSetModel::setEditable(bool value)
+{
+	beginResetModel();
+	editable=value;
+	endResetModel();
+}
+
+bool ResultSetModel::isNewRow(int row) const
+{
+	return(row >= tuple_count && row < rowCount());
+}
+
+bool ResultSetModel::isBinaryColumn(int col) const
+{
+	return(col >= 0 && col < col_count && binary_cols[col]);
+}
+
+bool ResultSetModel::isRowChanged(int row) const
+{
+	return(changed_values.count(row) > 0);
+}
+
+void ResultSetModel::setRowOperation(int row, unsigned operation, const QColor &color, const QString &tooltip)
+{
+	if(row < 0 || row >= rowCount())
+		return;
+
+	if(operation==0)
+	{
+		row_ops.erase(row);
+		row_colors.erase(row);
+		row_tooltips.erase(row);
+	}
+	else
+	{
+		row_ops[row]=operation;
+
+		if(color.isValid())
+			row_colors[row]=color;
+		else
+			row_colors.erase(row);
+
+		if(!tooltip.isEmpty())
+			row_tooltips[row]=tooltip;
+		else
+			row_tooltips.erase(row);
+	}
+
+	emit dataChanged(index(row, 0), index(row, col_count - 1));
+}
+
+unsigned ResultSetModel::getRowOperation(int row) const
+{
+	if(row_ops.count(row))
+		return(row_ops.at(row));
+
+	return(0);
+}
+
+void ResultSetModel::restoreRow(int row)
+{
+	if(changed_values.count(row))
+	{
+		changed_values.erase(row);
+		emit dataChanged(index(row, 0), index(row, col_count - 1));
+	}
+}
@@ -0,0 +1,156 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2016 - Raphael Araújo e Silva <raphael@pgmodeler.com.br>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libpgmodeler_ui
+\class ResultSetModel
+\brief Implements a table model that reads the cells values directly from result sets only when they are requested by the views,
+so no object is created per cell. Result sets can be appended to the model as they are received from the server (see appendResultSet()). The values changed by the user, the rows added after the result set's tuples and the operations
+marked on rows are stored apart and only for the affected cells/rows. This way the memory used by the model doesn't grow with the
+result set size but with the amount of changes made on it.
+*/
+
+#ifndef RESULT_SET_MODEL_H
+#define RESULT_SET_MODEL_H
+
+#include <QAbstractTableModel>
+#include <QColor>
+#include "resultset.h"
+#include "catalog.h"
+
+class ResultSetModel: public QAbstractTableModel {
+	private:
+		Q_OBJECT
+
+		//! \brief Result sets from which the cells values are read
+		vector<ResultSet *> results;
+
+		//! \brief Stores the index of the first row of each result set in the model
+		vector<int> results_offsets;
+
+		//! \brief Amount of tuples in all the result sets
+		int tuple_count,
+
+		//! \brief Amount of columns in the result sets
+		col_count,
+
+		//! \brief Amount of rows added after the result set's tuples (see insertRows())
+		new_row_count;
+
+		//! \brief Indicates if the cells (except the binary ones) can be edited by the user
+		bool editable;
+
+		//! \brief Names of the columns as well the names of their data types
+		QStringList col_names, type_names;
+
+		//! \brief Indicates which columns store binary data (their values are not displayed)
+		vector<bool> binary_cols;
+
+		//! \brief Stores the values changed by the user. The key is the row and the inner key the column
+		map<int, map<int, QString>> changed_values;
+
+		//! \brief Stores the operation of the marked rows (see setRowOperation())
+		map<int, unsigned> row_ops;
+
+		//! \brief Stores the highlight colors of the marked rows
+		map<int, QColor> row_colors;
+
+		//! \brief Stores the tooltips of the marked rows
+		map<int, QString> row_tooltips;
+
+		/*! \brief Returns if the cell stores binary data. Columns of type bytea are considered binary
+		for new rows since their values can't be handled as text in the grid */
+		bool isBinaryCell(int row, int col) const;
+
+		//! \brief Returns the index of the result set (in the results vector) that contains the row
+		unsigned getResultSetIndex(int row) const;
+
+		//! \brief Returns the original value of the cell reading it from the result set that contains the row
+		QString getOriginalValue(int row, int col) const;
+
+		//! \brief Returns if the original value of the cell is null. New rows have no original value so they're never null
+		bool isOriginalValueNull(int row, int col) const;
+
+		//! \brief Moves the entries of the map which keys (rows) are greater than the specified row by the offset
+		template<class Class>
+		static void shiftRows(map<int, Class> &rows_map, int row, int offset);
+
+	public:
+		/*! \brief Creates a model over the result set. The result is moved to the model so the original
+		result set is left empty. The catalog is used to retrieve the columns data types names */
+		ResultSetModel(ResultSet &res, Catalog &catalog, QObject *parent=nullptr);
+		~ResultSetModel(void);
+
+		/*! \brief Appends the tuples of the result set after the ones already in the model (but before the rows created by insertRows()).
+		The result set must have the same columns of the one used to create the model. The result is moved to the model
+		so the original result set is left empty */
+		void appendResultSet(ResultSet &res);
+
+		//! \brief Returns if the cell holds a null value retrieved from the server (and not changed by the user)
+		bool isNullCell(int row, int col) const;
+
+		int rowCount(const QModelIndex &parent=QModelIndex()) const;
+		int columnCount(const QModelIndex &parent=QModelIndex()) const;
+
+		/*! \brief Returns the value of the cell for the display/edit roles, the original value (from result set) for
+		Qt::UserRole as well the font, color and tooltip related to the changes made on the cell's row */
+		QVariant data(const QModelIndex &index, int role=Qt::DisplayRole) const;
+
+		/*! \brief Returns the columns names (display role), names and types (tooltip role) and types names (Qt::UserRole)
+		for the horizontal header and the row number for the vertical header */
+		QVariant headerData(int section, Qt::Orientation orientation, int role=Qt::DisplayRole) const;
+
+		Qt::ItemFlags flags(const QModelIndex &index) const;
+
+		//! \brief Changes the value of the cell. Values equal to the original one are removed from the changed values
+		bool setData(const QModelIndex &index, const QVariant &value, int role=Qt::EditRole);
+
+		//! \brief Appends empty rows to the model. New rows can only be added after the last row
+		bool insertRows(int row, int count, const QModelIndex &parent=QModelIndex());
+
+		//! \brief Removes rows added by insertRows(). The result set's tuples can't be removed
+		bool removeRows(int row, int count, const QModelIndex &parent=QModelIndex());
+
+		//! \brief Enables the edition of the cells (except the binary ones)
+		void setEditable(bool value);
+
+		//! \brief Returns if the row was added by insertRows()
+		bool isNewRow(int row) const;
+
+		//! \brief Returns if the column stores binary data
+		bool isBinaryColumn(int col) const;
+
+		//! \brief Returns if the row has at least one value changed
+		bool isRowChanged(int row) const;
+
+		/*! \brief Marks the row with an operation highlighting it with the color and tooltip provided. The meaning of the operation is
+		defined by the model's user, the only reserved value is zero which unmarks the row */
+		void setRowOperation(int row, unsigned operation, const QColor &color=QColor(), const QString &tooltip=QString());
+
+		//! \brief Returns the operation marked on the row (zero if it is not marked)
+		unsigned getRowOperation(int row) const;
+
+		//! \brief Discards the values changed on the row restoring the original ones
+		void restoreRow(int row);
+
+	signals:
+		//! \brief Signal emitted whenever a cell value is changed through setData()
+		void s_cellValueChanged(int row, int col);
+};
+
+#endif
@@ -23,10 +23,17 @@
 #include "pgmodeleruins.h"
 #include "plaintextitemdelegate.h"
 
+unsigned SQLExecutionWidget::results_limit=100000;
+
 SQLExecutionWidget::SQLExecutionWidget(QWidget * parent) : QWidget(parent)
 {
+	QAction *act=nullptr;
+
 	setupUi(this);
 
+	retrieved_rows=0;
+	has_results=cancel_requested=false;
+
 	sql_cmd_txt=PgModelerUiNS::createNumberedTextEditor(sql_cmd_wgt);
 
 	cmd_history_txt->setTabStopWidth(sql_cmd_txt->getTabWidth());
@@ -48,6 +55,13 @@ SQLExecutionWidget::SQLExecutionWidget(QWidget * parent) : QWidget(parent)
 	sql_file_dlg.setModal(true);
 
 	snippets_tb->setMenu(&snippets_menu);
+
+	act=run_sql_menu.addAction(trUtf8("Export results to CSV file"), this, SLOT(exportQueryToFile()));
+	act->setData(false);
+	act=run_sql_menu.addAction(trUtf8("Export results to binary file"), this, SLOT(exportQueryToFile()));
+	act->setData(true);
+	run_sql_tb->setMenu(&run_sql_menu);
+	run_sql_tb->setPopupMode(QToolButton::MenuButtonPopup);
 	code_compl_wgt=new CodeCompletionWidget(sql_cmd_txt);
 
 	find_replace_wgt=new FindReplaceWidget(sql_cmd_txt, find_wgt_parent);
@@ -57,6 +71,7 @@ SQLExecutionWidget::SQLExecutionWidget(QWidget * parent) : QWidget(parent)
 	find_wgt_parent->setVisible(false);
 
 	run_sql_tb->setToolTip(run_sql_tb->toolTip() + QString(" (%1)").arg(run_sql_tb->shortcut().toString()));
+	stop_tb->setToolTip(stop_tb->toolTip() + QString(" (%1)").arg(stop_tb->shortcut().toString()));
 	export_tb->setToolTip(export_tb->toolTip() + QString(" (%1)").arg(export_tb->shortcut().toString()));
 	load_tb->setToolTip(load_tb->toolTip() + QString(" (%1)").arg(load_tb->shortcut().toString()));
 	save_tb->setToolTip(save_tb->toolTip() + QString(" (%1)").arg(save_tb->shortcut().toString()));
@@ -68,13 +83,14 @@ SQLExecutionWidget::SQLExecutionWidget(QWidget * parent) : QWidget(parent)
 	connect(clear_btn, SIGNAL(clicked(void)), this, SLOT(clearAll(void)));
 	connect(sql_cmd_txt, SIGNAL(textChanged(void)), this, SLOT(enableCommandButtons(void)));
 	connect(run_sql_tb, SIGNAL(clicked(void)), this, SLOT(runSQLCommand(void)));
+	connect(stop_tb, SIGNAL(clicked(void)), this, SLOT(cancelExecution(void)));
 	connect(save_tb, SIGNAL(clicked(void)), this, SLOT(saveCommands(void)));
 	connect(load_tb, SIGNAL(clicked(void)), this, SLOT(loadCommands(void)));
 	connect(find_tb, SIGNAL(toggled(bool)), find_wgt_parent, SLOT(setVisible(bool)));
 	connect(output_tb, SIGNAL(toggled(bool)), this, SLOT(toggleOutputPane(bool)));
 
 	//Signal handling with C++11 lambdas Slots
-	connect(results_tbw, &QTableWidget::itemPressed,
+	connect(results_tbw, &QTableView::pressed,
 			[=](){ SQLExecutionWidget::copySelection(results_tbw); });
 
 	connect(export_tb, &QToolButton::clicked,
@@ -82,6 +98,11 @@ SQLExecutionWidget::SQLExecutionWidget(QWidget * parent) : QWidget(parent)
 
 	connect(&snippets_menu, SIGNAL(triggered(QAction*)), this, SLOT(selectSnippet(QAction *)));
 
+	connect(&sql_exec, &QueryExecutor::s_batchReceived, this, &SQLExecutionWidget::handleResultsBatch);
+	connect(&sql_exec, &QueryExecutor::s_executionFinished, this, &SQLExecutionWidget::finishExecution);
+	connect(&sql_exec, &QueryExecutor::s_executionFailed, this, &SQLExecutionWidget::handleExecutionError);
+	connect(&sql_exec, &QueryExecutor::s_copyProgressed, this, &SQLExecutionWidget::updateExportProgress);
+
 	connect(code_compl_wgt, SIGNAL(s_wordSelected(QString)), this, SLOT(handleSelectedWord(QString)));
 
 	connect(cmd_history_txt, SIGNAL(customContextMenuRequested(QPoint)), this, SLOT(showHistoryContextMenu()));
@@ -113,6 +134,10 @@ bool SQLExecutionWidget::eventFilter(QObject *object, QEvent *event)
 
 void SQLExecutionWidget::setConnection(Connection conn)
 {
+	//The running command uses the current connection so it can't be replaced until the command finishes
+	if(sql_exec.isRunning())
+		throw Exception(ERR_CMD_ALREADY_RUNNING, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
 	sql_cmd_conn=conn;
 	db_name_lbl->setText(QString("<strong>%1</strong>@<em>%2:%3</em>")
 						 .arg(conn.getConnectionParam(Connection::PARAM_DB_NAME))
@@ -165,6 +190,7 @@ void SQLExecutionWidget::resizeEvent(QResizeEvent *event)
 		load_tb->setToolButtonStyle(style);
 		save_tb->setToolButtonStyle(style);
 		run_sql_tb->setToolButtonStyle(style);
+		stop_tb->setToolButtonStyle(style);
 		clear_btn->setToolButtonStyle(style);
 		find_tb->setToolButtonStyle(style);
 		snippets_tb->setToolButtonStyle(style);
@@ -173,94 +199,19 @@ void SQLExecutionWidget::resizeEvent(QResizeEvent *event)
 	}
 }
 
-void SQLExecutionWidget::fillResultsTable(Catalog &catalog, ResultSet &res, QTableWidget *results_tbw, bool store_data)
+void SQLExecutionWidget::fillResultsTable(Catalog &catalog, ResultSet &res, QTableView *results_tbw)
 {
 	if(!results_tbw)
 		throw Exception(ERR_OPR_NOT_ALOC_OBJECT ,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
 	try
 	{
-		int col=0, row=0, col_cnt=res.getColumnCount();
-		QTableWidgetItem *item=nullptr;
-		vector<unsigned> type_ids;
-		vector<unsigned>::iterator end;
-		vector<attribs_map> types;
-		map<unsigned, QString> type_names;
-		unsigned orig_filter=catalog.getFilter();
+		ResultSetModel *model=new ResultSetModel(res, catalog, results_tbw);
 
-		results_tbw->setRowCount(0);
-		results_tbw->setColumnCount(col_cnt);
+		clearResultsTable(results_tbw);
+		results_tbw->setModel(model);
 		results_tbw->verticalHeader()->setVisible(true);
-		results_tbw->blockSignals(true);
-
-		//Configuring the grid columns with the names of retrived table columns
-		for(col=0; col < col_cnt; col++)
-		{
-			type_ids.push_back(res.getColumnTypeId(col));
-			item=new QTableWidgetItem(res.getColumnName(col));
-			item->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-			results_tbw->setHorizontalHeaderItem(col, item);
-		}
-
-		//Retrieving the data type names for each column
-		catalog.setFilter(Catalog::LIST_ALL_OBJS);
-		std::sort(type_ids.begin(), type_ids.end());
-		end=std::unique(type_ids.begin(), type_ids.end());
-		type_ids.erase(end, type_ids.end());
-
-		types=catalog.getObjectsAttributes(OBJ_TYPE, QString(), QString(), type_ids);
-
-		for(auto &tp : types)
-			type_names[tp[ParsersAttributes::OID].toUInt()]=tp[ParsersAttributes::NAME];
-
-		catalog.setFilter(orig_filter);
-
-		//Assinging the type names as tooltip on header items
-		for(col=0; col < col_cnt; col++)
-		{
-			item=results_tbw->horizontalHeaderItem(col);
-			item->setToolTip(res.getColumnName(col) + QString(" [%1]").arg(type_names[res.getColumnTypeId(col)]));
-			item->setData(Qt::UserRole, type_names[res.getColumnTypeId(col)]);
-		}
-
-		if(res.accessTuple(ResultSet::FIRST_TUPLE))
-		{
-			results_tbw->setRowCount(res.getTupleCount());
-
-			do
-			{
-				//Fills the current row with the values of current tuple
-				for(col=0; col < col_cnt; col++)
-				{
-					item=new QTableWidgetItem;
-
-					if(res.isColumnBinaryFormat(col))
-					{
-						//Binary columns can't be edited by user
-						item->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
-						item->setText(trUtf8("[binary data]"));
-					}
-					else
-					{
-						item->setText(res.getColumnValue(col));
-
-						if(store_data)
-							item->setData(Qt::UserRole, item->text());
-					}
-
-					results_tbw->setItem(row, col, item);
-				}
-
-				//Configure the vertical header to show the current tuple id
-				results_tbw->setVerticalHeaderItem(row, new QTableWidgetItem(QString::number(row + 1)));
-				row++;
-			}
-			while(res.accessTuple(ResultSet::NEXT_TUPLE));
-		}
-
-		results_tbw->blockSignals(false);
 		results_tbw->resizeColumnsToContents();
-		results_tbw->resizeRowsToContents();
 	}
 	catch(Exception &e)
 	{
@@ -268,6 +219,26 @@ void SQLExecutionWidget::fillResultsTable(Catalog &catalog, ResultSet &res, QTab
 	}
 }
 
+void SQLExecutionWidget::clearResultsTable(QTableView *results_tbw)
+{
+	if(!results_tbw)
+		throw Exception(ERR_OPR_NOT_ALOC_OBJECT ,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	ResultSetModel *model=qobject_cast<ResultSetModel *>(results_tbw->model());
+	QItemSelectionModel *sel_model=results_tbw->selectionModel();
+
+	if(!model)
+		return;
+
+	results_tbw->setModel(nullptr);
+
+	//The selection model created by the view for the previous model must be destroyed by the view's user
+	if(sel_model)
+		sel_model->deleteLater();
+
+	model->deleteLater();
+}
+
 void SQLExecutionWidget::showError(Exception &e)
 {
 	QString time_str=QString("[%1]:").arg(QTime::currentTime().toString(QString("hh:mm:ss.zzz")));
@@ -316,82 +287,279 @@ void SQLExecutionWidget::registerSQLCommand(const QString &cmd, unsigned rows, c
 	}
 }
 
-void SQLExecutionWidget::runSQLCommand(void)
+QString SQLExecutionWidget::getSQLCommand(void)
 {
 	QString cmd=sql_cmd_txt->textCursor().selectedText();
 
-	try
+	if(cmd.isEmpty())
+		cmd=sql_cmd_txt->toPlainText();
+	else
+		cmd.replace(QChar::ParagraphSeparator, '\n');
+
+	return(cmd);
+}
+
+void SQLExecutionWidget::connectToServer(void)
+{
+	if(!sql_cmd_conn.isStablished())
 	{
-		ResultSet res;
-		QStringList conn_notices;
+		sql_cmd_conn.setNoticeEnabled(true);
+		sql_cmd_conn.connect();
+
+		//The connection will break the execution if it keeps idle for one hour or more
+		sql_cmd_conn.setSQLExecutionTimout(3600);
+	}
+}
+
+void SQLExecutionWidget::runSQLCommand(void)
+{
+	running_cmd=getSQLCommand();
 
+	try
+	{
+		//COPY TO STDOUT commands typed by the user have no file to receive the data (an error is raised)
+		sql_exec.setCopyDevice(nullptr);
 		output_tb->setChecked(true);
+		msgoutput_lst->clear();
+		connectToServer();
 
-		if(cmd.isEmpty())
-			cmd=sql_cmd_txt->toPlainText();
-		else
-			cmd.replace(QChar::ParagraphSeparator, '\n');
+		retrieved_rows=0;
+		has_results=false;
+		enableExecutionControls(true);
 
+		/* The command runs asynchronously and the rows are added to the grid as they are received from the
+		server (see handleResultsBatch()) so the first ones can be seen while the others are retrieved */
+		sql_exec.execute(sql_cmd_conn, running_cmd, Connection::DEFAULT_BATCH_SIZE, results_limit);
+	}
+	catch(Exception &e)
+	{
+		handleExecutionError(e);
+	}
+}
+
+void SQLExecutionWidget::exportQueryToFile(void)
+{
+	QAction *act=qobject_cast<QAction *>(sender());
+	bool binary_fmt=(act && act->data().toBool());
+	QString filename=selectExportFile(binary_fmt), query;
+
+	if(filename.isEmpty())
+		return;
+
+	running_cmd=getSQLCommand();
+
+	try
+	{
+		export_file.setFileName(filename);
+
+		if(!export_file.open(QFile::WriteOnly))
+			throw Exception(Exception::getErrorMessage(ERR_FILE_DIR_NOT_ACCESSED).arg(filename),
+											ERR_FILE_DIR_NOT_ACCESSED ,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+		output_tb->setChecked(true);
 		msgoutput_lst->clear();
+		connectToServer();
 
-		if(!sql_cmd_conn.isStablished())
-		{
-			sql_cmd_conn.setNoticeEnabled(true);
-			sql_cmd_conn.connect();
+		//The query can't end with a semicolon since it is used as subquery in the COPY command
+		query=running_cmd.trimmed();
+		while(query.endsWith(QChar(';')))
+			query=query.left(query.length() - 1).trimmed();
 
-			//The connection will break the execution if it keeps idle for one hour or more
-			sql_cmd_conn.setSQLExecutionTimout(3600);
-		}
+		/* The data is written by the server in the output format and stored in the file as soon as it is received
+		(see QueryExecutor::setCopyDevice()), this way, no row is kept in memory or in the results grid. The CSV options
+		are the same used by exportResults() */
+		running_cmd=QString("COPY (%1) TO STDOUT WITH (%2)").arg(query)
+								.arg(binary_fmt ? QString("FORMAT binary") : QString("FORMAT csv, HEADER, DELIMITER ';', FORCE_QUOTE *"));
+
+		PgModelerUiNS::createOutputListItem(msgoutput_lst,
+																				trUtf8("[%1]: Exporting the results to `%2'...")
+																				.arg(QTime::currentTime().toString(QString("hh:mm:ss.zzz"))).arg(filename),
+																				QPixmap(QString(":/icones/icones/msgbox_info.png")), false);
+		output_tbw->setCurrentIndex(1);
+
+		retrieved_rows=0;
+		has_results=false;
+		enableExecutionControls(true);
+
+		sql_exec.setCopyDevice(&export_file);
+		sql_exec.execute(sql_cmd_conn, running_cmd);
+	}
+	catch(Exception &e)
+	{
+		handleExecutionError(e);
+	}
+}
+
+void SQLExecutionWidget::updateExportProgress(qint64 bytes)
+{
+	QListWidgetItem *item=msgoutput_lst->item(msgoutput_lst->count() - 1);
 
-		QApplication::setOverrideCursor(Qt::WaitCursor);
-		sql_cmd_conn.executeDMLCommand(cmd, res);
-		conn_notices=sql_cmd_conn.getNotices();
+	if(item)
+	{
+		item->setText(trUtf8("[%1]: Exporting the results to `%2'... %3 KB written")
+									.arg(QTime::currentTime().toString(QString("hh:mm:ss.zzz")))
+									.arg(export_file.fileName()).arg(bytes/1024));
+	}
+}
 
-		registerSQLCommand(cmd, res.getTupleCount());
+void SQLExecutionWidget::handleResultsBatch(ResultSet &res, bool first_batch)
+{
+	int tuple_count=0;
 
-		output_tbw->setTabEnabled(0, !res.isEmpty());
-		results_parent->setVisible(!res.isEmpty());
-		export_tb->setEnabled(!res.isEmpty());
+	//When exporting the query to a file the grid is left untouched
+	if(export_file.isOpen())
+		return;
 
-		if(!res.isEmpty())
+	//The tuple count is retrieved beforehand since the model takes the batch's result leaving the result set empty
+	tuple_count=(res.isEmpty() ? 0 : res.getTupleCount());
+
+	//Only the result of the last statement in the command is kept in the grid
+	if(first_batch)
+	{
+		retrieved_rows=0;
+		has_results=!res.isEmpty();
+		output_tbw->setTabEnabled(0, has_results);
+		results_parent->setVisible(has_results);
+
+		if(has_results)
 		{
 			fillResultsTable(res);
-			output_tbw->setTabText(0, trUtf8("Results (%1)").arg(res.getTupleCount()));
 			output_tbw->setCurrentIndex(0);
 		}
 		else
-		{
-			output_tbw->setTabText(0, trUtf8("Results"));
-			output_tbw->setCurrentIndex(1);
-		}
+			SQLExecutionWidget::clearResultsTable(results_tbw);
+	}
+	else
+		qobject_cast<ResultSetModel *>(results_tbw->model())->appendResultSet(res);
 
-		msgoutput_lst->clear();
+	retrieved_rows+=tuple_count;
 
-		for(QString notice : conn_notices)
+	if(has_results)
+	{
+		export_tb->setEnabled(retrieved_rows > 0);
+		output_tbw->setTabText(0, trUtf8("Results (%1)").arg(retrieved_rows));
+	}
+}
+
+void SQLExecutionWidget::finishExecution(unsigned, bool completed)
+{
+	QStringList conn_notices=sql_cmd_conn.getNotices();
+	QString time_str=QTime::currentTime().toString(QString("hh:mm:ss.zzz"));
+	bool export_cancelled=(export_file.isOpen() && !completed);
+
+	registerSQLCommand(running_cmd, retrieved_rows);
+	msgoutput_lst->clear();
+
+	for(QString notice : conn_notices)
+	{
+		PgModelerUiNS::createOutputListItem(msgoutput_lst,
+																				PgModelerUiNS::formatMessage(QString("[%1]: %2").arg(time_str).arg(notice)),
+																				QPixmap(QString(":/icones/icones/msgbox_alerta.png")));
+	}
+
+	if(export_file.isOpen())
+	{
+		//A cancelled export leaves an incomplete file which is removed so it's not mistaken by the complete results
+		if(!completed)
 		{
 			PgModelerUiNS::createOutputListItem(msgoutput_lst,
-																					PgModelerUiNS::formatMessage(QString("[%1]: %2").arg(QTime::currentTime().toString(QString("hh:mm:ss.zzz"))).arg(notice)),
+																					PgModelerUiNS::formatMessage(trUtf8("[%1]: The export was cancelled by the user. The incomplete file <strong>%2</strong> was removed.")
+																																			 .arg(time_str).arg(export_file.fileName())),
 																					QPixmap(QString(":/icones/icones/msgbox_alerta.png")));
+			export_file.close();
+			export_file.remove();
+		}
+		else
+		{
+			PgModelerUiNS::createOutputListItem(msgoutput_lst,
+																					PgModelerUiNS::formatMessage(trUtf8("[%1]: SQL command successfully executed. <em>Results saved to <strong>%2</strong> (%3 KB)</em>")
+																																			 .arg(time_str).arg(export_file.fileName()).arg(export_file.size()/1024)),
+																					QPixmap(QString(":/icones/icones/msgbox_info.png")));
+			export_file.close();
+		}
+
+		output_tbw->setCurrentIndex(1);
+	}
+	else
+	{
+		export_tb->setEnabled(has_results && retrieved_rows > 0);
+
+		if(!has_results)
+		{
+			output_tbw->setTabText(0, trUtf8("Results"));
+			output_tbw->setCurrentIndex(1);
 		}
 
 		PgModelerUiNS::createOutputListItem(msgoutput_lst,
 																				PgModelerUiNS::formatMessage(trUtf8("[%1]: SQL command successfully executed. <em>%2 <strong>%3</strong></em>")
-																																		 .arg(QTime::currentTime().toString(QString("hh:mm:ss.zzz")))
-																																		 .arg(res.isEmpty() ? trUtf8("Rows affected") :  trUtf8("Rows retrieved"))
-																																		 .arg(res.getTupleCount())),
+																																		 .arg(time_str)
+																																		 .arg(!has_results ? trUtf8("Rows affected") :  trUtf8("Rows retrieved"))
+																																		 .arg(retrieved_rows)),
 																				QPixmap(QString(":/icones/icones/msgbox_info.png")));
+	}
 
-		output_tbw->setTabText(1, trUtf8("Messages (%1)").arg(msgoutput_lst->count()));
+	//The cancelling of exports is already reported above
+	if(!completed && !export_cancelled)
+	{
+		QString msg;
 
-		QApplication::restoreOverrideCursor();
+		if(cancel_requested)
+			msg=trUtf8("[%1]: The execution was cancelled by the user. The rows already retrieved were kept.").arg(time_str);
+		else
+			msg=trUtf8("[%1]: The results grid was limited to <strong>%2</strong> rows. Use <em>Export results to CSV file</em> to retrieve all the rows.")
+					.arg(time_str).arg(results_limit);
+
+		PgModelerUiNS::createOutputListItem(msgoutput_lst, PgModelerUiNS::formatMessage(msg),
+																				QPixmap(QString(":/icones/icones/msgbox_alerta.png")));
 	}
-	catch(Exception &e)
+
+	output_tbw->setTabText(1, trUtf8("Messages (%1)").arg(msgoutput_lst->count()));
+	enableExecutionControls(false);
+}
+
+void SQLExecutionWidget::handleExecutionError(Exception e)
+{
+	registerSQLCommand(running_cmd, 0, e.getErrorMessage());
+
+	//The file of a failed export has only part of the results (if any) so it is removed
+	if(export_file.isOpen())
 	{
-		registerSQLCommand(cmd, 0, e.getErrorMessage());
-		QApplication::restoreOverrideCursor();
-		sql_cmd_conn.close();
-		showError(e);
+		export_file.close();
+		export_file.remove();
 	}
+
+	enableExecutionControls(false);
+	sql_cmd_conn.close();
+	showError(e);
+}
+
+void SQLExecutionWidget::cancelExecution(void)
+{
+	cancel_requested=true;
+	stop_tb->setEnabled(false);
+	sql_exec.cancel();
+}
+
+void SQLExecutionWidget::enableExecutionControls(bool running)
+{
+	cancel_requested=false;
+	run_sql_tb->setEnabled(!running && !sql_cmd_txt->toPlainText().isEmpty());
+	stop_tb->setEnabled(running);
+	clear_btn->setEnabled(!running && run_sql_tb->isEnabled());
+	load_tb->setEnabled(!running);
+	export_tb->setEnabled(!running && export_tb->isEnabled());
+	sql_cmd_txt->setReadOnly(running);
+
+	//The cursor is changed only in this widget since the other ones can be used while the command runs
+	if(running)
+		setCursor(Qt::BusyCursor);
+	else
+		unsetCursor();
+}
+
+bool SQLExecutionWidget::isExecutingCommand(void)
+{
+	return(sql_exec.isRunning());
 }
 
 void SQLExecutionWidget::saveCommands(void)
@@ -437,48 +605,70 @@ void SQLExecutionWidget::loadCommands(void)
 	}
 }
 
-void SQLExecutionWidget::exportResults(QTableWidget *results_tbw)
+QString SQLExecutionWidget::selectExportFile(bool binary_fmt)
 {
-	if(!results_tbw)
-		throw Exception(ERR_OPR_NOT_ALOC_OBJECT ,__PRETTY_FUNCTION__,__FILE__,__LINE__);
-
 	QFileDialog csv_file_dlg;
 
-	csv_file_dlg.setDefaultSuffix(QString("csv"));
 	csv_file_dlg.setFileMode(QFileDialog::AnyFile);
-	csv_file_dlg.setWindowTitle(trUtf8("Save CSV file"));
-	csv_file_dlg.setNameFilter(trUtf8("Comma-separated values file (*.csv);;All files (*.*)"));
+
+	if(binary_fmt)
+	{
+		csv_file_dlg.setDefaultSuffix(QString("bin"));
+		csv_file_dlg.setWindowTitle(trUtf8("Save binary file"));
+		csv_file_dlg.setNameFilter(trUtf8("PostgreSQL binary COPY file (*.bin);;All files (*.*)"));
+	}
+	else
+	{
+		csv_file_dlg.setDefaultSuffix(QString("csv"));
+		csv_file_dlg.setWindowTitle(trUtf8("Save CSV file"));
+		csv_file_dlg.setNameFilter(trUtf8("Comma-separated values file (*.csv);;All files (*.*)"));
+	}
+
 	csv_file_dlg.setModal(true);
 	csv_file_dlg.setAcceptMode(QFileDialog::AcceptSave);
 
 	csv_file_dlg.exec();
 
 	if(csv_file_dlg.result()==QDialog::Accepted)
+		return(csv_file_dlg.selectedFiles().at(0));
+
+	return(QString());
+}
+
+void SQLExecutionWidget::exportResults(QTableView *results_tbw)
+{
+	if(!results_tbw)
+		throw Exception(ERR_OPR_NOT_ALOC_OBJECT ,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	QString filename=selectExportFile();
+
+	if(!filename.isEmpty())
 	{
 		QFile file;
-		file.setFileName(csv_file_dlg.selectedFiles().at(0));
+		file.setFileName(filename);
 
 		if(!file.open(QFile::WriteOnly))
 			throw Exception(Exception::getErrorMessage(ERR_FILE_DIR_NOT_ACCESSED)
-							.arg(csv_file_dlg.selectedFiles().at(0))
+							.arg(filename)
 							, ERR_FILE_DIR_NOT_ACCESSED ,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
-		file.write(generateCSVBuffer(results_tbw, 0, 0, results_tbw->rowCount(), results_tbw->columnCount()));
+		file.write(generateCSVBuffer(results_tbw, 0, 0, results_tbw->model()->rowCount(), results_tbw->model()->columnCount()));
 		file.close();
 	}
 }
 
-QByteArray SQLExecutionWidget::generateCSVBuffer(QTableWidget *results_tbw, int start_row, int start_col, int row_cnt, int col_cnt)
+QByteArray SQLExecutionWidget::generateCSVBuffer(QTableView *results_tbw, int start_row, int start_col, int row_cnt, int col_cnt)
 {
-	if(!results_tbw)
+	if(!results_tbw || !results_tbw->model())
 		throw Exception(ERR_OPR_NOT_ALOC_OBJECT ,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
 	QByteArray buf;
+	QAbstractItemModel *model=results_tbw->model();
 
 	//If the selection interval is valid
 	if(start_row >=0 && start_col >=0 &&
-			start_row + row_cnt <= results_tbw->rowCount() &&
-			start_col + col_cnt <= results_tbw->columnCount())
+			start_row + row_cnt <= model->rowCount() &&
+			start_col + col_cnt <= model->columnCount())
 	{
 		int col=0, row=0,
 				max_col=start_col + col_cnt,
@@ -487,7 +677,7 @@ QByteArray SQLExecutionWidget::generateCSVBuffer(QTableWidget *results_tbw, int
 		//Creating the header of csv
 		for(col=start_col; col < max_col; col++)
 		{
-			buf.append(QString("\"%1\"").arg(results_tbw->horizontalHeaderItem(col)->text()));
+			buf.append(QString("\"%1\"").arg(model->headerData(col, Qt::Horizontal).toString()));
 			buf.append(';');
 		}
 
@@ -498,7 +688,7 @@ QByteArray SQLExecutionWidget::generateCSVBuffer(QTableWidget *results_tbw, int
 		{
 			for(col=start_col; col < max_col; col++)
 			{
-				buf.append(QString("\"%1\"").arg(results_tbw->item(row, col)->text()));
+				buf.append(QString("\"%1\"").arg(model->index(row, col).data().toString()));
 				buf.append(';');
 			}
 
@@ -509,6 +699,11 @@ QByteArray SQLExecutionWidget::generateCSVBuffer(QTableWidget *results_tbw, int
 	return(buf);
 }
 
+void SQLExecutionWidget::setResultsLimit(unsigned limit)
+{
+	results_limit=limit;
+}
+
 void SQLExecutionWidget::clearAll(void)
 {
 	Messagebox msg_box;
@@ -526,12 +721,15 @@ void SQLExecutionWidget::clearAll(void)
 	}
 }
 
-void SQLExecutionWidget::copySelection(QTableWidget *results_tbw, bool use_popup)
+void SQLExecutionWidget::copySelection(QTableView *results_tbw, bool use_popup)
 {
 	if(!results_tbw)
 		throw Exception(ERR_OPR_NOT_ALOC_OBJECT ,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
-	QList<QTableWidgetSelectionRange> sel_ranges=results_tbw->selectedRanges();
+	if(!results_tbw->selectionModel())
+		return;
+
+	QItemSelection sel_ranges=results_tbw->selectionModel()->selection();
 
 	if(sel_ranges.count()==1 && (!use_popup || (use_popup && QApplication::mouseButtons()==Qt::RightButton)))
 	{
@@ -542,12 +740,12 @@ void SQLExecutionWidget::copySelection(QTableWidget *results_tbw, bool use_popup
 
 		if(!use_popup || (use_popup && copy_menu.exec(QCursor::pos())))
 		{
-			QTableWidgetSelectionRange selection=sel_ranges.at(0);
+			QItemSelectionRange selection=sel_ranges.at(0);
 
 			//Generates the csv buffer and assigns it to application's clipboard
 			QByteArray buf=generateCSVBuffer(results_tbw,
-																			 selection.topRow(), selection.leftColumn(),
-																			 selection.rowCount(), selection.columnCount());
+																			 selection.top(), selection.left(),
+																			 selection.height(), selection.width());
 			qApp->clipboard()->setText(buf);
 		}
 	}
@@ -28,10 +28,12 @@
 #include "ui_sqlexecutionwidget.h"
 #include "syntaxhighlighter.h"
 #include "connection.h"
+#include "queryexecutor.h"
 #include "databaseimportform.h"
 #include "findreplacewidget.h"
 #include "codecompletionwidget.h"
 #include "numberedtexteditor.h"
+#include "resultsetmodel.h"
 
 class SQLExecutionWidget: public QWidget, public Ui::SQLExecutionWidget {
 	private:
@@ -48,10 +50,34 @@ class SQLExecutionWidget: public QWidget, public Ui::SQLExecutionWidget {
 		//! \brief Connection used to run commands specified on sql input field
 		Connection sql_cmd_conn;
 
+		/*! \brief Runs the commands asynchronously on sql_cmd_conn. This object must be declared after the connection
+		since it uses the connection when being destroyed (to cancel a running command) */
+		QueryExecutor sql_exec;
+
+		//! \brief Command being executed
+		QString running_cmd;
+
+		//! \brief Amount of rows retrieved by the running command
+		unsigned retrieved_rows;
+
+		/*! \brief Indicates if the last statement of the running command returned a result with columns
+		and if the user requested the cancelling of the command */
+		bool has_results, cancel_requested;
+
+		//! \brief File in which the results are written when running the command through exportQueryToFile()
+		QFile export_file;
+
 		//! \brief Dialog for SQL save/load
 		QFileDialog sql_file_dlg;
 
-		QMenu snippets_menu;
+		QMenu snippets_menu,
+
+		//! \brief Menu with the alternative ways to run the command (see exportQueryToFile())
+		run_sql_menu;
+
+		/*! \brief Maximum amount of rows kept in the results grid for a command. The rows beyond that
+		limit aren't retrieved from the server. A zero value means no limit */
+		static unsigned results_limit;
 
 		FindReplaceWidget *find_replace_wgt;
 
@@ -70,6 +96,18 @@ class SQLExecutionWidget: public QWidget, public Ui::SQLExecutionWidget {
 		//! \brief Fills the result grid with the specified result set
 		void fillResultsTable(ResultSet &res);
 
+		//! \brief Returns the selected text on sql input field or the entire text if there is no selection
+		QString getSQLCommand(void);
+
+		//! \brief Opens the connection used to run the commands if it is not stablished yet
+		void connectToServer(void);
+
+		//! \brief Toggles the state of the controls depending on the running state of a command
+		void enableExecutionControls(bool running);
+
+		//! \brief Shows a file dialog to select the file (CSV or binary) in which the results are saved
+		static QString selectExportFile(bool binary_fmt=false);
+
 	protected:
 		//! \brief Widget that serves as SQL commands input
 		NumberedTextEditor *sql_cmd_txt;
@@ -81,21 +119,31 @@ class SQLExecutionWidget: public QWidget, public Ui::SQLExecutionWidget {
 	public:
 		SQLExecutionWidget(QWidget * parent = 0);
 
-		//! \brief Configures the connection to query the server
+		/*! \brief Configures the connection to query the server. An error is raised if there is a command running
+		since it depends on the current connection */
 		void setConnection(Connection conn);
 
-		/*! \brief Fills up the results grid based upon the specified result set.
-				The parameter store_data will make each item store the text as its data */
-		static void fillResultsTable(Catalog &catalog, ResultSet &res, QTableWidget *results_tbw, bool store_data=false);
+		/*! \brief Fills up the results grid based upon the specified result set. The grid receives a ResultSetModel
+				that reads the values directly from the result set so no item is allocated per cell */
+		static void fillResultsTable(Catalog &catalog, ResultSet &res, QTableView *results_tbw);
+
+		//! \brief Removes the result set model from the results grid destroying it
+		static void clearResultsTable(QTableView *results_tbw);
 
 		//! \brief Copy to clipboard (in csv format) the current selected items on results grid
-		static void copySelection(QTableWidget *results_tbw, bool use_popup=true);
+		static void copySelection(QTableView *results_tbw, bool use_popup=true);
 
 		//! \brief Generates a CSV buffer based upon the selection on the results grid
-		static QByteArray generateCSVBuffer(QTableWidget *results_tbw, int start_row, int start_col, int row_cnt, int col_cnt);
+		static QByteArray generateCSVBuffer(QTableView *results_tbw, int start_row, int start_col, int row_cnt, int col_cnt);
 
 		//! \brief Exports the results to csv file
-		static void exportResults(QTableWidget *results_tbw);
+		static void exportResults(QTableView *results_tbw);
+
+		//! \brief Defines the maximum amount of rows kept in the results grid (zero means no limit)
+		static void setResultsLimit(unsigned limit);
+
+		//! \brief Returns if there is a command running in the widget's connection
+		bool isExecutingCommand(void);
 
 	public slots:
 		void configureSnippets(void);
@@ -107,6 +155,26 @@ class SQLExecutionWidget: public QWidget, public Ui::SQLExecutionWidget {
 		//! \brief Runs the current typed sql command
 		void runSQLCommand(void);
 
+		/*! \brief Exports the results of the current typed query directly to a file running it through COPY (query) TO STDOUT.
+		The data is written as it is received from the server (in CSV or binary format depending on the action that triggered
+		the method) so the results are never stored in memory nor shown in the results grid */
+		void exportQueryToFile(void);
+
+		//! \brief Shows the amount of data written in the file by exportQueryToFile()
+		void updateExportProgress(qint64 bytes);
+
+		//! \brief Adds the rows received to the results grid
+		void handleResultsBatch(ResultSet &res, bool first_batch);
+
+		//! \brief Shows the execution messages after the command finishes
+		void finishExecution(unsigned, bool completed);
+
+		//! \brief Shows the error raised during the execution
+		void handleExecutionError(Exception e);
+
+		//! \brief Cancels the running command
+		void cancelExecution(void);
+
 		//! \brief Save the current typed sql command on a file
 		void saveCommands(void);
 
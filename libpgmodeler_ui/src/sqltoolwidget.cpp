@@ -270,6 +270,18 @@ void SQLToolWidget::closeSQLExecutionTab(int idx)
 	QMap<QWidget *, QWidgetList> ::iterator itr=sql_exec_wgts.begin();
 	int idx1=-1;
 
+	//Closing the tab cancels the command running on it so the user must confirm the operation
+	if(sql_exec_wgt && sql_exec_wgt->isExecutingCommand())
+	{
+		Messagebox msg_box;
+
+		msg_box.show(trUtf8("There is a SQL command running in this tab! Closing it will cancel the command execution. Do you want to proceed?"),
+								 Messagebox::ALERT_ICON, Messagebox::YES_NO_BUTTONS);
+
+		if(msg_box.result()==QDialog::Rejected)
+			return;
+	}
+
 	//Removing the widget from the list it belongs
 	while(itr!=sql_exec_wgts.end())
 	{
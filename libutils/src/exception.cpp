@@ -247,7 +247,12 @@ QString Exception::messages[ERROR_COUNT][2]={
 	{"ERR_ASG_ENUM_LONG_NAME", QT_TR_NOOP("The enumeration `%1' can't be assigned to the type `%2' because is too long!")},
 	{"ERR_CONNECTION_TIMEOUT", QT_TR_NOOP("The connection was idle for too long and was automatically closed!")},
 	{"ERR_CONNECTION_BROKEN", QT_TR_NOOP("The connection was unexpectedly closed by the database server `%1' at port `%2'!")},
-	{"ERR_DROP_CURRDB_DEFAULT", QT_TR_NOOP("Failed to drop the database `%1' because it is defined as the default database for the connection `%2'!")}
+	{"ERR_DROP_CURRDB_DEFAULT", QT_TR_NOOP("Failed to drop the database `%1' because it is defined as the default database for the connection `%2'!")},
+	{"ERR_CMD_ALREADY_RUNNING", QT_TR_NOOP("A new command can't be executed while the previous one is still running! Wait for its completion or cancel it.")},
+	{"ERR_INV_COPY_FROM_CMD", QT_TR_NOOP("The command used to send data to the server is not a valid `COPY ... FROM STDIN'!")},
+	{"ERR_CSV_LINE_NOT_LOADED", QT_TR_NOOP("Could not load the file `%1' into `%2' due to the data on line `%3'! No row was stored in the table. \n\n ** Returned error ** \n\n%4")},
+	{"ERR_COL_VALUE_NOT_CONVERTED", QT_TR_NOOP("The value of the column `%1' in the tuple `%2' is null or can't be converted to `%3'!")},
+	{"ERR_MAX_SESSIONS_REACHED", QT_TR_NOOP("The maximum amount of sessions opened by pgModeler on the server `%1' was reached! Close some of the connections to the server and try again.")}
 };
 
 Exception::Exception(void)
@@ -33,7 +33,7 @@
 #include <deque>
 
 using namespace std;
-static const int ERROR_COUNT=229;
+static const int ERROR_COUNT=234;
 
 /*
  ErrorType enum format: ERR_[[OPERATION_CODE][ERROR_CODE]] where:
@@ -276,7 +276,12 @@ enum ErrorType {
 	ERR_ASG_ENUM_LONG_NAME,
 	ERR_CONNECTION_TIMEOUT,
 	ERR_CONNECTION_BROKEN,
-	ERR_DROP_CURRDB_DEFAULT
+	ERR_DROP_CURRDB_DEFAULT,
+	ERR_CMD_ALREADY_RUNNING,
+	ERR_INV_COPY_FROM_CMD,
+	ERR_CSV_LINE_NOT_LOADED,
+	ERR_COL_VALUE_NOT_CONVERTED,
+	ERR_MAX_SESSIONS_REACHED
 };
 
 class Exception {
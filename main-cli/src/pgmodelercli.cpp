@@ -48,6 +48,7 @@ const QString PgModelerCLI::FIX_TRIES=QString("--fix-tries");
 const QString PgModelerCLI::ZOOM_FACTOR=QString("--zoom");
 const QString PgModelerCLI::USE_TMP_NAMES=QString("--use-tmp-names");
 const QString PgModelerCLI::DBM_MIME_TYPE=QString("--dbm-mime-type");
+const QString PgModelerCLI::STREAM_INPUT=QString("--stream-input");
 const QString PgModelerCLI::INSTALL=QString("install");
 const QString PgModelerCLI::UNINSTALL=QString("uninstall");
 
@@ -205,6 +206,7 @@ void PgModelerCLI::initializeOptions(void)
 	long_opts[ZOOM_FACTOR]=true;
 	long_opts[USE_TMP_NAMES]=false;
 	long_opts[DBM_MIME_TYPE]=true;
+	long_opts[STREAM_INPUT]=false;
 
 	short_opts[INPUT]=QString("-i");
 	short_opts[OUTPUT]=QString("-o");
@@ -235,6 +237,7 @@ void PgModelerCLI::initializeOptions(void)
 	short_opts[ZOOM_FACTOR]=QString("-z");
 	short_opts[USE_TMP_NAMES]=QString("-n");
 	short_opts[DBM_MIME_TYPE]=QString("-m");
+	short_opts[STREAM_INPUT]=QString("-r");
 }
 
 bool PgModelerCLI::isOptionRecognized(QString &op, bool &accepts_val)
@@ -276,6 +279,7 @@ accepted structure. All available options are described below.") << endl;
 	out << trUtf8("  %1, %2\t\t   Export directly to a PostgreSQL server.").arg(short_opts[EXPORT_TO_DBMS]).arg(EXPORT_TO_DBMS) << endl;
 	out << trUtf8("  %1, %2\t\t   List available connections on %3 file.").arg(short_opts[LIST_CONNS]).arg(LIST_CONNS).arg(GlobalAttributes::CONNECTIONS_CONF + GlobalAttributes::CONFIGURATION_EXT) << endl;
 	out << trUtf8("  %1, %2\t\t   Version of generated SQL code. Only for file or dbms export.").arg(short_opts[PGSQL_VER]).arg(PGSQL_VER) << endl;
+	out << trUtf8("  %1, %2\t\t   Reads the input model as a stream reducing the memory used to load large models.").arg(short_opts[STREAM_INPUT]).arg(STREAM_INPUT) << endl;
 	out << trUtf8("  %1, %2\t\t\t   Silent execution. Only critical errors are shown during process.").arg(short_opts[SILENT]).arg(SILENT) << endl;
 	out << trUtf8("  %1, %2\t\t\t   Show this help menu.").arg(short_opts[HELP]).arg(HELP) << endl;
 	out << endl;
@@ -410,7 +414,9 @@ int PgModelerCLI::exec(void)
 				extractObjectXML();
 				recreateObjects();
 				model->updateTablesFKRelationships();
-				model->saveModel(parsed_opts[OUTPUT], SchemaParser::XML_DEFINITION);
+
+				//The fixed model is saved without a code cache so the command line run leaves no files in the configuration directory
+				model->saveModel(parsed_opts[OUTPUT], SchemaParser::XML_DEFINITION, false);
 
 				if(!silent_mode)
 					out << trUtf8("Model successfully fixed!") << endl << endl;
@@ -430,7 +436,7 @@ int PgModelerCLI::exec(void)
 				model->createSystemObjects(false);
 
 				//Load the model file
-				model->loadModel(parsed_opts[INPUT]);
+				model->loadModel(parsed_opts[INPUT], parsed_opts.count(STREAM_INPUT) > 0);
 
 				//Export to PNG
 				if(parsed_opts.count(EXPORT_TO_PNG))
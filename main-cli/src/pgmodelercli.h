@@ -110,6 +110,7 @@ class PgModelerCLI: public QApplication {
 		ZOOM_FACTOR,
 		USE_TMP_NAMES,
 		DBM_MIME_TYPE,
+		STREAM_INPUT,
 		INSTALL,
 		UNINSTALL,
 
@@ -0,0 +1,122 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2016 - Raphael Araújo e Silva <raphael@pgmodeler.com.br>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include "catalog.h"
+
+class CatalogTest: public QObject {
+	private:
+		Q_OBJECT
+
+		/*! \brief Configures the connection with the server informed in the environment variables PGMODELER_TEST_HOST,
+		PGMODELER_TEST_PORT, PGMODELER_TEST_USER, PGMODELER_TEST_PASSWORD and PGMODELER_TEST_DB. Returns false when
+		no server is informed so the tests that depend on it are skipped */
+		bool configureConnection(Connection &conn);
+
+		//! \brief Retrieves the objects attributes using both the prepared and the literal catalog queries
+		void retrieveObjects(Catalog &catalog, ObjectType obj_type, const QString &schema, const vector<unsigned> &oids,
+												 vector<attribs_map> &prep_objs, vector<attribs_map> &lit_objs);
+
+	private slots:
+		void preparedQueriesMatchLiteralQueries(void);
+};
+
+bool CatalogTest::configureConnection(Connection &conn)
+{
+	QString host=qgetenv("PGMODELER_TEST_HOST");
+
+	if(host.isEmpty())
+		return(false);
+
+	conn.setConnectionParam(Connection::PARAM_SERVER_FQDN, host);
+	conn.setConnectionParam(Connection::PARAM_PORT, qgetenv("PGMODELER_TEST_PORT").isEmpty() ? QString("5432") : QString(qgetenv("PGMODELER_TEST_PORT")));
+	conn.setConnectionParam(Connection::PARAM_USER, qgetenv("PGMODELER_TEST_USER").isEmpty() ? QString("postgres") : QString(qgetenv("PGMODELER_TEST_USER")));
+	conn.setConnectionParam(Connection::PARAM_PASSWORD, qgetenv("PGMODELER_TEST_PASSWORD"));
+	conn.setConnectionParam(Connection::PARAM_DB_NAME, qgetenv("PGMODELER_TEST_DB").isEmpty() ? QString("postgres") : QString(qgetenv("PGMODELER_TEST_DB")));
+	return(true);
+}
+
+void CatalogTest::retrieveObjects(Catalog &catalog, ObjectType obj_type, const QString &schema, const vector<unsigned> &oids,
+																	vector<attribs_map> &prep_objs, vector<attribs_map> &lit_objs)
+{
+	bool cached_queries=Catalog::isCachedQueriesEnabled();
+
+	//The cached queries are executed as prepared statements while the uncached ones have the values written in them
+	Catalog::enableCachedQueries(true);
+	prep_objs=catalog.getObjectsAttributes(obj_type, schema, QString(), oids);
+
+	//Running the query again reuses the statement prepared in the catalog's connection
+	QVERIFY(catalog.getObjectsAttributes(obj_type, schema, QString(), oids)==prep_objs);
+
+	Catalog::enableCachedQueries(false);
+	lit_objs=catalog.getObjectsAttributes(obj_type, schema, QString(), oids);
+	Catalog::enableCachedQueries(cached_queries);
+}
+
+void CatalogTest::preparedQueriesMatchLiteralQueries(void)
+{
+	Connection conn;
+	Catalog catalog;
+	QTextStream out(stdout);
+	vector<attribs_map> prep_objs, lit_objs;
+	vector<unsigned> oids;
+
+	if(!configureConnection(conn))
+		QSKIP("No server configured in PGMODELER_TEST_HOST");
+
+	try
+	{
+		catalog.setConnection(conn);
+
+		//Schema names and oid lists passed as parameters
+		catalog.setFilter(Catalog::LIST_ALL_OBJS);
+		retrieveObjects(catalog, OBJ_SCHEMA, QString(), {}, prep_objs, lit_objs);
+		QCOMPARE(prep_objs.empty(), false);
+		QVERIFY(prep_objs==lit_objs);
+
+		retrieveObjects(catalog, OBJ_TABLE, QString("pg_catalog"), {}, prep_objs, lit_objs);
+		QCOMPARE(prep_objs.empty(), false);
+		QVERIFY(prep_objs==lit_objs);
+
+		for(unsigned i=0; i < prep_objs.size() && i < 5; i++)
+			oids.push_back(prep_objs[i][ParsersAttributes::OID].toUInt());
+
+		retrieveObjects(catalog, OBJ_TABLE, QString("pg_catalog"), oids, prep_objs, lit_objs);
+		QCOMPARE(prep_objs.size(), oids.size());
+		QVERIFY(prep_objs==lit_objs);
+
+		//Extension objects' oids passed as parameter
+		catalog.setFilter(Catalog::EXCL_EXTENSION_OBJS);
+		retrieveObjects(catalog, OBJ_FUNCTION, QString("pg_catalog"), {}, prep_objs, lit_objs);
+		QVERIFY(prep_objs==lit_objs);
+
+		retrieveObjects(catalog, OBJ_TYPE, QString(), {}, prep_objs, lit_objs);
+		QVERIFY(prep_objs==lit_objs);
+
+		catalog.closeConnection();
+	}
+	catch(Exception &e)
+	{
+		Catalog::enableCachedQueries(false);
+		out << e.getExceptionsText() << endl;
+		QCOMPARE(false, true);
+	}
+}
+
+QTEST_MAIN(CatalogTest)
+#include "catalogtest.moc"
@@ -0,0 +1,222 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2016 - Raphael Araújo e Silva <raphael@pgmodeler.com.br>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include "connection.h"
+
+class ConnectionPoolTest: public QObject {
+	private:
+		Q_OBJECT
+
+		/*! \brief Configures the connection with the server informed in the environment variables PGMODELER_TEST_HOST,
+		PGMODELER_TEST_PORT, PGMODELER_TEST_USER, PGMODELER_TEST_PASSWORD and PGMODELER_TEST_DB. Returns false when
+		no server is informed so the tests that depend on it are skipped */
+		bool configureConnection(Connection &conn);
+
+		//! \brief Returns the value of the specified pool metric
+		unsigned getMetric(const QString &metric);
+
+	private slots:
+		void init(void);
+		void cleanup(void);
+		void idleSessionsAreReused(void);
+		void expiredSessionsAreDiscarded(void);
+		void usedSessionsAreLimited(void);
+		void idleSessionsOfDroppedDatabaseAreClosed(void);
+};
+
+bool ConnectionPoolTest::configureConnection(Connection &conn)
+{
+	QString host=qgetenv("PGMODELER_TEST_HOST");
+
+	if(host.isEmpty())
+		return(false);
+
+	conn.setConnectionParam(Connection::PARAM_SERVER_FQDN, host);
+	conn.setConnectionParam(Connection::PARAM_PORT, qgetenv("PGMODELER_TEST_PORT").isEmpty() ? QString("5432") : QString(qgetenv("PGMODELER_TEST_PORT")));
+	conn.setConnectionParam(Connection::PARAM_USER, qgetenv("PGMODELER_TEST_USER").isEmpty() ? QString("postgres") : QString(qgetenv("PGMODELER_TEST_USER")));
+	conn.setConnectionParam(Connection::PARAM_PASSWORD, qgetenv("PGMODELER_TEST_PASSWORD"));
+	conn.setConnectionParam(Connection::PARAM_DB_NAME, qgetenv("PGMODELER_TEST_DB").isEmpty() ? QString("postgres") : QString(qgetenv("PGMODELER_TEST_DB")));
+	return(true);
+}
+
+unsigned ConnectionPoolTest::getMetric(const QString &metric)
+{
+	return(ConnectionPool::getMetrics()[metric].toUInt());
+}
+
+void ConnectionPoolTest::init(void)
+{
+	//Each test starts with an empty pool
+	ConnectionPool::setEnabled(true);
+	ConnectionPool::clear();
+}
+
+void ConnectionPoolTest::cleanup(void)
+{
+	ConnectionPool::setMaxIdleSessions(ConnectionPool::DEFAULT_MAX_IDLE_SESSIONS);
+	ConnectionPool::setMaxIdleTime(ConnectionPool::DEFAULT_MAX_IDLE_TIME);
+	ConnectionPool::setMaxUsedSessions(ConnectionPool::DEFAULT_MAX_USED_SESSIONS);
+	ConnectionPool::clear();
+}
+
+void ConnectionPoolTest::idleSessionsAreReused(void)
+{
+	Connection conn;
+	ResultSet res;
+	QTextStream out(stdout);
+	unsigned created=0, reused=0;
+
+	if(!configureConnection(conn))
+		QSKIP("No server configured in PGMODELER_TEST_HOST");
+
+	try
+	{
+		created=getMetric(ConnectionPool::METRIC_CREATED);
+		reused=getMetric(ConnectionPool::METRIC_REUSED);
+
+		conn.connect();
+		conn.executeDDLCommand(QString("SET application_name TO 'pgmodeler_pool_test'"));
+		conn.close();
+		QCOMPARE(getMetric(ConnectionPool::METRIC_IDLE), 1u);
+
+		//The second connection must use the idle session with its state reset
+		conn.connect();
+		QCOMPARE(getMetric(ConnectionPool::METRIC_CREATED), created + 1);
+		QCOMPARE(getMetric(ConnectionPool::METRIC_REUSED), reused + 1);
+		QCOMPARE(getMetric(ConnectionPool::METRIC_IDLE), 0u);
+		QCOMPARE(getMetric(ConnectionPool::METRIC_IN_USE), 1u);
+
+		conn.executeDMLCommand(QString("SELECT current_setting('application_name') AS app"), res);
+		res.accessTuple(ResultSet::FIRST_TUPLE);
+		QVERIFY(QString(res.getColumnValue(QString("app")))!=QString("pgmodeler_pool_test"));
+		conn.close();
+	}
+	catch(Exception &e)
+	{
+		out << e.getExceptionsText() << endl;
+		QCOMPARE(false, true);
+	}
+}
+
+void ConnectionPoolTest::expiredSessionsAreDiscarded(void)
+{
+	Connection conn;
+	QTextStream out(stdout);
+	unsigned created=0, reused=0;
+
+	if(!configureConnection(conn))
+		QSKIP("No server configured in PGMODELER_TEST_HOST");
+
+	try
+	{
+		ConnectionPool::setMaxIdleTime(0);
+		created=getMetric(ConnectionPool::METRIC_CREATED);
+		reused=getMetric(ConnectionPool::METRIC_REUSED);
+
+		conn.connect();
+		conn.close();
+		QTest::qWait(50);
+
+		//The idle session expired so a new one must be opened
+		conn.connect();
+		QCOMPARE(getMetric(ConnectionPool::METRIC_CREATED), created + 2);
+		QCOMPARE(getMetric(ConnectionPool::METRIC_REUSED), reused);
+		conn.close();
+	}
+	catch(Exception &e)
+	{
+		out << e.getExceptionsText() << endl;
+		QCOMPARE(false, true);
+	}
+}
+
+void ConnectionPoolTest::usedSessionsAreLimited(void)
+{
+	Connection conn, conn1;
+	QTextStream out(stdout);
+
+	if(!configureConnection(conn) || !configureConnection(conn1))
+		QSKIP("No server configured in PGMODELER_TEST_HOST");
+
+	try
+	{
+		ConnectionPool::setMaxUsedSessions(1);
+		conn.connect();
+
+		try
+		{
+			conn1.connect();
+			QFAIL("The maximum amount of sessions in use was not respected");
+		}
+		catch(Exception &e)
+		{
+			QCOMPARE(e.getErrorType(), ERR_MAX_SESSIONS_REACHED);
+		}
+
+		QCOMPARE(conn1.isStablished(), false);
+		QCOMPARE(getMetric(ConnectionPool::METRIC_IN_USE), 1u);
+
+		//Once the first session is released the second connection can be opened
+		conn.close();
+		conn1.connect();
+		QCOMPARE(conn1.isStablished(), true);
+		conn1.close();
+		QCOMPARE(getMetric(ConnectionPool::METRIC_IN_USE), 0u);
+	}
+	catch(Exception &e)
+	{
+		out << e.getExceptionsText() << endl;
+		QCOMPARE(false, true);
+	}
+}
+
+void ConnectionPoolTest::idleSessionsOfDroppedDatabaseAreClosed(void)
+{
+	Connection conn, conn1;
+	QTextStream out(stdout);
+	QString db_name;
+
+	if(!configureConnection(conn) || !configureConnection(conn1))
+		QSKIP("No server configured in PGMODELER_TEST_HOST");
+
+	try
+	{
+		db_name=conn.getConnectionParam(Connection::PARAM_DB_NAME);
+		conn.connect();
+		conn.close();
+		QCOMPARE(getMetric(ConnectionPool::METRIC_IDLE), 1u);
+
+		//Dropping another database must keep the idle session of the current one
+		conn1.connect();
+		conn1.executeDDLCommand(QString("DROP DATABASE IF EXISTS \"pgmodeler_pool_test\"\"db\""));
+		conn1.close();
+		QCOMPARE(getMetric(ConnectionPool::METRIC_IDLE), 1u);
+
+		ConnectionPool::clearIdleSessions(db_name);
+		QCOMPARE(getMetric(ConnectionPool::METRIC_IDLE), 0u);
+	}
+	catch(Exception &e)
+	{
+		out << e.getExceptionsText() << endl;
+		QCOMPARE(false, true);
+	}
+}
+
+QTEST_MAIN(ConnectionPoolTest)
+#include "connectionpooltest.moc"
@@ -26,6 +26,14 @@ class DatabaseModelTest: public QObject {
 	private slots:
 		void saveObjectsMetadata(void);
 		void loadObjectsMetadata(void);
+		void referenceGraphMatchesModelScan(void);
+		void streamLoadMatchesDocumentLoad(void);
+		void parallelCodeMatchesSerialCode(void);
+		void serialCodeMatchesUncachedCode(void);
+		void codeCacheRestoredOnLoad(void);
+		void statementsMatchCodeDefinition(void);
+		void lookupsFollowRenamedObjects(void);
+		void incrementalValidationMatchesFullValidation(void);
 };
 
 void DatabaseModelTest::saveObjectsMetadata(void)
@@ -74,5 +82,325 @@ void DatabaseModelTest::loadObjectsMetadata(void)
 	}
 }
 
+void DatabaseModelTest::referenceGraphMatchesModelScan(void)
+{
+	DatabaseModel dbmodel;
+	QTextStream out(stdout);
+	QString input=SAMPLESDIR + GlobalAttributes::DIR_SEPARATOR + QString("pagila.dbm");
+	vector<BaseObject *> refs;
+	Sequence *seq=nullptr;
+	Column *col=nullptr;
+
+	try
+	{
+		dbmodel.createSystemObjects(false);
+		dbmodel.loadModel(input);
+		QCOMPARE(dbmodel.isReferenceGraphConsistent(), true);
+
+		//Changing a reference after the graph is built must be reflected on the next search
+		seq=dbmodel.getSequence(0);
+		col=seq->getOwnerColumn();
+		seq->setOwnerColumn(nullptr);
+		QCOMPARE(dbmodel.isReferenceGraphConsistent(), true);
+
+		if(col)
+		{
+			dbmodel.getObjectReferences(col, refs);
+			QCOMPARE(std::find(refs.begin(), refs.end(), seq)==refs.end(), true);
+
+			seq->setOwnerColumn(col);
+			dbmodel.getObjectReferences(col, refs);
+			QCOMPARE(std::find(refs.begin(), refs.end(), seq)!=refs.end(), true);
+		}
+	}
+	catch (Exception &e)
+	{
+		out << e.getExceptionsText() << endl;
+		QCOMPARE(false, true);
+	}
+}
+
+void DatabaseModelTest::streamLoadMatchesDocumentLoad(void)
+{
+	DatabaseModel doc_model, stream_model;
+	QTextStream out(stdout);
+	QString input=SAMPLESDIR + GlobalAttributes::DIR_SEPARATOR + QString("pagila.dbm");
+
+	try
+	{
+		doc_model.createSystemObjects(false);
+		doc_model.loadModel(input);
+
+		stream_model.createSystemObjects(false);
+		stream_model.loadModel(input, true);
+
+		QCOMPARE(stream_model.getObjectCount(), doc_model.getObjectCount());
+		QCOMPARE(stream_model.getCodeDefinition(SchemaParser::SQL_DEFINITION),
+						 doc_model.getCodeDefinition(SchemaParser::SQL_DEFINITION));
+	}
+	catch (Exception &e)
+	{
+		out << e.getExceptionsText() << endl;
+		QCOMPARE(false, true);
+	}
+}
+
+void DatabaseModelTest::parallelCodeMatchesSerialCode(void)
+{
+	DatabaseModel par_model, ser_model;
+	QTextStream out(stdout);
+	QString input=SAMPLESDIR + GlobalAttributes::DIR_SEPARATOR + QString("pagila.dbm"),
+			par_sql, par_xml, ser_sql, ser_xml;
+
+	try
+	{
+		par_model.createSystemObjects(false);
+		par_model.loadModel(input);
+		ser_model.createSystemObjects(false);
+		ser_model.loadModel(input);
+
+		DatabaseModel::enableParallelCodeGeneration(true);
+		par_sql=par_model.getCodeDefinition(SchemaParser::SQL_DEFINITION);
+		par_xml=par_model.getCodeDefinition(SchemaParser::XML_DEFINITION);
+
+		DatabaseModel::enableParallelCodeGeneration(false);
+		ser_sql=ser_model.getCodeDefinition(SchemaParser::SQL_DEFINITION);
+		ser_xml=ser_model.getCodeDefinition(SchemaParser::XML_DEFINITION);
+		DatabaseModel::enableParallelCodeGeneration(true);
+
+		QCOMPARE(par_sql, ser_sql);
+		QCOMPARE(par_xml, ser_xml);
+	}
+	catch (Exception &e)
+	{
+		out << e.getExceptionsText() << endl;
+		QCOMPARE(false, true);
+	}
+}
+
+void DatabaseModelTest::serialCodeMatchesUncachedCode(void)
+{
+	DatabaseModel model;
+	QTextStream out(stdout);
+	QString input=SAMPLESDIR + GlobalAttributes::DIR_SEPARATOR + QString("pagila.dbm"),
+			ref_sql, ref_xml, sql, xml;
+
+	try
+	{
+		model.createSystemObjects(false);
+		model.loadModel(input);
+
+		DatabaseModel::enableParallelCodeGeneration(false);
+		BaseObject::enableCachedCode(false);
+		ref_sql=model.getCodeDefinition(SchemaParser::SQL_DEFINITION);
+		ref_xml=model.getCodeDefinition(SchemaParser::XML_DEFINITION);
+
+		//The second generation of each definition reads the code cached by the first one
+		BaseObject::enableCachedCode(true);
+		for(unsigned i=0; i < 2; i++)
+		{
+			sql=model.getCodeDefinition(SchemaParser::SQL_DEFINITION);
+			xml=model.getCodeDefinition(SchemaParser::XML_DEFINITION);
+			QCOMPARE(sql, ref_sql);
+			QCOMPARE(xml, ref_xml);
+		}
+
+		DatabaseModel::enableParallelCodeGeneration(true);
+	}
+	catch (Exception &e)
+	{
+		out << e.getExceptionsText() << endl;
+		DatabaseModel::enableParallelCodeGeneration(true);
+		BaseObject::enableCachedCode(true);
+		QCOMPARE(false, true);
+	}
+}
+
+void DatabaseModelTest::codeCacheRestoredOnLoad(void)
+{
+	DatabaseModel src_model, cached_model;
+	QTemporaryDir tmp_dir;
+	QTextStream out(stdout);
+	QString input=SAMPLESDIR + GlobalAttributes::DIR_SEPARATOR + QString("pagila.dbm"),
+			output=tmp_dir.path() + GlobalAttributes::DIR_SEPARATOR + QString("pagila_cache.dbm"),
+			output_copy=tmp_dir.path() + GlobalAttributes::DIR_SEPARATOR + QString("pagila_cache_copy.dbm"),
+			cache_dir=tmp_dir.path() + GlobalAttributes::DIR_SEPARATOR + QString("codecache"),
+			xml_code, reduced_code, sql_code, pgsql_ver, src_xml;
+
+	QVERIFY(tmp_dir.isValid());
+	DatabaseModel::setCodeCacheDirectory(cache_dir);
+
+	try
+	{
+		src_model.createSystemObjects(false);
+		src_model.loadModel(input);
+		src_model.saveModel(output, SchemaParser::XML_DEFINITION);
+		src_xml=src_model.getCodeDefinition(SchemaParser::XML_DEFINITION);
+
+		cached_model.createSystemObjects(false);
+		cached_model.loadModel(output);
+
+		//The code of the objects must be available right after the loading
+		cached_model.getTable(0)->getCachedCodes(xml_code, reduced_code, sql_code, pgsql_ver);
+		QCOMPARE(xml_code.isEmpty(), false);
+		QCOMPARE(cached_model.getCodeDefinition(SchemaParser::XML_DEFINITION), src_xml);
+
+		//Temporary saves must not write a cache file
+		src_model.saveModel(output_copy, SchemaParser::XML_DEFINITION, false);
+		QCOMPARE(QDir(cache_dir).entryList(QDir::Files).size(), 1);
+
+		//Saving the model to another file replaces its previous cache file
+		src_model.saveModel(output_copy, SchemaParser::XML_DEFINITION);
+		QCOMPARE(QDir(cache_dir).entryList(QDir::Files).size(), 1);
+
+		//The cache of a removed model file is pruned on the next save
+		cached_model.saveModel(output, SchemaParser::XML_DEFINITION);
+		QCOMPARE(QDir(cache_dir).entryList(QDir::Files).size(), 2);
+		QFile::remove(output_copy);
+		cached_model.saveModel(output, SchemaParser::XML_DEFINITION);
+		QCOMPARE(QDir(cache_dir).entryList(QDir::Files).size(), 1);
+
+		DatabaseModel::setCodeCacheDirectory(QString());
+	}
+	catch (Exception &e)
+	{
+		out << e.getExceptionsText() << endl;
+		DatabaseModel::setCodeCacheDirectory(QString());
+		QCOMPARE(false, true);
+	}
+}
+
+void DatabaseModelTest::statementsMatchCodeDefinition(void)
+{
+	DatabaseModel model;
+	QTextStream out(stdout);
+	QString input=SAMPLESDIR + GlobalAttributes::DIR_SEPARATOR + QString("pagila.dbm"),
+			buf_sql, stmts_sql;
+	vector<DatabaseModel::SQLStatement> stmts;
+
+	try
+	{
+		model.createSystemObjects(false);
+		model.loadModel(input);
+		model.getSQLStatements(stmts);
+
+		//The statements must contain the same commands of the SQL buffer used to export the model (without the comments)
+		for(QString line : model.getCodeDefinition(SchemaParser::SQL_DEFINITION, false).split(QChar('\n')))
+		{
+			if(!line.isEmpty() && !line.startsWith(QString("--")))
+				buf_sql+=line + QString("\n");
+		}
+
+		for(auto &stmt : stmts)
+		{
+			QCOMPARE(stmt.object==nullptr, stmt.obj_type==BASE_OBJECT);
+			stmts_sql+=stmt.sql;
+		}
+
+		QCOMPARE(stmts_sql, buf_sql);
+	}
+	catch (Exception &e)
+	{
+		out << e.getExceptionsText() << endl;
+		QCOMPARE(false, true);
+	}
+}
+
+void DatabaseModelTest::lookupsFollowRenamedObjects(void)
+{
+	DatabaseModel model, other_model;
+	QTextStream out(stdout);
+	QString input=SAMPLESDIR + GlobalAttributes::DIR_SEPARATOR + QString("pagila.dbm"), old_signature;
+	Table *table=nullptr, *other_table=nullptr;
+	Schema *schema=nullptr;
+
+	try
+	{
+		model.createSystemObjects(false);
+		model.loadModel(input);
+		other_model.createSystemObjects(false);
+		other_model.loadModel(input);
+
+		//Building the indexes prior to the renaming
+		table=model.getTable(0);
+		old_signature=table->getSignature();
+		QCOMPARE(model.getObject(old_signature, OBJ_TABLE), dynamic_cast<BaseObject *>(table));
+		other_table=other_model.getTable(old_signature);
+		QCOMPARE(other_table!=nullptr, true);
+
+		table->setName(QString("renamed_table"));
+		QCOMPARE(model.getObject(table->getSignature(), OBJ_TABLE), dynamic_cast<BaseObject *>(table));
+		QCOMPARE(model.getObject(old_signature, OBJ_TABLE)==nullptr, true);
+
+		//Renaming the schema changes the signature of all its objects
+		schema=dynamic_cast<Schema *>(table->getSchema());
+		schema->setName(QString("renamed_schema"));
+
+		for(auto &object : model.getObjects(OBJ_TABLE, schema))
+			QCOMPARE(model.getObject(object->getSignature(), OBJ_TABLE), object);
+
+		//Renaming a table changes the signatures of the functions that use its type as parameter
+		table->setName(QString("renamed_table_type"));
+
+		for(unsigned i=0; i < model.getObjectCount(OBJ_FUNCTION); i++)
+		{
+			BaseObject *func=model.getObject(i, OBJ_FUNCTION);
+			QCOMPARE(model.getObject(func->getSignature(), OBJ_FUNCTION), func);
+		}
+
+		//The other model is not affected by the changes above
+		QCOMPARE(other_model.getTable(old_signature), other_table);
+	}
+	catch (Exception &e)
+	{
+		out << e.getExceptionsText() << endl;
+		QCOMPARE(false, true);
+	}
+}
+
+void DatabaseModelTest::incrementalValidationMatchesFullValidation(void)
+{
+	DatabaseModel incr_model, full_model;
+	QTextStream out(stdout);
+	QString input=SAMPLESDIR + GlobalAttributes::DIR_SEPARATOR + QString("pagila.dbm");
+	Table *incr_tab=nullptr, *full_tab=nullptr;
+	Column *col=nullptr;
+
+	try
+	{
+		incr_model.createSystemObjects(false);
+		incr_model.loadModel(input);
+		full_model.createSystemObjects(false);
+		full_model.loadModel(input);
+
+		//The table payment is inherited by the partition tables so its new column must be propagated to them
+		incr_tab=incr_model.getTable(QString("public.payment"));
+		full_tab=full_model.getTable(QString("public.payment"));
+		QCOMPARE(incr_tab!=nullptr && full_tab!=nullptr, true);
+
+		for(auto tab : { incr_tab, full_tab })
+		{
+			col=new Column;
+			col->setName(QString("payment_note"));
+			col->setType(PgSQLType(QString("text")));
+			tab->addColumn(col);
+		}
+
+		incr_model.validateRelationships(vector<Table *>{ incr_tab });
+		full_model.validateRelationships();
+
+		QCOMPARE(incr_model.getTable(QString("public.payment_p2007_01"))->getColumn(QString("payment_note"))!=nullptr, true);
+		QCOMPARE(incr_model.getCodeDefinition(SchemaParser::XML_DEFINITION),
+						 full_model.getCodeDefinition(SchemaParser::XML_DEFINITION));
+		QCOMPARE(incr_model.getCodeDefinition(SchemaParser::SQL_DEFINITION),
+						 full_model.getCodeDefinition(SchemaParser::SQL_DEFINITION));
+	}
+	catch (Exception &e)
+	{
+		out << e.getExceptionsText() << endl;
+		QCOMPARE(false, true);
+	}
+}
+
 QTEST_MAIN(DatabaseModelTest)
 #include "databasemodeltest.moc"
@@ -0,0 +1,272 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2016 - Raphael Araújo e Silva <raphael@pgmodeler.com.br>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include <QtEndian>
+#include "resultset.h"
+
+//! \brief Exposes the result set constructor so results built in memory (without a server) can be tested
+class TestResultSet: public ResultSet {
+	public:
+		TestResultSet(PGresult *res) : ResultSet(res){}
+};
+
+class ResultSetTest: public QObject {
+	private:
+		Q_OBJECT
+
+		/*! \brief Creates a result with a single column of the specified type and format (0 = text, 1 = binary)
+		filled with the provided values. Null values are stored as SQL nulls */
+		PGresult *createResult(unsigned type_id, int format, const QList<QByteArray> &values);
+
+		//! \brief Returns the binary representation (network byte order) of a 32 bits integer
+		QByteArray toBinary(qint32 value);
+		QByteArray toBinary(qint64 value);
+
+		//! \brief Returns the binary representation of an one-dimensional int4 array
+		QByteArray toBinaryArray(const QList<qint32> &values);
+
+	private slots:
+		void decodesBinaryValues(void);
+		void rangeChecksInt32Values(void);
+		void parsesTextArrays(void);
+		void decodesBinaryArrays(void);
+		void rejectsMalformedBinaryArrays(void);
+		void swapsResultsWithoutCopying(void);
+};
+
+PGresult *ResultSetTest::createResult(unsigned type_id, int format, const QList<QByteArray> &values)
+{
+	PGresult *res=PQmakeEmptyPGresult(nullptr, PGRES_TUPLES_OK);
+	PGresAttDesc attr;
+	char col_name[]="value";
+
+	memset(&attr, 0, sizeof(PGresAttDesc));
+	attr.name=col_name;
+	attr.format=format;
+	attr.typid=type_id;
+	attr.typlen=-1;
+	attr.atttypmod=-1;
+	PQsetResultAttrs(res, 1, &attr);
+
+	for(int tup=0; tup < values.size(); tup++)
+	{
+		if(values[tup].isNull())
+			PQsetvalue(res, tup, 0, nullptr, -1);
+		else
+			PQsetvalue(res, tup, 0, const_cast<char *>(values[tup].constData()), values[tup].size());
+	}
+
+	return(res);
+}
+
+QByteArray ResultSetTest::toBinary(qint32 value)
+{
+	QByteArray data(sizeof(qint32), 0);
+	qToBigEndian<qint32>(value, reinterpret_cast<uchar *>(data.data()));
+	return(data);
+}
+
+QByteArray ResultSetTest::toBinary(qint64 value)
+{
+	QByteArray data(sizeof(qint64), 0);
+	qToBigEndian<qint64>(value, reinterpret_cast<uchar *>(data.data()));
+	return(data);
+}
+
+QByteArray ResultSetTest::toBinaryArray(const QList<qint32> &values)
+{
+	//Header: dimensions, null flag, element type, dimension size and lower bound
+	QByteArray data=toBinary(static_cast<qint32>(1)) + toBinary(static_cast<qint32>(0)) +
+									toBinary(static_cast<qint32>(INT4OID)) + toBinary(static_cast<qint32>(values.size())) +
+									toBinary(static_cast<qint32>(1));
+
+	for(auto &value : values)
+		data+=toBinary(static_cast<qint32>(sizeof(qint32))) + toBinary(value);
+
+	return(data);
+}
+
+void ResultSetTest::decodesBinaryValues(void)
+{
+	QTextStream out(stdout);
+
+	try
+	{
+		TestResultSet int_res(createResult(INT4OID, 1, { toBinary(static_cast<qint32>(-42)), QByteArray() }));
+		QCOMPARE(int_res.getInt32(0, 0), -42);
+		QCOMPARE(int_res.getColumnValues(0), QStringList({ QString("-42"), QString() }));
+		QCOMPARE(int_res.isColumnValueNull(1, 0), true);
+
+		TestResultSet int8_res(createResult(INT8OID, 1, { toBinary(static_cast<qint64>(1) << 40) }));
+		QCOMPARE(int8_res.getInt64(0, 0), static_cast<qint64>(1) << 40);
+		QCOMPARE(int8_res.getColumnValues(0), QStringList({ QString::number(static_cast<qint64>(1) << 40) }));
+
+		quint64 bits=0;
+		double dbl_val=2.5;
+		QByteArray dbl_data(sizeof(double), 0);
+		memcpy(&bits, &dbl_val, sizeof(double));
+		qToBigEndian<quint64>(bits, reinterpret_cast<uchar *>(dbl_data.data()));
+
+		TestResultSet dbl_res(createResult(FLOAT8OID, 1, { dbl_data }));
+		QCOMPARE(dbl_res.getDouble(0, 0), 2.5);
+		QCOMPARE(dbl_res.getColumnValues(0), QStringList({ QString("2.5") }));
+
+		TestResultSet bool_res(createResult(BOOLOID, 1, { QByteArray(1, 1), QByteArray(1, 0) }));
+		QCOMPARE(bool_res.getBool(0, 0), true);
+		QCOMPARE(bool_res.getBool(1, 0), false);
+		QCOMPARE(bool_res.getColumnValues(0), QStringList({ QString("t"), QString("f") }));
+
+		TestResultSet bytea_res(createResult(BYTEAOID, 1, { QByteArray("\x01\xff", 2) }));
+		QCOMPARE(bytea_res.getBytea(0, 0), QByteArray("\x01\xff", 2));
+		QCOMPARE(bytea_res.getColumnValues(0), QStringList({ QString("\\x01ff") }));
+	}
+	catch(Exception &e)
+	{
+		out << e.getExceptionsText() << endl;
+		QCOMPARE(false, true);
+	}
+}
+
+void ResultSetTest::rangeChecksInt32Values(void)
+{
+	TestResultSet bin_res(createResult(INT8OID, 1, { toBinary(static_cast<qint64>(1) << 40), toBinary(static_cast<qint64>(-7)) })),
+			txt_res(createResult(INT8OID, 0, { QByteArray("-2147483649"), QByteArray("2147483647") }));
+
+	QCOMPARE(bin_res.getInt32(1, 0), -7);
+	QCOMPARE(txt_res.getInt32(1, 0), 2147483647);
+
+	//Values that don't fit in 32 bits must not be truncated
+	try
+	{
+		bin_res.getInt32(0, 0);
+		QFAIL("Out of range int8 value converted to int4");
+	}
+	catch(Exception &e)
+	{
+		QCOMPARE(e.getErrorType(), ERR_COL_VALUE_NOT_CONVERTED);
+	}
+
+	try
+	{
+		txt_res.getInt32(0, 0);
+		QFAIL("Out of range int8 value converted to int4");
+	}
+	catch(Exception &e)
+	{
+		QCOMPARE(e.getErrorType(), ERR_COL_VALUE_NOT_CONVERTED);
+	}
+}
+
+void ResultSetTest::parsesTextArrays(void)
+{
+	QTextStream out(stdout);
+
+	try
+	{
+		TestResultSet res(createResult(0, 0, { QByteArray("{a,\"b c\",NULL,\"NULL\",\"d\\\"e\"}"), QByteArray("{}") }));
+		QStringList elems=res.getArray(0, 0);
+
+		QCOMPARE(elems.size(), 5);
+		QCOMPARE(elems[0], QString("a"));
+		QCOMPARE(elems[1], QString("b c"));
+		QCOMPARE(elems[2].isNull(), true);
+		QCOMPARE(elems[3], QString("NULL"));
+		QCOMPARE(elems[4], QString("d\"e"));
+		QCOMPARE(res.getArray(1, 0).isEmpty(), true);
+	}
+	catch(Exception &e)
+	{
+		out << e.getExceptionsText() << endl;
+		QCOMPARE(false, true);
+	}
+}
+
+void ResultSetTest::decodesBinaryArrays(void)
+{
+	QTextStream out(stdout);
+
+	try
+	{
+		QByteArray empty_arr=toBinary(static_cast<qint32>(0)) + toBinary(static_cast<qint32>(0)) + toBinary(static_cast<qint32>(INT4OID)),
+				null_elem_arr=toBinary(static_cast<qint32>(1)) + toBinary(static_cast<qint32>(1)) + toBinary(static_cast<qint32>(INT4OID)) +
+											toBinary(static_cast<qint32>(1)) + toBinary(static_cast<qint32>(1)) + toBinary(static_cast<qint32>(-1));
+		TestResultSet res(createResult(0, 1, { toBinaryArray({ 1, -2, 3 }), empty_arr, null_elem_arr }));
+
+		QCOMPARE(res.getArray(0, 0), QStringList({ QString("1"), QString("-2"), QString("3") }));
+		QCOMPARE(res.getArray(1, 0).isEmpty(), true);
+		QCOMPARE(res.getArray(2, 0).size(), 1);
+		QCOMPARE(res.getArray(2, 0)[0].isNull(), true);
+	}
+	catch(Exception &e)
+	{
+		out << e.getExceptionsText() << endl;
+		QCOMPARE(false, true);
+	}
+}
+
+void ResultSetTest::rejectsMalformedBinaryArrays(void)
+{
+	QByteArray array=toBinaryArray({ 1, 2 }), long_elem=array;
+
+	//The length of the last element exceeds the value size
+	qToBigEndian<qint32>(1000, reinterpret_cast<uchar *>(long_elem.data()) + array.size() - 8);
+
+	TestResultSet res(createResult(0, 1, { array.left(array.size() - 2), long_elem, array.left(8) }));
+
+	for(int tup=0; tup < 3; tup++)
+	{
+		try
+		{
+			res.getArray(tup, 0);
+			QFAIL("Malformed binary array accepted");
+		}
+		catch(Exception &e)
+		{
+			QCOMPARE(e.getErrorType(), ERR_COL_VALUE_NOT_CONVERTED);
+		}
+	}
+}
+
+void ResultSetTest::swapsResultsWithoutCopying(void)
+{
+	QTextStream out(stdout);
+
+	try
+	{
+		TestResultSet res(createResult(INT4OID, 0, { QByteArray("1"), QByteArray() }));
+		ResultSet moved;
+		char *value=res.getColumnValue(0, 0);
+
+		moved.swap(res);
+
+		//The moved result set points to the same values while the original one is left without a result
+		QCOMPARE(moved.getTupleCount(), 2);
+		QVERIFY(moved.getColumnValue(0, 0)==value);
+		QCOMPARE(moved.isColumnValueNull(1, 0), true);
+		QCOMPARE(res.getTupleCount(), 0);
+	}
+	catch(Exception &e)
+	{
+		out << e.getExceptionsText() << endl;
+		QCOMPARE(false, true);
+	}
+}
+
+QTEST_MAIN(ResultSetTest)
+#include "resultsettest.moc"
@@ -0,0 +1,91 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2016 - Raphael Araújo e Silva <raphael@pgmodeler.com.br>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include "databasemodel.h"
+
+class SchemaParserTest: public QObject {
+	private:
+		Q_OBJECT
+
+		DatabaseModel dbmodel;
+
+		//! \brief Generates the SQL code of the whole model several times
+		void exportModel(bool cached_schemas);
+
+	private slots:
+		void initTestCase(void);
+		void cleanupTestCase(void);
+		void cachedSchemaGeneratesSameCode(void);
+		void exportWithoutCachedSchemas(void);
+		void exportWithCachedSchemas(void);
+};
+
+void SchemaParserTest::initTestCase(void)
+{
+	QString input=SAMPLESDIR + GlobalAttributes::DIR_SEPARATOR + QString("pagila.dbm");
+
+	//Disabling the objects' code cache so the schema files are really processed on each export
+	BaseObject::enableCachedCode(false);
+	dbmodel.createSystemObjects(false);
+	dbmodel.loadModel(input);
+}
+
+void SchemaParserTest::cleanupTestCase(void)
+{
+	BaseObject::enableCachedCode(true);
+	SchemaParser::enableCachedSchemas(true);
+}
+
+void SchemaParserTest::cachedSchemaGeneratesSameCode(void)
+{
+	QString uncached_code, cached_code;
+
+	SchemaParser::enableCachedSchemas(false);
+	uncached_code=dbmodel.getCodeDefinition(SchemaParser::SQL_DEFINITION);
+
+	SchemaParser::enableCachedSchemas(true);
+	SchemaParser::clearCachedSchemas();
+	dbmodel.getCodeDefinition(SchemaParser::SQL_DEFINITION);
+	cached_code=dbmodel.getCodeDefinition(SchemaParser::SQL_DEFINITION);
+
+	QCOMPARE(cached_code, uncached_code);
+}
+
+void SchemaParserTest::exportModel(bool cached_schemas)
+{
+	SchemaParser::enableCachedSchemas(cached_schemas);
+
+	QBENCHMARK
+	{
+		dbmodel.getCodeDefinition(SchemaParser::SQL_DEFINITION);
+	}
+}
+
+void SchemaParserTest::exportWithoutCachedSchemas(void)
+{
+	exportModel(false);
+}
+
+void SchemaParserTest::exportWithCachedSchemas(void)
+{
+	exportModel(true);
+}
+
+QTEST_MAIN(SchemaParserTest)
+#include "schemaparsertest.moc"
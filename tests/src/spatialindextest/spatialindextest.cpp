@@ -0,0 +1,154 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2016 - Raphael Araújo e Silva <raphael@pgmodeler.com.br>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include "spatialindex.h"
+
+class SpatialIndexTest: public QObject {
+	private:
+		Q_OBJECT
+
+		static const int ITEM_COUNT=2000;
+
+		//! \brief Returns the items whose rects intersect (or are contained by) the rect by visiting all of them
+		static QSet<QGraphicsItem *> bruteForce(const QHash<QGraphicsItem *, QRectF> &rects, const QRectF &rect, bool contained);
+
+		//! \brief Returns a random rect inside the area (0,0) - (5000,5000)
+		static QRectF randomRect(int max_size);
+
+	private slots:
+		void updatesRectOnInsertion(void);
+		void handlesRectsWithNoArea(void);
+		void matchesBruteForceQueries(void);
+};
+
+QSet<QGraphicsItem *> SpatialIndexTest::bruteForce(const QHash<QGraphicsItem *, QRectF> &rects, const QRectF &rect, bool contained)
+{
+	QSet<QGraphicsItem *> items;
+	QRectF r;
+
+	for(auto item : rects.keys())
+	{
+		r=rects[item];
+
+		if((!contained && r.left() <= rect.right() && rect.left() <= r.right() &&
+				r.top() <= rect.bottom() && rect.top() <= r.bottom()) ||
+			 (contained && rect.left() <= r.left() && r.right() <= rect.right() &&
+				rect.top() <= r.top() && r.bottom() <= rect.bottom()))
+			items.insert(item);
+	}
+
+	return(items);
+}
+
+QRectF SpatialIndexTest::randomRect(int max_size)
+{
+	return(QRectF(qrand() % 5000, qrand() % 5000, qrand() % max_size, qrand() % max_size));
+}
+
+void SpatialIndexTest::updatesRectOnInsertion(void)
+{
+	SpatialIndex index;
+	QGraphicsRectItem item;
+
+	index.insert(&item, QRectF(0, 0, 10, 10));
+	index.insert(&item, QRectF(100, 100, 10, 10));
+
+	QCOMPARE(index.count(), 1);
+	QCOMPARE(index.getRect(&item), QRectF(100, 100, 10, 10));
+	QVERIFY(index.intersects(QRectF(0, 0, 20, 20)).isEmpty());
+	QCOMPARE(index.intersects(QRectF(90, 90, 15, 15)).size(), 1);
+
+	index.remove(&item);
+	QVERIFY(!index.contains(&item));
+	QVERIFY(!index.boundingRect().isValid());
+}
+
+void SpatialIndexTest::handlesRectsWithNoArea(void)
+{
+	SpatialIndex index;
+	QGraphicsRectItem vert_line, horiz_line;
+
+	//Straight relationship lines have no width or height but must be found as well
+	index.insert(&vert_line, QRectF(50, 0, 0, 100));
+	index.insert(&horiz_line, QRectF(0, 50, 100, 0));
+
+	QCOMPARE(index.intersects(QRectF(40, 10, 20, 20)).size(), 1);
+	QCOMPARE(index.intersects(QRectF(40, 40, 20, 20)).size(), 2);
+	QCOMPARE(index.boundingRect(), QRectF(0, 0, 100, 100));
+}
+
+void SpatialIndexTest::matchesBruteForceQueries(void)
+{
+	SpatialIndex index;
+	QVector<QGraphicsRectItem *> items;
+	QHash<QGraphicsItem *, QRectF> rects;
+	QGraphicsItem *item=nullptr;
+	QRectF rect;
+	QList<QGraphicsItem *> result;
+
+	qsrand(7);
+
+	for(int i=0; i < ITEM_COUNT; i++)
+		items.push_back(new QGraphicsRectItem);
+
+	//Inserting, moving and removing random items and comparing the queries with the brute force ones
+	for(int step=0; step < 20000; step++)
+	{
+		int oper=qrand() % 10;
+		item=items[qrand() % ITEM_COUNT];
+
+		if(oper < 5)
+		{
+			rect=randomRect(200);
+			index.insert(item, rect);
+			rects[item]=rect;
+		}
+		else if(oper < 7)
+		{
+			index.remove(item);
+			rects.remove(item);
+		}
+		else
+		{
+			rect=randomRect(2000);
+			result=index.intersects(rect);
+			QCOMPARE(result.size(), result.toSet().size());
+			QCOMPARE(result.toSet(), bruteForce(rects, rect, false));
+			QCOMPARE(index.contained(rect).toSet(), bruteForce(rects, rect, true));
+		}
+
+		QCOMPARE(index.count(), rects.size());
+	}
+
+	//QRectF::united() ignores the rects with no area so the bounding rect is calculated by hand
+	rect=rects.values().front();
+	for(auto r : rects.values())
+	{
+		rect.setLeft(qMin(rect.left(), r.left()));
+		rect.setTop(qMin(rect.top(), r.top()));
+		rect.setRight(qMax(rect.right(), r.right()));
+		rect.setBottom(qMax(rect.bottom(), r.bottom()));
+	}
+
+	QCOMPARE(index.boundingRect(), rect);
+	qDeleteAll(items);
+}
+
+QTEST_MAIN(SpatialIndexTest)
+#include "spatialindextest.moc"
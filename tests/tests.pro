@@ -11,4 +11,9 @@ SUBDIRS = src/main \
 					src/baseobjecttest \
 					src/roletest \
 					src/syntaxhighlightertest \
-					src/databasemodeltest
+					src/databasemodeltest \
+					src/schemaparsertest \
+					src/spatialindextest \
+					src/catalogtest \
+					src/connectionpooltest \
+					src/resultsettest